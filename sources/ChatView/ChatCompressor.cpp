@@ -11,6 +11,8 @@
 #include "logger/Logger.hpp"
 #include "session/HistoryProjection.hpp"
 #include "session/HistorySerializer.hpp"
+#include "tools/ChatHistorySearch.hpp"
+#include "tools/HistoryIndexCache.hpp"
 
 #include <QDateTime>
 #include <QFile>
@@ -290,6 +292,10 @@ bool ChatCompressor::createCompressedChatFile(
         LOG_MESSAGE(QString("Failed to flush compressed chat file: %1").arg(destFile.errorString()));
         return false;
     }
+    destFile.close();
+
+    Tools::HistoryIndexCache::instance().chatSaved(destPath, history, root);
+    Tools::ChatHistorySearch::instance().chatSaved(destPath, history);
 
     return true;
 }
@@ -12,26 +12,64 @@
 #include <QFileInfo>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QMutexLocker>
 #include <QRegularExpression>
 #include <QSaveFile>
 #include <QUrl>
 #include <QUuid>
 
+#include <algorithm>
+
 #include <coreplugin/icore.h>
 #include <projectexplorer/project.h>
 #include <projectexplorer/projectmanager.h>
 
 #include "Logger.hpp"
 #include "ProjectSettings.hpp"
+#include "SessionFileRegistry.hpp"
 #include "session/HistorySerializer.hpp"
 #include "session/Session.hpp"
+#include "tools/ChatHistorySearch.hpp"
+#include "tools/HistoryIndexCache.hpp"
 
 namespace QodeAssist::Chat {
 
+namespace {
+
+// Superseded records may grow the journal to twice its compacted size plus this much before it
+// is rewritten.
+constexpr qint64 kJournalSlackBytes = 1024 * 1024;
+
+QJsonObject compressionLinks(const QJsonObject &root)
+{
+    QJsonObject links;
+    for (const char *key : {"compressedFrom", "compressedAt"}) {
+        if (root.contains(key))
+            links[key] = root[key];
+    }
+    return links;
+}
+
+void indexSavedChat(
+    const QString &filePath, const Session::ConversationHistory &history, const QJsonObject &meta)
+{
+    Tools::HistoryIndexCache::instance().chatSaved(filePath, history, meta);
+    Tools::ChatHistorySearch::instance().chatSaved(filePath, history);
+}
+
+} // namespace
+
 ChatFileStore::ChatFileStore(Session::Session *session, QObject *parent)
     : QObject(parent)
     , m_session(session)
-{}
+{
+    m_writer.setMaxThreadCount(1);
+}
+
+ChatFileStore::~ChatFileStore()
+{
+    flush();
+}
 
 QString ChatFileStore::historyDir() const
 {
@@ -118,26 +156,102 @@ void ChatFileStore::setBindingWriter(BindingWriter writer)
     m_bindingWriter = std::move(writer);
 }
 
-SerializationResult ChatFileStore::save(const QString &filePath) const
+SerializationResult ChatFileStore::save(const QString &filePath)
 {
     if (!m_session)
         return {false, QString("Chat session is no longer available")};
 
-    const Acp::AgentBinding binding = m_bindingReader ? m_bindingReader() : Acp::AgentBinding{};
-    return saveToFile(m_session->history(), binding, filePath);
+    flush();
+
+    return writeJournal(filePath, m_session->history(), saveMeta(filePath));
+}
+
+void ChatFileStore::requestSave(const QString &filePath)
+{
+    if (!m_session)
+        return;
+
+    PendingSave save{
+        .filePath = filePath, .history = m_session->history(), .meta = saveMeta(filePath)};
+
+    QMutexLocker locker(&m_pendingMutex);
+    const auto it = std::find_if(
+        m_pendingSaves.begin(), m_pendingSaves.end(), [&filePath](const PendingSave &pending) {
+            return pending.filePath == filePath;
+        });
+    if (it != m_pendingSaves.end())
+        *it = std::move(save);
+    else
+        m_pendingSaves.append(std::move(save));
+
+    if (!m_writerActive) {
+        m_writerActive = true;
+        m_writer.start([this] { writePendingSaves(); });
+    }
+}
+
+void ChatFileStore::flush()
+{
+    m_writer.waitForDone();
 }
 
-SerializationResult ChatFileStore::load(const QString &filePath) const
+void ChatFileStore::releaseFile(SessionFileRegistry *registry, const QString &filePath)
+{
+    flush();
+    if (registry && !filePath.isEmpty())
+        registry->release(filePath);
+}
+
+void ChatFileStore::writePendingSaves()
+{
+    while (true) {
+        PendingSave save;
+        {
+            QMutexLocker locker(&m_pendingMutex);
+            if (m_pendingSaves.isEmpty()) {
+                m_writerActive = false;
+                break;
+            }
+            save = m_pendingSaves.takeFirst();
+        }
+
+        const SerializationResult result = writeJournal(save.filePath, save.history, save.meta);
+        if (!result.success)
+            LOG_MESSAGE(QString("Failed to autosave chat history: %1").arg(result.errorMessage));
+    }
+}
+
+SerializationResult ChatFileStore::load(const QString &filePath)
 {
     if (!m_session)
         return {false, QString("Chat session is no longer available")};
 
+    flush();
+
     Session::ConversationHistory history;
     Acp::AgentBinding binding;
-    const SerializationResult result = loadFromFile(history, binding, filePath);
+    LoadedFile loaded;
+    const SerializationResult result = loadFromFile(history, binding, filePath, &loaded);
     if (!result.success)
         return result;
 
+    m_loadedFilePath = filePath;
+    m_loadedCompression = loaded.compression;
+
+    // A plain JSON file is turned into a journal the next time it is saved.
+    m_journal = {};
+    if (loaded.journalSize >= 0) {
+        QJsonObject meta = m_loadedCompression;
+        if (!binding.isEmpty())
+            meta["agent"] = binding.toJson();
+        m_journal = {
+            .filePath = filePath,
+            .history = history,
+            .meta = meta,
+            .size = loaded.journalSize,
+            .compactedSize = loaded.journalSize};
+    }
+
     m_session->setHistory(history);
     if (m_bindingWriter)
         m_bindingWriter(binding);
@@ -217,6 +331,18 @@ void ChatFileStore::openHistoryFolder() const
     QDesktopServices::openUrl(url);
 }
 
+QJsonObject ChatFileStore::saveMeta(const QString &filePath) const
+{
+    QJsonObject meta;
+    if (filePath == m_loadedFilePath)
+        meta = m_loadedCompression;
+
+    const Acp::AgentBinding binding = m_bindingReader ? m_bindingReader() : Acp::AgentBinding{};
+    if (!binding.isEmpty())
+        meta["agent"] = binding.toJson();
+    return meta;
+}
+
 QString ChatFileStore::generateChatFileName(const QString &shortMessage, const QString &dir) const
 {
     static const QRegularExpression saitizeSymbols = QRegularExpression("[\\/:*?\"<>|\\s]");
@@ -285,21 +411,115 @@ SerializationResult ChatFileStore::saveToFile(
     return {true, QString()};
 }
 
+SerializationResult ChatFileStore::writeJournal(
+    const QString &filePath, const Session::ConversationHistory &history, const QJsonObject &meta)
+{
+    // Appending is only safe onto the file exactly as it was last written or read; anything
+    // else, including a tail left incomplete by a crash, gets the file rewritten.
+    const bool canAppend = m_journal.filePath == filePath
+                           && QFileInfo(filePath).size() == m_journal.size
+                           && m_journal.size <= 2 * m_journal.compactedSize + kJournalSlackBytes;
+
+    if (canAppend) {
+        QByteArray records = Session::HistorySerializer::journalRecords(m_journal.history, history);
+        if (meta != m_journal.meta)
+            records += Session::HistorySerializer::journalMetaRecord(meta);
+        if (records.isEmpty())
+            return {true, QString()};
+
+        QFile file(filePath);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+            return {false, QString("Failed to open file for writing: %1").arg(filePath)};
+        }
+
+        if (file.write(records) != records.size() || !file.flush()) {
+            m_journal = {};
+            return {false, QString("Failed to write to file: %1").arg(file.errorString())};
+        }
+
+        m_journal.history = history;
+        m_journal.meta = meta;
+        m_journal.size += records.size();
+        indexSavedChat(filePath, history, meta);
+        return {true, QString()};
+    }
+
+    if (!ensureDirectoryExists(filePath)) {
+        return {false, "Failed to create directory structure"};
+    }
+
+    const QByteArray journal = Session::HistorySerializer::toJournal(history, meta);
+
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return {false, QString("Failed to open file for writing: %1").arg(filePath)};
+    }
+
+    if (file.write(journal) == -1) {
+        return {false, QString("Failed to write to file: %1").arg(file.errorString())};
+    }
+
+    if (!file.commit()) {
+        return {false, QString("Failed to save file: %1").arg(file.errorString())};
+    }
+
+    m_journal = {
+        .filePath = filePath,
+        .history = history,
+        .meta = meta,
+        .size = journal.size(),
+        .compactedSize = journal.size()};
+    indexSavedChat(filePath, history, meta);
+    return {true, QString()};
+}
+
 SerializationResult ChatFileStore::loadFromFile(
     Session::ConversationHistory &history, Acp::AgentBinding &binding, const QString &filePath)
+{
+    return loadFromFile(history, binding, filePath, nullptr);
+}
+
+SerializationResult ChatFileStore::loadFromFile(
+    Session::ConversationHistory &history,
+    Acp::AgentBinding &binding,
+    const QString &filePath,
+    LoadedFile *loaded)
 {
     QFile file(filePath);
     if (!file.open(QIODevice::ReadOnly)) {
         return {false, QString("Failed to open file for reading: %1").arg(filePath)};
     }
 
-    QJsonParseError error;
-    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
-    if (error.error != QJsonParseError::NoError) {
-        return {false, QString("JSON parse error: %1").arg(error.errorString())};
+    const QByteArray data = file.readAll();
+    QJsonObject root;
+    QString recoveryWarning;
+
+    if (Session::HistorySerializer::isJournal(data)) {
+        const auto replay = Session::HistorySerializer::replayJournal(data);
+        if (!replay) {
+            return {false, QString("Unsupported chat journal: %1").arg(filePath)};
+        }
+
+        root = replay->root;
+        if (loaded)
+            loaded->journalSize = replay->validLength;
+        if (replay->recoveredTail) {
+            recoveryWarning = QString(
+                "The last change to this chat was not saved completely and has been left out");
+            LOG_MESSAGE(QString("%1: %2").arg(filePath, recoveryWarning));
+        }
+    } else {
+        QJsonParseError error;
+        const QJsonDocument doc = QJsonDocument::fromJson(data, &error);
+        if (error.error != QJsonParseError::NoError) {
+            return {false, QString("JSON parse error: %1").arg(error.errorString())};
+        }
+        root = doc.object();
     }
 
-    const QJsonObject root = doc.object();
+    if (loaded)
+        loaded->compression = compressionLinks(root);
+
     const QString version = root["version"].toString();
 
     if (!Session::HistorySerializer::isSupportedVersion(version)) {
@@ -307,8 +527,8 @@ SerializationResult ChatFileStore::loadFromFile(
     }
 
     int droppedBlocks = 0;
-    const auto loaded = Session::HistorySerializer::fromJson(root, &droppedBlocks);
-    if (!loaded) {
+    const auto parsed = Session::HistorySerializer::fromJson(root, &droppedBlocks);
+    if (!parsed) {
         return {false, QString("Failed to read chat history from: %1").arg(filePath)};
     }
 
@@ -317,7 +537,7 @@ SerializationResult ChatFileStore::loadFromFile(
                         .arg(version, Session::HistorySerializer::currentVersion()));
     }
 
-    history = *loaded;
+    history = *parsed;
 
     QString bindingError;
     binding = Acp::AgentBinding::fromJson(root["agent"], &bindingError);
@@ -339,7 +559,7 @@ SerializationResult ChatFileStore::loadFromFile(
         return {true, QString(), warning};
     }
 
-    return {true, QString(), QString()};
+    return {true, QString(), recoveryWarning};
 }
 
 bool ChatFileStore::ensureDirectoryExists(const QString &filePath)
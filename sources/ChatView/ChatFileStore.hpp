@@ -6,9 +6,13 @@
 
 #include <functional>
 
+#include <QJsonObject>
+#include <QList>
+#include <QMutex>
 #include <QObject>
 #include <QPointer>
 #include <QString>
+#include <QThreadPool>
 
 #include "acp/AgentBinding.hpp"
 #include "session/ConversationHistory.hpp"
@@ -19,6 +23,8 @@ class Session;
 
 namespace QodeAssist::Chat {
 
+class SessionFileRegistry;
+
 struct SerializationResult
 {
     bool success{false};
@@ -32,6 +38,7 @@ class ChatFileStore : public QObject
 
 public:
     explicit ChatFileStore(Session::Session *session, QObject *parent = nullptr);
+    ~ChatFileStore() override;
 
     QString historyDir() const;
     QString suggestedFileName() const;
@@ -47,8 +54,19 @@ public:
     void setBindingReader(BindingReader reader);
     void setBindingWriter(BindingWriter writer);
 
-    SerializationResult save(const QString &filePath) const;
-    SerializationResult load(const QString &filePath) const;
+    // Chats are kept as journals: saving again to the file saved or loaded last only appends
+    // what changed since.
+    SerializationResult save(const QString &filePath);
+    SerializationResult load(const QString &filePath);
+
+    // Takes a snapshot of the history and writes it on a worker thread. Requests for a file that
+    // still has one waiting are folded into it, so a burst of them costs a single write.
+    void requestSave(const QString &filePath);
+    // Blocks until every requested save has been written.
+    void flush();
+    // Writes out every requested save, then gives up the lock on filePath: once released, the
+    // file may be opened by another session at once.
+    void releaseFile(SessionFileRegistry *registry, const QString &filePath);
 
     void showSaveDialog();
     void showLoadDialog();
@@ -78,12 +96,58 @@ signals:
     void loadRequested(const QString &filePath);
 
 private:
+    // What the journal file saved or loaded last holds.
+    struct Journal
+    {
+        QString filePath;
+        Session::ConversationHistory history;
+        QJsonObject meta;
+        qint64 size = 0;
+        qint64 compactedSize = 0;
+    };
+
+    // What load() keeps from a file besides the history and binding.
+    struct LoadedFile
+    {
+        // Bytes of journal replayed; -1 for a plain JSON file.
+        qint64 journalSize = -1;
+        // Where a compressed chat came from; carried over when it is saved again.
+        QJsonObject compression;
+    };
+
+    struct PendingSave
+    {
+        QString filePath;
+        Session::ConversationHistory history;
+        QJsonObject meta;
+    };
+
     QString generateChatFileName(const QString &shortMessage, const QString &dir) const;
+    QJsonObject saveMeta(const QString &filePath) const;
+    SerializationResult writeJournal(
+        const QString &filePath,
+        const Session::ConversationHistory &history,
+        const QJsonObject &meta);
+    static SerializationResult loadFromFile(
+        Session::ConversationHistory &history,
+        Acp::AgentBinding &binding,
+        const QString &filePath,
+        LoadedFile *loaded);
+    void writePendingSaves();
     static bool ensureDirectoryExists(const QString &filePath);
 
     QPointer<Session::Session> m_session;
     BindingReader m_bindingReader;
     BindingWriter m_bindingWriter;
+    QString m_loadedFilePath;
+    QJsonObject m_loadedCompression;
+    // Written by the worker while it runs; the GUI thread only touches it after flush().
+    Journal m_journal;
+
+    QMutex m_pendingMutex;
+    QList<PendingSave> m_pendingSaves;
+    bool m_writerActive = false;
+    QThreadPool m_writer;
 };
 
 } // namespace QodeAssist::Chat
@@ -6,10 +6,10 @@
 
 #include <QDir>
 #include <QFileInfo>
-#include <QRegularExpression>
 #include <QUrl>
 
 #include <algorithm>
+#include <utility>
 
 #include "logger/Logger.hpp"
 
@@ -41,16 +41,59 @@ ChatModel::ChatRole toChatRole(Session::RowKind kind)
     return ChatModel::ChatRole::Assistant;
 }
 
+// Roughly one frame at 60 Hz: streamed text does not need to reach the view more often.
+constexpr int kContentUpdateIntervalMs = 16;
+
 bool carriesUsage(const Session::MessageRow &row)
 {
     return !row.usage.isEmpty();
 }
 
+QList<int> changedRoles(const Session::MessageRow &before, const Session::MessageRow &after)
+{
+    if (before.kind != after.kind)
+        return {};
+
+    QList<int> roles;
+    if (before.content != after.content)
+        roles.append({ChatModel::Content, ChatModel::Parts});
+    if (before.redacted != after.redacted)
+        roles.append(ChatModel::IsRedacted);
+    if (before.attachments != after.attachments)
+        roles.append(ChatModel::Attachments);
+    if (before.images != after.images)
+        roles.append(ChatModel::Images);
+    if (before.toolKind != after.toolKind)
+        roles.append(ChatModel::ToolKind);
+    if (before.toolStatus != after.toolStatus)
+        roles.append(ChatModel::ToolStatus);
+    if (before.toolDetails != after.toolDetails)
+        roles.append(ChatModel::ToolDetails);
+    if (before.toolName != after.toolName)
+        roles.append(ChatModel::ToolName);
+    if (before.toolResult != after.toolResult)
+        roles.append(ChatModel::ToolResult);
+    if (before.usage != after.usage) {
+        roles.append(
+            {ChatModel::PromptTokens,
+             ChatModel::CompletionTokens,
+             ChatModel::CachedPromptTokens,
+             ChatModel::ReasoningTokens,
+             ChatModel::TotalTokens});
+    }
+    return roles;
+}
+
 } // namespace
 
 ChatModel::ChatModel(QObject *parent)
     : QAbstractListModel(parent)
-{}
+{
+    m_contentUpdateTimer.setSingleShot(true);
+    m_contentUpdateTimer.setTimerType(Qt::PreciseTimer);
+    m_contentUpdateTimer.setInterval(kContentUpdateIntervalMs);
+    connect(&m_contentUpdateTimer, &QTimer::timeout, this, &ChatModel::flushContentUpdates);
+}
 
 int ChatModel::rowCount(const QModelIndex &parent) const
 {
@@ -114,6 +157,8 @@ QVariant ChatModel::data(const QModelIndex &index, int role) const
         return message.toolResult;
     case Roles::ToolDetails:
         return QVariant::fromValue(message.toolDetails);
+    case Roles::Parts:
+        return QVariant::fromValue(m_segmenters[index.row()].update(message.content));
     case Roles::Images: {
         QVariantList imagesList;
         for (const auto &image : message.images) {
@@ -162,13 +207,18 @@ QHash<int, QByteArray> ChatModel::roleNames() const
     roles[Roles::ToolDetails] = "toolDetails";
     roles[Roles::ToolName] = "toolName";
     roles[Roles::ToolResult] = "toolResult";
+    roles[Roles::Parts] = "parts";
     return roles;
 }
 
 void ChatModel::resetMessages(const QList<Session::MessageRow> &rows)
 {
+    m_contentUpdateTimer.stop();
+    m_pendingContentRows.clear();
+
     beginResetModel();
     m_messages = rows;
+    m_segmenters = QList<MessageSegmenter>(rows.size());
     endResetModel();
     emit modelReseted();
     emit sessionUsageChanged();
@@ -181,6 +231,7 @@ void ChatModel::appendMessages(const QList<Session::MessageRow> &rows)
 
     beginInsertRows(QModelIndex(), m_messages.size(), m_messages.size() + rows.size() - 1);
     m_messages.append(rows);
+    m_segmenters.resize(m_messages.size());
     endInsertRows();
 
     if (std::any_of(rows.cbegin(), rows.cend(), carriesUsage))
@@ -196,9 +247,25 @@ void ChatModel::updateMessage(int index, const Session::MessageRow &row)
         return;
     }
 
-    const bool usageChanged = m_messages[index].usage != row.usage;
+    const Session::MessageRow &current = m_messages.at(index);
+    const bool kindChanged = current.kind != row.kind;
+    const bool usageChanged = current.usage != row.usage;
+    QList<int> roles = changedRoles(current, row);
     m_messages[index] = row;
-    emit dataChanged(this->index(index), this->index(index));
+
+    if (kindChanged) {
+        m_pendingContentRows.remove(index);
+        emit dataChanged(this->index(index), this->index(index));
+    } else if (roles == QList<int>{Content, Parts}) {
+        // Streamed text: the view picks it up with the next frame.
+        m_pendingContentRows.insert(index);
+        if (!m_contentUpdateTimer.isActive())
+            m_contentUpdateTimer.start();
+    } else if (!roles.isEmpty()) {
+        if (m_pendingContentRows.remove(index) && !roles.contains(Content))
+            roles.append({Content, Parts});
+        emit dataChanged(this->index(index), this->index(index), roles);
+    }
 
     if (usageChanged)
         emit sessionUsageChanged();
@@ -214,75 +281,32 @@ void ChatModel::removeMessages(int first, int count)
         return;
     }
 
+    // Pending rows are addressed by index, so they have to reach the view before rows shift.
+    flushContentUpdates();
+
     const bool usageChanged
         = std::any_of(m_messages.cbegin() + first, m_messages.cbegin() + first + count, carriesUsage);
 
     beginRemoveRows(QModelIndex(), first, first + count - 1);
     m_messages.remove(first, count);
+    m_segmenters.remove(first, count);
     endRemoveRows();
 
     if (usageChanged)
         emit sessionUsageChanged();
 }
 
-QList<MessagePart> ChatModel::processMessageContent(const QString &content) const
+void ChatModel::flushContentUpdates()
 {
-    QList<MessagePart> parts;
-    static const QRegularExpression codeBlockRegex("```(\\w*)\\n?([\\s\\S]*?)```");
-    int lastIndex = 0;
-    auto blockMatches = codeBlockRegex.globalMatch(content);
-
-    while (blockMatches.hasNext()) {
-        auto match = blockMatches.next();
-        if (match.capturedStart() > lastIndex) {
-            QString textBetween
-                = content.mid(lastIndex, match.capturedStart() - lastIndex).trimmed();
-            if (!textBetween.isEmpty()) {
-                MessagePart part;
-                part.type = MessagePartType::Text;
-                part.text = textBetween;
-                parts.append(part);
-            }
-        }
-
-        MessagePart codePart;
-        codePart.type = MessagePartType::Code;
-        codePart.text = match.captured(2).trimmed();
-        codePart.language = match.captured(1);
-        parts.append(codePart);
-
-        lastIndex = match.capturedEnd();
-    }
-
-    if (lastIndex < content.length()) {
-        QString remainingText = content.mid(lastIndex).trimmed();
-
-        static const QRegularExpression unclosedBlockRegex("```(\\w*)\\n?([\\s\\S]*)$");
-        auto unclosedMatch = unclosedBlockRegex.match(remainingText);
-
-        if (unclosedMatch.hasMatch()) {
-            QString beforeCodeBlock = remainingText.left(unclosedMatch.capturedStart()).trimmed();
-            if (!beforeCodeBlock.isEmpty()) {
-                MessagePart part;
-                part.type = MessagePartType::Text;
-                part.text = beforeCodeBlock;
-                parts.append(part);
-            }
+    m_contentUpdateTimer.stop();
+    if (m_pendingContentRows.isEmpty())
+        return;
 
-            MessagePart codePart;
-            codePart.type = MessagePartType::Code;
-            codePart.text = unclosedMatch.captured(2).trimmed();
-            codePart.language = unclosedMatch.captured(1);
-            parts.append(codePart);
-        } else if (!remainingText.isEmpty()) {
-            MessagePart part;
-            part.type = MessagePartType::Text;
-            part.text = remainingText;
-            parts.append(part);
-        }
+    const QSet<int> rows = std::exchange(m_pendingContentRows, {});
+    for (const int row : rows) {
+        if (row < m_messages.size())
+            emit dataChanged(index(row), index(row), {Content, Parts});
     }
-
-    return parts;
 }
 
 QVariantList ChatModel::userMessagePreviews(int maxLength) const
@@ -5,8 +5,11 @@
 #pragma once
 
 #include "MessagePart.hpp"
+#include "MessageSegmenter.hpp"
 
 #include <QAbstractListModel>
+#include <QSet>
+#include <QTimer>
 #include <QtQmlIntegration>
 
 #include "session/HistoryProjection.hpp"
@@ -41,7 +44,8 @@ public:
         ToolStatus,
         ToolDetails,
         ToolName,
-        ToolResult
+        ToolResult,
+        Parts
     };
     Q_ENUM(Roles)
 
@@ -56,7 +60,6 @@ public:
     void updateMessage(int index, const Session::MessageRow &row);
     void removeMessages(int first, int count);
 
-    Q_INVOKABLE QList<MessagePart> processMessageContent(const QString &content) const;
     Q_INVOKABLE QVariantList userMessagePreviews(int maxLength = 80) const;
 
     int sessionPromptTokens() const;
@@ -72,8 +75,15 @@ signals:
     void sessionUsageChanged();
 
 private:
+    void flushContentUpdates();
+
     QList<Session::MessageRow> m_messages;
+    // Parallel to m_messages; parts are split on demand and kept while the content grows.
+    mutable QList<MessageSegmenter> m_segmenters;
     QString m_chatFilePath;
+    // Rows whose streamed content has changed since the last frame.
+    QSet<int> m_pendingContentRows;
+    QTimer m_contentUpdateTimer;
 };
 
 } // namespace QodeAssist::Chat
@@ -6,15 +6,19 @@
 
 #include <QAction>
 #include <QClipboard>
+#include <QDateTime>
 #include <QFile>
 #include <QFileDialog>
 #include <QFileInfo>
+#include <QFutureWatcher>
 #include <QKeySequence>
+#include <QLocale>
 #include <QMessageBox>
 #include <QQmlContext>
 #include <QQmlEngine>
 #include <QTextStream>
 #include <QUrl>
+#include <QtConcurrent>
 
 #include <coreplugin/actionmanager/actionmanager.h>
 #include <coreplugin/actionmanager/command.h>
@@ -43,10 +47,13 @@
 #include "ProjectSettings.hpp"
 #include "SkillsSettings.hpp"
 #include "skills/SkillsManager.hpp"
+#include "tools/ChatHistorySearch.hpp"
 
 namespace QodeAssist::Chat {
 
 namespace {
+constexpr int kHistorySearchLimit = 30;
+
 QKeySequence sendMessageKeySequence()
 {
     auto command = Core::ActionManager::command(Constants::QODE_ASSIST_CHAT_SEND_MESSAGE);
@@ -370,9 +377,8 @@ ChatRootView::ChatRootView(QQuickItem *parent)
 
 ChatRootView::~ChatRootView()
 {
-    if (m_sessionFileRegistry && !m_recentFilePath.isEmpty()) {
-        m_sessionFileRegistry->release(m_recentFilePath);
-    }
+    // The chat file has to be complete before another session may open it.
+    m_historyStore->releaseFile(m_sessionFileRegistry, m_recentFilePath);
 }
 
 void ChatRootView::componentComplete()
@@ -644,6 +650,34 @@ void ChatRootView::showLoadDialog()
     m_historyStore->showLoadDialog();
 }
 
+void ChatRootView::searchChatHistory(const QString &query)
+{
+    using Results = QList<Tools::ChatHistorySearch::Result>;
+
+    const QString directory = m_historyStore->historyDir();
+    auto *watcher = new QFutureWatcher<Results>(this);
+    connect(watcher, &QFutureWatcher<Results>::finished, this, [this, watcher, query] {
+        watcher->deleteLater();
+
+        QVariantList results;
+        for (const Tools::ChatHistorySearch::Result &result : watcher->result()) {
+            results.append(QVariantMap{
+                {"filePath", result.filePath},
+                {"fileName", QFileInfo(result.filePath).fileName()},
+                {"title", result.title},
+                {"snippet", result.snippets.value(0, result.preview)},
+                {"modified",
+                 QLocale().toString(
+                     QDateTime::fromMSecsSinceEpoch(result.modified), QLocale::ShortFormat)}});
+        }
+        emit chatHistorySearchFinished(query, results);
+    });
+    watcher->setFuture(QtConcurrent::run([directory, query] {
+        return Tools::ChatHistorySearch::instance()
+            .search(directory, query, kHistorySearchLimit, 1);
+    }));
+}
+
 void ChatRootView::autosave()
 {
     if (m_chatModel->rowCount() == 0 || !Settings::chatAssistantSettings().autosave()) {
@@ -661,7 +695,7 @@ void ChatRootView::autosave()
         setRecentFilePath(filePath);
     }
 
-    m_historyStore->save(m_recentFilePath);
+    m_historyStore->requestSave(m_recentFilePath);
 }
 
 QString ChatRootView::getAutosaveFilePath() const
@@ -952,9 +986,8 @@ void ChatRootView::setRecentFilePath(const QString &filePath)
     }
 
     if (auto registry = sessionFileRegistry()) {
-        if (!m_recentFilePath.isEmpty()) {
-            registry->release(m_recentFilePath);
-        }
+        // A save still waiting for the old file must not land after another session opened it.
+        m_historyStore->releaseFile(registry, m_recentFilePath);
         if (!filePath.isEmpty()) {
             registry->lock(filePath);
         }
@@ -1197,6 +1230,7 @@ void ChatRootView::startCompression()
     }
 
     autosave();
+    m_historyStore->flush();
 
     m_chatCompressor->startCompression(m_recentFilePath, m_controller->session()->history());
 }
@@ -80,10 +80,13 @@ public:
     QString currentTemplate() const;
 
     void saveHistory(const QString &filePath);
-    void loadHistory(const QString &filePath);
+    Q_INVOKABLE void loadHistory(const QString &filePath);
 
     Q_INVOKABLE void showSaveDialog();
     Q_INVOKABLE void showLoadDialog();
+    // Searches the chats in the history folder off the GUI thread; the results arrive with
+    // chatHistorySearchFinished.
+    Q_INVOKABLE void searchChatHistory(const QString &query);
 
     void autosave();
     QString getAutosaveFilePath() const;
@@ -222,6 +225,8 @@ signals:
     void compressionCompleted(const QString &compressedChatPath);
     void compressionFailed(const QString &error);
 
+    void chatHistorySearchFinished(const QString &query, const QVariantList &results);
+
     void isInEditorChanged();
     void chatTitleChanged();
 
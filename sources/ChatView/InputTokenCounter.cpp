@@ -48,6 +48,10 @@ InputTokenCounter::InputTokenCounter(
         rewireToolsChangedConnection();
         recompute();
     });
+    connect(&Settings::generalSettings().caModel, &Utils::BaseAspect::changed, this, [this]() {
+        m_fileTokens.clear();
+        recompute();
+    });
 
     m_recomputeTimer.setSingleShot(true);
     m_recomputeTimer.setInterval(150);
@@ -69,7 +73,8 @@ int InputTokenCounter::inputTokens() const
 
 void InputTokenCounter::setMessage(const QString &message)
 {
-    m_messageTokens = Context::TokenUtils::estimateTokens(message);
+    m_messageTokens = Context::TokenUtils::estimateTokens(
+        message, Settings::generalSettings().caModel());
     recomputeSoon();
 }
 
@@ -120,7 +125,7 @@ int InputTokenCounter::estimateFileTokens(const QStringList &paths)
 
     for (const QString &path : std::as_const(uncached)) {
         const int tokens = Context::TokenUtils::estimateFilesTokens(
-            m_contextManager->getContentFiles({path}));
+            m_contextManager->getContentFiles({path}), Settings::generalSettings().caModel());
         total += tokens;
         m_fileTokens.insert(path, {QFileInfo(path).lastModified(), tokens});
     }
@@ -132,9 +137,10 @@ void InputTokenCounter::recompute()
 {
     int inputTokens = m_messageTokens;
     auto &settings = Settings::chatAssistantSettings();
+    const QString modelName = Settings::generalSettings().caModel();
 
     if (settings.useSystemPrompt()) {
-        inputTokens += Context::TokenUtils::estimateTokens(settings.systemPrompt());
+        inputTokens += Context::TokenUtils::estimateTokens(settings.systemPrompt(), modelName);
     }
 
     const auto splitImageEstimate = [](const QStringList &paths, QStringList &textPaths) {
@@ -159,7 +165,7 @@ void InputTokenCounter::recompute()
             if (Session::rowTreatmentFor(Session::RowAudience::TokenCount, row.kind)
                 == Session::RowTreatment::Omit)
                 continue;
-            inputTokens += Context::TokenUtils::estimateTokens(row.content);
+            inputTokens += Context::TokenUtils::estimateTokens(row.content, modelName);
             inputTokens += 4; // + role
         }
     }
@@ -10,7 +10,6 @@
 
 #include <memory>
 
-#include "ChatFileStore.hpp"
 #include "llmcore/ContextData.hpp"
 #include "logger/Logger.hpp"
 #include "providers/ProvidersManager.hpp"
@@ -21,6 +20,7 @@
 #include "settings/GeneralSettings.hpp"
 #include "settings/ToolsSettings.hpp"
 #include "tools/ReadOriginalHistoryTool.hpp"
+#include "tools/SearchChatHistoryTool.hpp"
 #include "tools/TodoTool.hpp"
 
 namespace QodeAssist::Chat {
@@ -145,7 +145,12 @@ Session::TurnContextNeeds LlmChatBackend::contextNeeds() const
 
 void LlmChatBackend::setChatFilePath(const QString &filePath)
 {
+    if (filePath == m_chatFilePath)
+        return;
+
     m_chatFilePath = filePath;
+    m_rendered = {};
+    m_storedContent.clear();
 }
 
 void LlmChatBackend::clearToolSession(const QString &filePath)
@@ -230,6 +235,10 @@ void LlmChatBackend::bindToolSessions(Providers::Provider *provider)
             provider->toolsManager()->tool("read_original_history"))) {
         historyTool->setCurrentSessionId(m_chatFilePath);
     }
+    if (auto *searchTool = qobject_cast<Tools::SearchChatHistoryTool *>(
+            provider->toolsManager()->tool("search_chat_history"))) {
+        searchTool->setCurrentSessionId(m_chatFilePath);
+    }
 
     installExecutionGate(provider);
 }
@@ -335,92 +344,122 @@ void LlmChatBackend::cancelPendingPermissions()
 QVector<LLMCore::Message> LlmChatBackend::renderHistory(
     const Session::ConversationHistory &history,
     Providers::Provider *provider,
-    Templates::PromptTemplate *promptTemplate) const
+    Templates::PromptTemplate *promptTemplate)
 {
     const bool toolHistory = promptTemplate->supportsToolHistory();
+    const bool images = provider->capabilities().testFlag(Providers::ProviderCapability::Image)
+                        && !m_chatFilePath.isEmpty();
+    if (toolHistory != m_rendered.toolHistory || images != m_rendered.images)
+        m_rendered = {.toolHistory = toolHistory, .images = images};
+
+    // Messages are rendered independently of what follows them, so everything up to the first
+    // message that differs from the last render is reused as is.
+    const QList<Session::Message> &sources = history.messages();
+    qsizetype reused = 0;
+    while (reused < sources.size() && reused < m_rendered.sources.size()
+           && m_rendered.sources.at(reused).source == sources.at(reused)) {
+        ++reused;
+    }
+    m_rendered.sources.resize(reused);
 
-    QVector<LLMCore::Message> messages;
+    QVector<LLMCore::Message> messages = m_rendered.messages;
     int toolCallMsgIdx = -1;
+    if (reused > 0) {
+        const RenderedMessage &last = m_rendered.sources.constLast();
+        messages.resize(last.renderedCount);
+        toolCallMsgIdx = last.toolCallMessage;
+        // Calls added to the open group by the messages rendered again are added anew.
+        if (toolCallMsgIdx >= 0)
+            messages[toolCallMsgIdx].toolCalls.resize(last.toolCallCount);
+    } else {
+        messages.clear();
+    }
 
-    for (const Session::MessageRow &row : Session::projectToRows(history)) {
-        const Session::RowTreatment treatment
-            = Session::rowTreatmentFor(Session::RowAudience::Prompt, row.kind);
+    for (qsizetype index = reused; index < sources.size(); ++index) {
+        for (const Session::MessageRow &row : Session::projectMessageToRows(sources.at(index))) {
+            const Session::RowTreatment treatment
+                = Session::rowTreatmentFor(Session::RowAudience::Prompt, row.kind);
 
-        if (treatment == Session::RowTreatment::ToolExchange) {
-            if (!toolHistory || row.toolName.isEmpty())
-                continue;
+            if (treatment == Session::RowTreatment::ToolExchange) {
+                if (!toolHistory || row.toolName.isEmpty())
+                    continue;
 
-            if (toolCallMsgIdx < 0) {
-                LLMCore::Message assistantCall;
-                assistantCall.role = "assistant";
-                messages.append(assistantCall);
-                toolCallMsgIdx = messages.size() - 1;
+                if (toolCallMsgIdx < 0) {
+                    LLMCore::Message assistantCall;
+                    assistantCall.role = "assistant";
+                    messages.append(assistantCall);
+                    toolCallMsgIdx = messages.size() - 1;
+                }
+
+                LLMCore::ToolCall call;
+                call.id = row.id;
+                call.name = row.toolName;
+                call.arguments = row.toolArguments;
+                messages[toolCallMsgIdx].toolCalls.append(call);
+
+                LLMCore::Message toolResult;
+                toolResult.role = "tool";
+                toolResult.toolCallId = row.id;
+                toolResult.toolName = row.toolName;
+                toolResult.content = row.toolResult;
+                messages.append(toolResult);
+                continue;
             }
 
-            LLMCore::ToolCall call;
-            call.id = row.id;
-            call.name = row.toolName;
-            call.arguments = row.toolArguments;
-            messages[toolCallMsgIdx].toolCalls.append(call);
-
-            LLMCore::Message toolResult;
-            toolResult.role = "tool";
-            toolResult.toolCallId = row.id;
-            toolResult.toolName = row.toolName;
-            toolResult.content = row.toolResult;
-            messages.append(toolResult);
-            continue;
-        }
-
-        toolCallMsgIdx = -1;
+            toolCallMsgIdx = -1;
 
-        if (treatment == Session::RowTreatment::Omit)
-            continue;
+            if (treatment == Session::RowTreatment::Omit)
+                continue;
 
-        LLMCore::Message apiMessage;
-        apiMessage.role = treatment == Session::RowTreatment::UserText ? "user" : "assistant";
-        apiMessage.content = row.content;
+            LLMCore::Message apiMessage;
+            apiMessage.role = treatment == Session::RowTreatment::UserText ? "user" : "assistant";
+            apiMessage.content = row.content;
+
+            if (!row.attachments.isEmpty() && !m_chatFilePath.isEmpty()) {
+                apiMessage.content += "\n\nAttached files:";
+                for (const Session::AttachmentBlock &attachment : row.attachments) {
+                    const QString fileContent
+                        = m_storedContent.text(m_chatFilePath, attachment.storedPath);
+                    if (fileContent.isEmpty())
+                        continue;
+
+                    apiMessage.content
+                        += "\n\n" + Session::fencedFileBlock(attachment.fileName, fileContent);
+                }
+            }
 
-        if (!row.attachments.isEmpty() && !m_chatFilePath.isEmpty()) {
-            apiMessage.content += "\n\nAttached files:";
-            for (const Session::AttachmentBlock &attachment : row.attachments) {
-                const QByteArray fileContent = ChatFileStore::loadRawContentFromStorage(
-                    m_chatFilePath, attachment.storedPath);
-                if (fileContent.isEmpty())
-                    continue;
+            apiMessage.isThinking = treatment == Session::RowTreatment::AssistantThinking;
+            apiMessage.isRedacted = row.redacted;
+            apiMessage.signature = row.signature;
 
-                apiMessage.content
-                    += "\n\n"
-                       + Session::fencedFileBlock(
-                           attachment.fileName, QString::fromUtf8(fileContent));
+            if (images && !row.images.isEmpty()) {
+                const auto apiImages = loadImagesFromStorage(row.images);
+                if (!apiImages.isEmpty())
+                    apiMessage.images = apiImages;
             }
-        }
-
-        apiMessage.isThinking = treatment == Session::RowTreatment::AssistantThinking;
-        apiMessage.isRedacted = row.redacted;
-        apiMessage.signature = row.signature;
 
-        if (provider->capabilities().testFlag(Providers::ProviderCapability::Image)
-            && !m_chatFilePath.isEmpty() && !row.images.isEmpty()) {
-            const auto apiImages = loadImagesFromStorage(row.images);
-            if (!apiImages.isEmpty())
-                apiMessage.images = apiImages;
+            messages.append(apiMessage);
         }
 
-        messages.append(apiMessage);
+        m_rendered.sources.append(
+            {.source = sources.at(index),
+             .renderedCount = messages.size(),
+             .toolCallMessage = toolCallMsgIdx,
+             .toolCallCount = toolCallMsgIdx >= 0 ? messages[toolCallMsgIdx].toolCalls.size()
+                                                  : 0});
     }
 
+    m_rendered.messages = messages;
     return messages;
 }
 
 QVector<LLMCore::ImageAttachment> LlmChatBackend::loadImagesFromStorage(
-    const QList<Session::ImageBlock> &storedImages) const
+    const QList<Session::ImageBlock> &storedImages)
 {
     QVector<LLMCore::ImageAttachment> apiImages;
 
     for (const Session::ImageBlock &storedImage : storedImages) {
-        const QString base64Data
-            = ChatFileStore::loadContentFromStorage(m_chatFilePath, storedImage.storedPath);
+        const QString base64Data = m_storedContent.base64(m_chatFilePath, storedImage.storedPath);
         if (base64Data.isEmpty()) {
             LOG_MESSAGE(QString("Warning: Failed to load image: %1").arg(storedImage.storedPath));
             continue;
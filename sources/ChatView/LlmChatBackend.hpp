@@ -11,6 +11,7 @@
 
 #include <LLMQore/BaseClient.hpp>
 
+#include "StoredContentCache.hpp"
 #include "providers/Provider.hpp"
 #include "session/ChatBackend.hpp"
 #include "session/TurnLedger.hpp"
@@ -52,9 +53,9 @@ private:
     QVector<LLMCore::Message> renderHistory(
         const Session::ConversationHistory &history,
         Providers::Provider *provider,
-        Templates::PromptTemplate *promptTemplate) const;
+        Templates::PromptTemplate *promptTemplate);
     QVector<LLMCore::ImageAttachment> loadImagesFromStorage(
-        const QList<Session::ImageBlock> &storedImages) const;
+        const QList<Session::ImageBlock> &storedImages);
 
     void handleChunk(const QString &requestId, const QString &chunk);
     void handleCompleted(const QString &requestId, const QString &fullText);
@@ -81,6 +82,26 @@ private:
     Providers::Provider *m_provider = nullptr;
     Session::TurnLedger m_ledger;
     bool m_dropPreToolText = false;
+
+    // The history as last rendered, so the next turn only renders the messages added since.
+    struct RenderedMessage
+    {
+        Session::Message source;
+        // Rendered messages up to and including this one, and the assistant message collecting
+        // tool calls at that point (-1 if none) with the number of calls it held then.
+        qsizetype renderedCount = 0;
+        int toolCallMessage = -1;
+        qsizetype toolCallCount = 0;
+    };
+    struct RenderedHistory
+    {
+        bool toolHistory = false;
+        bool images = false;
+        QList<RenderedMessage> sources;
+        QVector<LLMCore::Message> messages;
+    };
+    RenderedHistory m_rendered;
+    StoredContentCache m_storedContent;
 };
 
 } // namespace QodeAssist::Chat
@@ -26,6 +26,8 @@ public:
     QString language;
     QString imageData;    // Base64 data or URL
     QString mediaType;    // e.g., "image/png", "image/jpeg"
+
+    bool operator==(const MessagePart &other) const = default;
 };
 
 } // namespace QodeAssist::Chat
@@ -0,0 +1,92 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#include "MessageSegmenter.hpp"
+
+#include <QRegularExpression>
+#include <QStringView>
+
+namespace QodeAssist::Chat {
+
+namespace {
+
+void appendPart(
+    QList<MessagePart> &parts,
+    MessagePartType type,
+    const QString &text,
+    const QString &language = QString())
+{
+    MessagePart part;
+    part.type = type;
+    part.text = text;
+    part.language = language;
+    parts.append(part);
+}
+
+void appendText(QList<MessagePart> &parts, QStringView text)
+{
+    text = text.trimmed();
+    if (!text.isEmpty())
+        appendPart(parts, MessagePartType::Text, text.toString());
+}
+
+} // namespace
+
+const QList<MessagePart> &MessageSegmenter::update(const QString &content)
+{
+    if (content == m_content && !m_parts.isEmpty())
+        return m_parts;
+
+    if (content.size() < m_closedLength
+        || QStringView(content).left(m_closedLength)
+               != QStringView(m_content).left(m_closedLength)) {
+        m_closedLength = 0;
+        m_closedParts = 0;
+    }
+    m_content = content;
+    m_parts.resize(m_closedParts);
+
+    static const QRegularExpression codeBlockRegex("```(\\w*)\\n?([\\s\\S]*?)```");
+    auto blockMatches = codeBlockRegex.globalMatch(content, m_closedLength);
+    while (blockMatches.hasNext()) {
+        const auto match = blockMatches.next();
+        const qsizetype textLength = match.capturedStart() - m_closedLength;
+        appendText(m_parts, QStringView(content).mid(m_closedLength, textLength));
+        appendPart(m_parts, MessagePartType::Code, match.captured(2).trimmed(), match.captured(1));
+        m_closedLength = match.capturedEnd();
+    }
+    m_closedParts = m_parts.size();
+
+    // The open tail: plain text, possibly followed by a code block that is still being written.
+    const QString remainingText = QStringView(content).mid(m_closedLength).trimmed().toString();
+    if (remainingText.isEmpty())
+        return m_parts;
+
+    static const QRegularExpression unclosedBlockRegex("```(\\w*)\\n?([\\s\\S]*)$");
+    const auto unclosedMatch = unclosedBlockRegex.match(remainingText);
+    if (unclosedMatch.hasMatch()) {
+        appendText(m_parts, QStringView(remainingText).left(unclosedMatch.capturedStart()));
+        appendPart(
+            m_parts,
+            MessagePartType::Code,
+            unclosedMatch.captured(2).trimmed(),
+            unclosedMatch.captured(1));
+    } else {
+        appendPart(m_parts, MessagePartType::Text, remainingText);
+    }
+    return m_parts;
+}
+
+const QList<MessagePart> &MessageSegmenter::parts() const
+{
+    return m_parts;
+}
+
+QList<MessagePart> MessageSegmenter::split(const QString &content)
+{
+    MessageSegmenter segmenter;
+    return segmenter.update(content);
+}
+
+} // namespace QodeAssist::Chat
@@ -0,0 +1,37 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#pragma once
+
+#include <QList>
+#include <QString>
+
+#include "MessagePart.hpp"
+
+namespace QodeAssist::Chat {
+
+/**
+ * @brief Splits message text into text and code parts, keeping what it has parsed.
+ *
+ * Everything up to the end of the last closed code block can no longer change while text is
+ * appended, so those parts are kept and only the text after them is parsed again on the next
+ * update. Content that no longer starts with the parsed text is parsed from the beginning.
+ */
+class MessageSegmenter
+{
+public:
+    const QList<MessagePart> &update(const QString &content);
+    const QList<MessagePart> &parts() const;
+
+    static QList<MessagePart> split(const QString &content);
+
+private:
+    QString m_content;
+    // End of the last closed code block in m_content and the number of parts before it.
+    qsizetype m_closedLength = 0;
+    qsizetype m_closedParts = 0;
+    QList<MessagePart> m_parts;
+};
+
+} // namespace QodeAssist::Chat
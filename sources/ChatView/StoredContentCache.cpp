@@ -0,0 +1,72 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#include "StoredContentCache.hpp"
+
+#include <QDir>
+#include <QFileInfo>
+
+#include <memory>
+
+#include "ChatFileStore.hpp"
+
+namespace QodeAssist::Chat {
+
+StoredContentCache::StoredContentCache(qsizetype maxBytes)
+    : m_entries(maxBytes)
+{}
+
+QString StoredContentCache::text(const QString &chatFilePath, const QString &storedPath)
+{
+    return load(chatFilePath, storedPath, Encoding::Text);
+}
+
+QString StoredContentCache::base64(const QString &chatFilePath, const QString &storedPath)
+{
+    return load(chatFilePath, storedPath, Encoding::Base64);
+}
+
+void StoredContentCache::clear()
+{
+    m_entries.clear();
+}
+
+qsizetype StoredContentCache::cachedBytes() const
+{
+    return m_entries.totalCost();
+}
+
+QString StoredContentCache::load(
+    const QString &chatFilePath, const QString &storedPath, Encoding encoding)
+{
+    const QFileInfo fileInfo(
+        QDir(ChatFileStore::getChatContentFolder(chatFilePath)).filePath(storedPath));
+    const QString key = (encoding == Encoding::Text ? QLatin1String("text:")
+                                                    : QLatin1String("base64:"))
+                        + fileInfo.absoluteFilePath();
+
+    if (const Entry *entry = m_entries.object(key)) {
+        if (entry->fileSize == fileInfo.size() && entry->modified == fileInfo.lastModified())
+            return entry->payload;
+    }
+
+    const QByteArray content = ChatFileStore::loadRawContentFromStorage(chatFilePath, storedPath);
+    if (content.isEmpty()) {
+        m_entries.remove(key);
+        return QString();
+    }
+
+    auto entry = std::make_unique<Entry>();
+    entry->fileSize = fileInfo.size();
+    entry->modified = fileInfo.lastModified();
+    entry->payload = encoding == Encoding::Text ? QString::fromUtf8(content)
+                                                : QString::fromLatin1(content.toBase64());
+
+    const QString payload = entry->payload;
+    // Payloads larger than the whole cache are returned without being kept.
+    m_entries.insert(key, entry.release(), payload.size() * sizeof(QChar));
+    return payload;
+}
+
+} // namespace QodeAssist::Chat
@@ -0,0 +1,49 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#pragma once
+
+#include <QCache>
+#include <QDateTime>
+#include <QString>
+
+namespace QodeAssist::Chat {
+
+/**
+ * @brief Memory-bounded cache of attachment and image payloads stored next to a chat file.
+ *
+ * Stored files get a unique name when they are saved and are not written again, so the stored
+ * path identifies the content; the file's size and modification time are still checked on every
+ * lookup and a changed file is read again. The least recently used payloads are dropped once
+ * their total size passes the limit.
+ */
+class StoredContentCache
+{
+public:
+    explicit StoredContentCache(qsizetype maxBytes = 64 * 1024 * 1024);
+
+    // Attachment content decoded as UTF-8; empty if the file cannot be read.
+    QString text(const QString &chatFilePath, const QString &storedPath);
+    // Image content encoded as base64; empty if the file cannot be read.
+    QString base64(const QString &chatFilePath, const QString &storedPath);
+
+    void clear();
+    qsizetype cachedBytes() const;
+
+private:
+    enum class Encoding { Text, Base64 };
+
+    struct Entry
+    {
+        qint64 fileSize = 0;
+        QDateTime modified;
+        QString payload;
+    };
+
+    QString load(const QString &chatFilePath, const QString &storedPath, Encoding encoding);
+
+    QCache<QString, Entry> m_entries;
+};
+
+} // namespace QodeAssist::Chat
@@ -112,6 +112,7 @@ ChatRootView {
             }
             openChatHistory.onClicked: root.openChatHistoryFolder()
             contextButton.onClicked: contextViewer.open()
+            searchHistoryButton.onClicked: historySearchPopup.open()
             pinButton {
                 visible: typeof _chatview !== 'undefined'
                 checked: typeof _chatview !== 'undefined' ? _chatview.isPin : false
@@ -296,7 +297,7 @@ ChatRootView {
 
                     width: parent.width
                     chatViewport: chatListView
-                    msgModel: root.chatModel.processMessageContent(model.content)
+                    msgModel: model.parts
                     messageAttachments: model.attachments
                     messageImages: model.images
                     chatFilePath: root.chatFilePath()
@@ -930,6 +931,21 @@ ChatRootView {
         onOpenSettings: root.openSettings()
     }
 
+    HistorySearchPopup {
+        id: historySearchPopup
+
+        width: Math.min(parent.width * 0.85, 700)
+        height: Math.min(parent.height * 0.85, 600)
+        x: (parent.width - width) / 2
+        y: (parent.height - height) / 2
+
+        onSearchRequested: (query) => root.searchChatHistory(query)
+        onChatSelected: (filePath) => {
+            historySearchPopup.close()
+            root.loadHistory(filePath)
+        }
+    }
+
     Connections {
         target: root
         function onLastErrorMessageChanged() {
@@ -937,6 +953,9 @@ ChatRootView {
                 root.hasActiveError = true
             }
         }
+        function onChatHistorySearchFinished(query, results) {
+            historySearchPopup.showResults(query, results)
+        }
         function onLastInfoMessageChanged() {
             if (root.lastInfoMessage.length > 0) {
                 infoToast.show(root.lastInfoMessage)
@@ -11,7 +11,7 @@ import UIControls
 Rectangle {
     id: root
 
-    property alias msgModel: msgCreator.model
+    property var msgModel: []
     property alias messageAttachments: attachmentsModel.model
     property alias messageImages: imagesModel.model
     property string chatFilePath: ""
@@ -53,6 +53,37 @@ Rectangle {
         id: mouse
     }
 
+    onMsgModelChanged: syncParts()
+    Component.onCompleted: syncParts()
+
+    // While a message streams only its last part changes; parts that are still the same keep
+    // their delegates instead of being rebuilt and re-rendered.
+    function syncParts() {
+        const parts = root.msgModel || []
+        for (let i = 0; i < parts.length; ++i) {
+            const part = {
+                partType: parts[i].type,
+                partText: parts[i].text,
+                partLanguage: parts[i].language
+            }
+            if (i >= partsModel.count) {
+                partsModel.append(part)
+                continue
+            }
+            const shown = partsModel.get(i)
+            if (shown.partType !== part.partType || shown.partText !== part.partText
+                    || shown.partLanguage !== part.partLanguage) {
+                partsModel.set(i, part)
+            }
+        }
+        if (partsModel.count > parts.length)
+            partsModel.remove(parts.length, partsModel.count - parts.length)
+    }
+
+    ListModel {
+        id: partsModel
+    }
+
     ColumnLayout {
         id: msgColumn
 
@@ -63,22 +94,18 @@ Rectangle {
 
         Repeater {
             id: msgCreator
+
+            model: partsModel
             delegate: Loader {
                 id: msgCreatorDelegate
-                // Fix me:
-                // why does `required property MessagePart modelData` not work?
-                required property var modelData
+
+                required property int partType
+                required property string partText
+                required property string partLanguage
 
                 Layout.preferredWidth: root.width
                 sourceComponent: {
-                    // If `required property MessagePart modelData` is used
-                    // and conversion to MessagePart fails, you're left
-                    // with a nullptr. This tests that to prevent crashing.
-                    if(!modelData) {
-                        return undefined;
-                    }
-
-                    switch(modelData.type) {
+                    switch(partType) {
                         case MessagePartType.Text: return textComponent;
                         case MessagePartType.Code: return codeBlockComponent;
                         default: return textComponent;
@@ -88,14 +115,15 @@ Rectangle {
                 Component {
                     id: textComponent
                     TextComponent {
-                        itemData: msgCreatorDelegate.modelData
+                        partText: msgCreatorDelegate.partText
                     }
                 }
 
                 Component {
                     id: codeBlockComponent
                     CodeBlockComponent {
-                        itemData: msgCreatorDelegate.modelData
+                        partText: msgCreatorDelegate.partText
+                        partLanguage: msgCreatorDelegate.partLanguage
                     }
                 }
             }
@@ -214,12 +242,12 @@ Rectangle {
     }
 
     component TextComponent : TextBlock {
-        required property var itemData
+        required property string partText
         height: implicitHeight + 10
         verticalAlignment: Text.AlignVCenter
         leftPadding: 10
-        text: textFormat == Text.MarkdownText ? utils.getSafeMarkdownText(itemData.text)
-                                              : itemData.text
+        text: textFormat == Text.MarkdownText ? utils.getSafeMarkdownText(partText)
+                                              : partText
         font.family: root.textFontFamily
         font.pointSize: root.textFontSize
         textFormat: {
@@ -249,7 +277,8 @@ Rectangle {
     component CodeBlockComponent : CodeBlock {
         id: codeblock
 
-        required property var itemData
+        required property string partText
+        required property string partLanguage
         anchors {
             left: parent.left
             leftMargin: 10
@@ -257,8 +286,8 @@ Rectangle {
             rightMargin: 10
         }
 
-        code: itemData.text
-        language: itemData.language
+        code: partText
+        language: partLanguage
         codeFontFamily: root.codeFontFamily
         codeFontSize: root.codeFontSize
         viewport: root.chatViewport
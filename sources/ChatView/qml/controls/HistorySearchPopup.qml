@@ -0,0 +1,213 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+import QtQuick.Controls.Basic as QQC
+
+import UIControls
+
+Popup {
+    id: root
+
+    property var results: []
+    property bool searching: false
+    property string searchedQuery
+
+    signal searchRequested(string query)
+    signal chatSelected(string filePath)
+
+    function showResults(query, found) {
+        if (query !== searchField.text.trim())
+            return
+        root.searching = false
+        root.searchedQuery = query
+        root.results = found
+    }
+
+    modal: true
+    focus: true
+    closePolicy: Popup.CloseOnEscape | Popup.CloseOnPressOutside
+
+    onOpened: {
+        searchField.selectAll()
+        searchField.forceActiveFocus()
+    }
+
+    background: Rectangle {
+        color: palette.window
+        border.color: palette.mid
+        border.width: 1
+        radius: 4
+    }
+
+    Timer {
+        id: searchTimer
+
+        interval: 200
+        onTriggered: {
+            const query = searchField.text.trim()
+            if (query.length === 0) {
+                root.searching = false
+                root.searchedQuery = ""
+                root.results = []
+                return
+            }
+            root.searching = true
+            root.searchRequested(query)
+        }
+    }
+
+    ColumnLayout {
+        anchors.fill: parent
+        anchors.margins: 10
+        spacing: 8
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: 10
+
+            Text {
+                text: qsTr("Search Chat History")
+                font.pixelSize: 16
+                font.bold: true
+                color: palette.text
+                Layout.fillWidth: true
+            }
+
+            QoAButton {
+                text: qsTr("Close")
+                onClicked: root.close()
+            }
+        }
+
+        QQC.TextField {
+            id: searchField
+
+            Layout.fillWidth: true
+            placeholderText: qsTr("Words from messages, tool calls or edited file paths")
+            placeholderTextColor: palette.mid
+            color: palette.text
+            selectByMouse: true
+
+            background: Rectangle {
+                color: palette.base
+                border.color: searchField.activeFocus ? palette.highlight : palette.mid
+                border.width: 1
+                radius: 2
+            }
+
+            onTextChanged: searchTimer.restart()
+            Keys.onReturnPressed: {
+                if (listView.count > 0)
+                    root.chatSelected(root.results[Math.max(0, listView.currentIndex)].filePath)
+            }
+            Keys.onDownPressed: listView.incrementCurrentIndex()
+            Keys.onUpPressed: listView.decrementCurrentIndex()
+        }
+
+        Rectangle {
+            Layout.fillWidth: true
+            height: 1
+            color: palette.mid
+        }
+
+        Text {
+            Layout.fillWidth: true
+            visible: listView.count === 0
+            text: root.searching ? qsTr("Searching…")
+                                 : (root.searchedQuery.length > 0 ? qsTr("No saved chats match.")
+                                                                  : "")
+            color: palette.mid
+            font.pixelSize: 12
+        }
+
+        ListView {
+            id: listView
+
+            Layout.fillWidth: true
+            Layout.fillHeight: true
+            model: root.results
+            clip: true
+            spacing: 2
+
+            ScrollBar.vertical: ScrollBar {
+                policy: ScrollBar.AsNeeded
+            }
+
+            delegate: Rectangle {
+                id: delegateItem
+
+                required property int index
+                required property var modelData
+
+                readonly property bool isCurrent: index === listView.currentIndex
+
+                width: listView.width
+                height: resultColumn.implicitHeight + 12
+                radius: 2
+                color: isCurrent ? palette.highlight
+                                 : (hoverArea.containsMouse
+                                    ? Qt.rgba(palette.highlight.r, palette.highlight.g,
+                                              palette.highlight.b, 0.25)
+                                    : "transparent")
+
+                ColumnLayout {
+                    id: resultColumn
+
+                    anchors {
+                        left: parent.left
+                        right: parent.right
+                        verticalCenter: parent.verticalCenter
+                        leftMargin: 10
+                        rightMargin: 10
+                    }
+                    spacing: 2
+
+                    RowLayout {
+                        Layout.fillWidth: true
+                        spacing: 8
+
+                        Text {
+                            Layout.fillWidth: true
+                            text: delegateItem.modelData.title.length > 0
+                                  ? delegateItem.modelData.title
+                                  : delegateItem.modelData.fileName
+                            color: delegateItem.isCurrent ? palette.highlightedText : palette.text
+                            font.bold: true
+                            elide: Text.ElideRight
+                        }
+
+                        Text {
+                            text: delegateItem.modelData.modified
+                            color: delegateItem.isCurrent ? palette.highlightedText : palette.mid
+                            font.pixelSize: 11
+                        }
+                    }
+
+                    Text {
+                        Layout.fillWidth: true
+                        visible: text.length > 0
+                        text: delegateItem.modelData.snippet
+                        color: delegateItem.isCurrent ? palette.highlightedText : palette.text
+                        font.pixelSize: 11
+                        wrapMode: Text.Wrap
+                        maximumLineCount: 2
+                        elide: Text.ElideRight
+                    }
+                }
+
+                MouseArea {
+                    id: hoverArea
+
+                    anchors.fill: parent
+                    hoverEnabled: true
+                    onEntered: listView.currentIndex = delegateItem.index
+                    onClicked: root.chatSelected(delegateItem.modelData.filePath)
+                }
+            }
+        }
+    }
+}
@@ -20,6 +20,7 @@ Rectangle {
     property alias tokensBadge: tokensBadgeId
     property alias recentPath: recentPathId
     property alias openChatHistory: openChatHistoryId
+    property alias searchHistoryButton: searchHistoryButtonId
     property alias pinButton: pinButtonId
     property alias relocateButton: relocateButtonId
     property alias contextButton: contextButtonId
@@ -256,6 +257,23 @@ Rectangle {
                 }
             }
 
+            QoAButton {
+                id: searchHistoryButtonId
+
+                icon {
+                    source: "qrc:/qt/qml/ChatView/icons/search-history.svg"
+                    color: palette.window.hslLightness > 0.5 ? "#000000" : "#FFFFFF"
+                    height: 15
+                    width: 15
+                }
+
+                QoAToolTip {
+                    visible: searchHistoryButtonId.hovered
+                    delay: 250
+                    text: qsTr("Search saved chats")
+                }
+            }
+
             QoASeparator {}
 
             QoAButton {
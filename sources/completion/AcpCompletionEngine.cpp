@@ -137,7 +137,8 @@ void AcpCompletionEngine::request(quint64 requestId, const CompletionContext &co
 
     Context::DocumentContextReader reader(
         documentInfo.document, documentInfo.mimeType, documentInfo.filePath);
-    const auto ctx = reader.prepareContext(context.line, context.column, m_completeSettings);
+    const auto ctx = reader.prepareContext(
+        context.line, context.column, m_completeSettings, m_generalSettings.ccModel());
     const QString codeContext = ctx.prefix.value_or("") + "<cursor>" + ctx.suffix.value_or("");
 
     m_active
@@ -6,6 +6,7 @@
 
 #include <LLMQore/BaseClient.hpp>
 #include <LLMQore/ToolsManager.hpp>
+#include <QElapsedTimer>
 #include <QUrl>
 
 #include "context/DocumentContextReader.hpp"
@@ -45,6 +46,9 @@ AgenticCompletionEngine::~AgenticCompletionEngine()
 
 void AgenticCompletionEngine::request(quint64 requestId, const CompletionContext &context)
 {
+    QElapsedTimer phaseTimer;
+    phaseTimer.start();
+
     auto documentInfo = m_documentReader.readDocument(context.filePath);
     if (!documentInfo.document) {
         const QString error = QString("Document is not available: %1").arg(context.filePath);
@@ -108,7 +112,8 @@ void AgenticCompletionEngine::request(quint64 requestId, const CompletionContext
 
     Context::DocumentContextReader
         reader(documentInfo.document, documentInfo.mimeType, documentInfo.filePath);
-    auto updatedContext = reader.prepareContext(context.line, context.column, m_completeSettings);
+    auto updatedContext = reader.prepareContext(
+        context.line, context.column, m_completeSettings, m_generalSettings.ccModel());
 
     QString systemPrompt = m_completeSettings.systemPromptForNonFimModels();
     systemPrompt.append(
@@ -132,6 +137,8 @@ void AgenticCompletionEngine::request(quint64 requestId, const CompletionContext
     messages.append({"user", userMessage});
     updatedContext.history = messages;
 
+    const qint64 contextMs = phaseTimer.restart();
+
     QJsonObject payload{{"model", m_generalSettings.ccModel()}, {"stream", true}};
 
     provider->prepareRequest(
@@ -161,8 +168,16 @@ void AgenticCompletionEngine::request(quint64 requestId, const CompletionContext
 
     auto llmRequestId = provider->sendRequest(
         QUrl(m_generalSettings.ccUrl()), payload, promptTemplate->endpoint());
+    const qint64 payloadMs = phaseTimer.elapsed();
     m_activeRequests.insert(llmRequestId, {requestId, documentInfo.filePath, provider});
     m_performanceLogger.startTimeMeasurement(llmRequestId);
+    m_performanceLogger.describeRequest(
+        llmRequestId,
+        {provider->name(),
+         m_generalSettings.ccModel(),
+         m_completeSettings.completionMode.stringValue()});
+    m_performanceLogger.recordPhase(llmRequestId, RequestPhase::Context, contextMs);
+    m_performanceLogger.recordPhase(llmRequestId, RequestPhase::Payload, payloadMs);
 }
 
 void AgenticCompletionEngine::cancel(quint64 requestId)
@@ -173,7 +188,7 @@ void AgenticCompletionEngine::cancel(quint64 requestId)
         const auto llmRequestId = it.key();
         auto *provider = it.value().provider;
         m_activeRequests.erase(it);
-        m_performanceLogger.endTimeMeasurement(llmRequestId);
+        m_performanceLogger.cancelTimeMeasurement(llmRequestId);
         if (provider)
             provider->cancelRequest(llmRequestId);
         return;
@@ -222,7 +237,7 @@ void AgenticCompletionEngine::handleFullResponse(
 
     const ActiveRequest active = it.value();
     m_activeRequests.erase(it);
-    m_performanceLogger.endTimeMeasurement(requestId);
+    m_performanceLogger.failTimeMeasurement(requestId);
 
     const QString error
         = QStringLiteral("The model finished without proposing a completion");
@@ -239,7 +254,7 @@ void AgenticCompletionEngine::handleRequestFailed(
 
     const ActiveRequest active = it.value();
     m_activeRequests.erase(it);
-    m_performanceLogger.endTimeMeasurement(requestId);
+    m_performanceLogger.failTimeMeasurement(requestId);
 
     LOG_MESSAGE(QString("Agentic completion request %1 failed: %2").arg(requestId, error));
 
@@ -6,6 +6,7 @@
 
 #include <QApplication>
 #include <QKeyEvent>
+#include <QTextBlock>
 #include <QTimer>
 
 #include <coreplugin/editormanager/documentmodel.h>
@@ -22,6 +23,9 @@
 #include "settings/SettingsConstants.hpp"
 #include <logger/Logger.hpp>
 
+#include <algorithm>
+#include <limits>
+
 using namespace TextEditor;
 using namespace Utils;
 using namespace ProjectExplorer;
@@ -30,6 +34,59 @@ using namespace Core;
 namespace QodeAssist {
 
 namespace {
+const QString kCompletionCacheName = QStringLiteral("completion cache");
+// Bounds the text around the cursor a completion is cached for, whatever the context settings.
+constexpr qsizetype kMaxCacheWindow = 8 * 1024;
+// How far typing into a cached suggestion is followed.
+constexpr qsizetype kMaxCachedTyping = 1024;
+
+// Up to maxLines whole lines before the cursor line plus the start of that line, at most
+// maxChars characters; read block by block so it does not depend on the document size.
+QString textBefore(const QTextDocument *document, int position, int maxLines, qsizetype maxChars)
+{
+    QTextBlock block = document->findBlock(position);
+    QStringList parts{block.text().left(position - block.position())};
+    qsizetype size = parts.last().size();
+    for (int line = 0; line < maxLines && size < maxChars; ++line) {
+        block = block.previous();
+        if (!block.isValid())
+            break;
+        parts.append(block.text() + QLatin1Char('\n'));
+        size += parts.last().size();
+    }
+    std::reverse(parts.begin(), parts.end());
+    return parts.join(QString()).right(maxChars);
+}
+
+// The rest of the cursor line plus up to maxLines lines after it, at most maxChars characters.
+QString textAfter(const QTextDocument *document, int position, int maxLines, qsizetype maxChars)
+{
+    QTextBlock block = document->findBlock(position);
+    QString text = block.text().mid(position - block.position());
+    for (int line = 0; line < maxLines && text.size() < maxChars; ++line) {
+        block = block.next();
+        if (!block.isValid())
+            break;
+        text += QLatin1Char('\n') + block.text();
+    }
+    return text.left(maxChars);
+}
+
+// The completion request sends this window of the document around position.
+CompletionCache::Key cacheKeyFor(const QTextDocument *document, int position)
+{
+    const auto &settings = Settings::codeCompletionSettings();
+    const bool wholeFile = settings.readFullFile() || settings.useContextTokenBudget();
+    const int linesBefore = wholeFile ? std::numeric_limits<int>::max()
+                                      : settings.readStringsBeforeCursor();
+    const int linesAfter = wholeFile ? std::numeric_limits<int>::max()
+                                     : settings.readStringsAfterCursor();
+    return CompletionCache::keyFor(
+        position,
+        textBefore(document, position, linesBefore, kMaxCacheWindow),
+        textAfter(document, position, linesAfter, kMaxCacheWindow));
+}
+
 bool isIdentifierChar(QChar c)
 {
     return c.isLetterOrNumber() || c == QLatin1Char('_');
@@ -120,17 +177,20 @@ CodeCompletionController::CodeCompletionController(
     CompletionEngine *agenticEngine,
     CompletionEngine *acpEngine,
     Context::ContextManager &contextManager,
+    IRequestPerformanceLogger &performanceLogger,
     QObject *parent)
     : QObject(parent)
     , m_fimEngine(fimEngine)
     , m_agenticEngine(agenticEngine)
     , m_acpEngine(acpEngine)
     , m_contextManager(contextManager)
+    , m_performanceLogger(performanceLogger)
     , m_recentCharCount(0)
 {
     setupConnections();
 
     m_typingTimer.start();
+    m_keystrokeClock.start();
 
     m_refactorHoverHandler = new RefactorSuggestionHoverHandler();
     m_refactorWidgetHandler = new RefactorWidgetHandler(this);
@@ -157,8 +217,12 @@ void CodeCompletionController::openDocument(TextEditor::TextDocument *document)
         if (auto *widget = editor->editorWidget()) {
             widget->addHoverHandler(m_refactorHoverHandler);
             widget->installEventFilter(this);
-            if (!m_hoverHandlerWidgets.contains(widget))
+            if (!m_hoverHandlerWidgets.contains(widget)) {
                 m_hoverHandlerWidgets.append(widget);
+                connect(widget, &TextEditorWidget::cursorPositionChanged, this, [this, widget] {
+                    handleCursorMoved(widget);
+                });
+            }
         }
     }
 
@@ -189,6 +253,17 @@ void CodeCompletionController::openDocument(TextEditor::TextDocument *document)
             if (cursorPosition < position || cursorPosition > position + charsAdded)
                 return;
 
+            m_scheduler.recordKeystroke(m_keystrokeClock.elapsed());
+
+            // Typing into a suggestion seen before, or undoing back to where one was shown.
+            if (!widget->suggestionVisible() && !widget->multiTextCursor().hasSelection()
+                && m_completionCache.entryCount(document->filePath().toUrlishString()) > 0
+                && showCachedCompletion(widget, cursorPosition)) {
+                m_recentCharCount = 0;
+                m_typingTimer.restart();
+                return;
+            }
+
             if (charsRemoved > 0 || charsAdded <= 0) {
                 m_recentCharCount = 0;
                 m_typingTimer.restart();
@@ -235,6 +310,7 @@ void CodeCompletionController::closeDocument(TextEditor::TextDocument *document)
         return;
     disconnect(it.value());
     m_documentConnections.erase(it);
+    m_completionCache.removeDocument(document->filePath().toUrlishString());
 }
 
 void CodeCompletionController::requestCompletions(TextEditor::TextEditorWidget *editor)
@@ -246,8 +322,10 @@ void CodeCompletionController::requestCompletions(TextEditor::TextEditorWidget *
 
     if (m_contextManager.ignoreManager()->shouldIgnore(
             editor->textDocument()->filePath().toUrlishString(), project)) {
-        LOG_MESSAGE(QString("Ignoring file due to .qodeassistignore: %1")
-                        .arg(editor->textDocument()->filePath().toUrlishString()));
+        LOG_DEBUG(
+            Context,
+            QString("Ignoring file due to .qodeassistignore: %1")
+                .arg(editor->textDocument()->filePath().toUrlishString()));
         return;
     }
 
@@ -261,6 +339,16 @@ void CodeCompletionController::requestCompletions(TextEditor::TextEditorWidget *
 
     cancelRunningRequest(editor);
 
+    const int position = cursor.mainCursor().position();
+    if (showCachedCompletion(editor, position))
+        return;
+
+    if (atRequestLimit()) {
+        deferRequest(editor, position);
+        return;
+    }
+    m_performanceLogger.recordCacheLookup(kCompletionCacheName, false);
+
     const auto &settings = Settings::codeCompletionSettings();
     if (settings.abortAssistOnRequest() && !settings.respectQtcPopup())
         editor->abortAssist();
@@ -274,9 +362,9 @@ void CodeCompletionController::requestCompletions(TextEditor::TextEditorWidget *
         m_progressHandler.showProgress(editor);
     }
 
-    const int position = cursor.mainCursor().position();
     const quint64 requestId = ++m_lastRequestId;
-    m_runningRequests[editor] = {requestId, position, engine};
+    m_runningRequests[editor]
+        = {requestId, position, engine, cacheKeyFor(editor->document(), position)};
     m_requestEditors[requestId] = editor;
 
     const QTextBlock block = editor->document()->findBlock(position);
@@ -298,8 +386,10 @@ void CodeCompletionController::requestQuickRefactor(
 
     if (m_contextManager.ignoreManager()->shouldIgnore(
             editor->textDocument()->filePath().toUrlishString(), project)) {
-        LOG_MESSAGE(QString("Ignoring file due to .qodeassistignore: %1")
-                        .arg(editor->textDocument()->filePath().toUrlishString()));
+        LOG_DEBUG(
+            Context,
+            QString("Ignoring file due to .qodeassistignore: %1")
+                .arg(editor->textDocument()->filePath().toUrlishString()));
         return;
     }
 
@@ -350,8 +440,111 @@ void CodeCompletionController::scheduleRequest(TextEditor::TextEditorWidget *edi
         it = m_scheduledRequests.insert(editor, timer);
     }
 
+    const auto &settings = Settings::codeCompletionSettings();
+    const int delay = settings.adaptiveDebounce()
+                          ? m_scheduler.debounceDelay(
+                                settings.startSuggestionTimer(),
+                                m_performanceLogger.latencyPercentile(50),
+                                m_performanceLogger.latencyPercentile(95))
+                          : settings.startSuggestionTimer();
+
     it.value()->setProperty("cursorPosition", editor->textCursor().position());
-    it.value()->start(Settings::codeCompletionSettings().startSuggestionTimer());
+    it.value()->start(delay);
+}
+
+void CodeCompletionController::deferRequest(TextEditor::TextEditorWidget *editor, int position)
+{
+    m_waitingRequests.removeIf([editor](const WaitingRequest &waiting) {
+        return !waiting.editor || waiting.editor == editor;
+    });
+    m_waitingRequests.append({editor, position});
+}
+
+void CodeCompletionController::scheduleWaitingRequests()
+{
+    // Started from the event loop so that freeing a slot never re-enters request handling.
+    if (!m_waitingRequests.isEmpty())
+        QTimer::singleShot(0, this, &CodeCompletionController::startWaitingRequests);
+}
+
+void CodeCompletionController::startWaitingRequests()
+{
+    while (!m_waitingRequests.isEmpty() && !atRequestLimit()) {
+        const WaitingRequest waiting = m_waitingRequests.takeFirst();
+        TextEditorWidget *editor = waiting.editor;
+        // Only worth sending if the cursor is still where the user was waiting for it.
+        if (!editor || m_runningRequests.contains(editor) || editor->suggestionVisible()
+            || editor->textCursor().position() != waiting.position) {
+            continue;
+        }
+        requestCompletions(editor);
+    }
+}
+
+bool CodeCompletionController::atRequestLimit() const
+{
+    return m_runningRequests.size() >= Settings::codeCompletionSettings().maxConcurrentRequests();
+}
+
+void CodeCompletionController::requestSpeculativeCompletion(TextEditor::TextEditorWidget *editor)
+{
+    if (!Settings::codeCompletionSettings().speculativeCompletion() || isAgenticMode()
+        || m_runningRequests.contains(editor) || atRequestLimit()) {
+        return;
+    }
+
+    // The accepted text is in the document by now, so it is part of the prefix.
+    requestCompletions(editor);
+
+    auto it = m_runningRequests.find(editor);
+    if (it != m_runningRequests.end())
+        it.value().speculative = true;
+}
+
+void CodeCompletionController::handleCursorMoved(TextEditor::TextEditorWidget *editor)
+{
+    const auto it = m_runningRequests.constFind(editor);
+    if (it == m_runningRequests.constEnd() || !it->speculative)
+        return;
+
+    // Typing on from where the request was made still fits the suggestion; anything else does not.
+    const QTextCursor cursor = editor->textCursor();
+    if (cursor.position() < it->position
+        || cursor.block() != editor->document()->findBlock(it->position)) {
+        cancelRunningRequest(editor);
+    }
+}
+
+void CodeCompletionController::handleCompletionProgress(quint64 requestId, const QString &text)
+{
+    const QPointer<TextEditorWidget> editor = m_requestEditors.value(requestId);
+    if (!editor || text.trimmed().isEmpty())
+        return;
+
+    auto runningIt = m_runningRequests.find(editor);
+    if (runningIt == m_runningRequests.end() || runningIt.value().id != requestId)
+        return;
+
+    if (runningIt.value().suggestionShown) {
+        if (!editor->suggestionVisible()) {
+            // Accepted or dismissed while still streaming; the rest is of no use.
+            cancelRunningRequest(editor);
+            return;
+        }
+    } else {
+        m_progressHandler.hideProgress();
+        const auto &settings = Settings::codeCompletionSettings();
+        if (settings.abortAssistOnRequest() && !settings.respectQtcPopup())
+            editor->abortAssist();
+    }
+
+    const int requestPosition = runningIt.value().position;
+    if (!applyCompletion(editor, text, requestPosition))
+        return;
+
+    runningIt = m_runningRequests.find(editor);
+    if (runningIt != m_runningRequests.end() && runningIt.value().id == requestId)
+        runningIt.value().suggestionShown = true;
 }
 
 void CodeCompletionController::handleCompletionReady(quint64 requestId, const QString &text)
@@ -373,9 +566,16 @@ void CodeCompletionController::handleCompletionReady(quint64 requestId, const QS
         return;
 
     const int requestPosition = runningIt.value().position;
+    const bool suggestionShown = runningIt.value().suggestionShown;
+    m_completionCache.insert(
+        editor->textDocument()->filePath().toUrlishString(), runningIt.value().cacheKey, text);
     m_runningRequests.erase(runningIt);
+    scheduleWaitingRequests();
 
     m_progressHandler.hideProgress();
+    if (suggestionShown && !editor->suggestionVisible())
+        return;
+
     const auto &settings = Settings::codeCompletionSettings();
     if (settings.abortAssistOnRequest() && !settings.respectQtcPopup())
         editor->abortAssist();
@@ -403,6 +603,7 @@ void CodeCompletionController::handleCompletionFailed(quint64 requestId, const Q
     if (runningIt == m_runningRequests.end() || runningIt.value().id != requestId)
         return;
     m_runningRequests.erase(runningIt);
+    scheduleWaitingRequests();
 
     m_progressHandler.hideProgress();
     m_errorHandler.showError(editor, tr("Code completion failed: %1").arg(error));
@@ -413,21 +614,22 @@ void CodeCompletionController::dropRunningRequestById(quint64 requestId)
     for (auto it = m_runningRequests.begin(); it != m_runningRequests.end(); ++it) {
         if (it.value().id == requestId) {
             m_runningRequests.erase(it);
+            scheduleWaitingRequests();
             return;
         }
     }
 }
 
-void CodeCompletionController::applyCompletion(
+bool CodeCompletionController::applyCompletion(
     TextEditor::TextEditorWidget *editor, const QString &text, int requestPosition)
 {
     const MultiTextCursor cursors = editor->multiTextCursor();
     if (cursors.hasMultipleCursors() || cursors.hasSelection())
-        return;
+        return false;
 
     const int currentPosition = cursors.mainCursor().position();
     if (requestPosition < 0 || currentPosition < requestPosition)
-        return;
+        return false;
 
     QString typedSinceRequest;
     if (currentPosition > requestPosition) {
@@ -437,7 +639,7 @@ void CodeCompletionController::applyCompletion(
         typedSinceRequest = diffCursor.selectedText();
         if (typedSinceRequest.contains(QChar::ParagraphSeparator)
             || typedSinceRequest.contains(QLatin1Char('\n'))) {
-            return;
+            return false;
         }
     }
 
@@ -452,14 +654,14 @@ void CodeCompletionController::applyCompletion(
     if (!typedSinceRequest.isEmpty()) {
         if (!completionText.startsWith(typedSinceRequest)) {
             LOG_MESSAGE("Completion no longer matches the typed text");
-            return;
+            return false;
         }
         completionText = completionText.mid(typedSinceRequest.size());
     }
 
     if (completionText.trimmed().isEmpty()) {
         LOG_MESSAGE("No valid completions received");
-        return;
+        return false;
     }
 
     const int anchorPosition = typedSinceRequest.isEmpty() ? requestPosition : currentPosition;
@@ -467,8 +669,44 @@ void CodeCompletionController::applyCompletion(
         = Text::Position::fromPositionInDocument(editor->document(), anchorPosition);
 
     const TextSuggestion::Data suggestion{Text::Range{anchor, anchor}, anchor, completionText};
-    editor->insertSuggestion(
-        std::make_unique<LLMSuggestion>(QList<TextSuggestion::Data>{suggestion}, editor->document()));
+    auto llmSuggestion = std::make_unique<LLMSuggestion>(
+        QList<TextSuggestion::Data>{suggestion}, editor->document());
+    if (Settings::codeCompletionSettings().speculativeCompletion()) {
+        // The suggestion can outlive both the editor and this controller.
+        llmSuggestion->setAcceptedCallback(
+            [controller = QPointer<CodeCompletionController>(this),
+             editor = QPointer<TextEditorWidget>(editor)] {
+                if (!controller)
+                    return;
+                QTimer::singleShot(0, controller, [controller, editor] {
+                    if (controller && editor)
+                        controller->requestSpeculativeCompletion(editor);
+                });
+            });
+    }
+    editor->insertSuggestion(std::move(llmSuggestion));
+    return true;
+}
+
+bool CodeCompletionController::showCachedCompletion(
+    TextEditor::TextEditorWidget *editor, int position)
+{
+    const QTextDocument *document = editor->document();
+    const int allLines = std::numeric_limits<int>::max();
+    const std::optional<QString> completion = m_completionCache.find(
+        editor->textDocument()->filePath().toUrlishString(),
+        position,
+        textBefore(document, position, allLines, kMaxCacheWindow + kMaxCachedTyping),
+        textAfter(document, position, allLines, kMaxCacheWindow));
+    if (!completion)
+        return false;
+
+    m_performanceLogger.recordCacheLookup(kCompletionCacheName, true);
+    cancelRunningRequest(editor);
+    const auto &settings = Settings::codeCompletionSettings();
+    if (settings.abortAssistOnRequest() && !settings.respectQtcPopup())
+        editor->abortAssist();
+    return applyCompletion(editor, *completion, position);
 }
 
 void CodeCompletionController::cancelRunningRequest(TextEditor::TextEditorWidget *editor)
@@ -483,6 +721,7 @@ void CodeCompletionController::cancelRunningRequest(TextEditor::TextEditorWidget
     m_progressHandler.hideProgress();
     if (engine)
         engine->cancel(requestId);
+    scheduleWaitingRequests();
 }
 
 bool CodeCompletionController::isEnabled(ProjectExplorer::Project *project) const
@@ -509,6 +748,11 @@ void CodeCompletionController::setupConnections()
     for (CompletionEngine *engine : {m_fimEngine, m_agenticEngine, m_acpEngine}) {
         if (!engine)
             continue;
+        connect(
+            engine,
+            &CompletionEngine::completionProgress,
+            this,
+            &CodeCompletionController::handleCompletionProgress);
         connect(
             engine,
             &CompletionEngine::completionReady,
@@ -747,6 +991,10 @@ bool CodeCompletionController::eventFilter(QObject *watched, QEvent *event)
                 cancelRunningRequest(editor);
             }
 
+            m_waitingRequests.removeIf([editor](const WaitingRequest &waiting) {
+                return waiting.editor == editor;
+            });
+
             if (m_scheduledRequests.contains(editor)) {
                 auto *timer = m_scheduledRequests.value(editor);
                 if (timer && timer->isActive()) {
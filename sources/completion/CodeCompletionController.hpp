@@ -12,8 +12,11 @@
 #include <texteditor/textdocument.h>
 #include <texteditor/texteditor.h>
 
+#include "completion/CompletionCache.hpp"
 #include "completion/CompletionEngine.hpp"
+#include "completion/CompletionScheduler.hpp"
 #include "context/ContextManager.hpp"
+#include "logger/IRequestPerformanceLogger.hpp"
 #include "refactor/QuickRefactorHandler.hpp"
 #include "refactor/RefactorSuggestionHoverHandler.hpp"
 #include "widgets/CompletionErrorHandler.hpp"
@@ -32,6 +35,7 @@ public:
         CompletionEngine *agenticEngine,
         CompletionEngine *acpEngine,
         Context::ContextManager &contextManager,
+        IRequestPerformanceLogger &performanceLogger,
         QObject *parent = nullptr);
     ~CodeCompletionController() override;
 
@@ -48,15 +52,32 @@ private:
         quint64 id = 0;
         int position = -1;
         CompletionEngine *engine = nullptr;
+        CompletionCache::Key cacheKey;
+        bool suggestionShown = false;
+        bool speculative = false;
+    };
+
+    struct WaitingRequest
+    {
+        QPointer<TextEditor::TextEditorWidget> editor;
+        int position = -1;
     };
 
     void openDocument(TextEditor::TextDocument *document);
     void closeDocument(TextEditor::TextDocument *document);
     void scheduleRequest(TextEditor::TextEditorWidget *editor);
+    void deferRequest(TextEditor::TextEditorWidget *editor, int position);
+    void scheduleWaitingRequests();
+    void startWaitingRequests();
+    bool atRequestLimit() const;
+    void requestSpeculativeCompletion(TextEditor::TextEditorWidget *editor);
+    void handleCursorMoved(TextEditor::TextEditorWidget *editor);
+    void handleCompletionProgress(quint64 requestId, const QString &text);
     void handleCompletionReady(quint64 requestId, const QString &text);
     void handleCompletionFailed(quint64 requestId, const QString &error);
-    void applyCompletion(
+    bool applyCompletion(
         TextEditor::TextEditorWidget *editor, const QString &text, int requestPosition);
+    bool showCachedCompletion(TextEditor::TextEditorWidget *editor, int position);
     void cancelRunningRequest(TextEditor::TextEditorWidget *editor);
     void dropRunningRequestById(quint64 requestId);
     bool isEnabled(ProjectExplorer::Project *project) const;
@@ -76,10 +97,13 @@ private:
     CompletionEngine *m_agenticEngine = nullptr;
     CompletionEngine *m_acpEngine = nullptr;
     Context::ContextManager &m_contextManager;
+    IRequestPerformanceLogger &m_performanceLogger;
+    CompletionCache m_completionCache;
     quint64 m_lastRequestId = 0;
     QHash<TextEditor::TextEditorWidget *, RunningRequest> m_runningRequests;
     QHash<quint64, QPointer<TextEditor::TextEditorWidget>> m_requestEditors;
     QHash<TextEditor::TextEditorWidget *, QTimer *> m_scheduledRequests;
+    QList<WaitingRequest> m_waitingRequests;
     QHash<TextEditor::TextDocument *, QMetaObject::Connection> m_documentConnections;
     QList<QPointer<TextEditor::TextEditorWidget>> m_hoverHandlerWidgets;
     QMetaObject::Connection m_documentOpenedConnection;
@@ -87,6 +111,8 @@ private:
 
     QElapsedTimer m_typingTimer;
     int m_recentCharCount;
+    QElapsedTimer m_keystrokeClock;
+    CompletionScheduler m_scheduler;
     CompletionProgressHandler m_progressHandler;
     CompletionErrorHandler m_errorHandler;
     QuickRefactorHandler *m_refactorHandler{nullptr};
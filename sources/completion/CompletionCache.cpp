@@ -0,0 +1,95 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#include "completion/CompletionCache.hpp"
+
+namespace QodeAssist {
+
+CompletionCache::CompletionCache(int entriesPerDocument)
+    : m_entriesPerDocument(qMax(1, entriesPerDocument))
+{}
+
+CompletionCache::Key CompletionCache::keyFor(int position, QStringView prefix, QStringView suffix)
+{
+    return {position, prefix.size(), qHash(prefix), suffix.size(), qHash(suffix)};
+}
+
+void CompletionCache::insert(const QString &filePath, const Key &key, const QString &completion)
+{
+    if (completion.trimmed().isEmpty())
+        return;
+
+    QList<Entry> &entries = m_entries[filePath];
+    entries.removeIf([&key](const Entry &entry) {
+        return entry.key.position == key.position && entry.key.prefixLength == key.prefixLength
+               && entry.key.prefixHash == key.prefixHash
+               && entry.key.suffixLength == key.suffixLength
+               && entry.key.suffixHash == key.suffixHash;
+    });
+    entries.prepend({key, completion});
+    if (entries.size() > m_entriesPerDocument)
+        entries.resize(m_entriesPerDocument);
+}
+
+std::optional<QString> CompletionCache::find(
+    const QString &filePath, int position, QStringView before, QStringView after)
+{
+    const auto it = m_entries.find(filePath);
+    if (it == m_entries.end())
+        return std::nullopt;
+
+    // Entries made at one spot share their suffix window, so hash each length once.
+    QHash<qsizetype, size_t> suffixHashes;
+    QList<Entry> &entries = it.value();
+    for (int i = 0; i < entries.size(); ++i) {
+        const Entry &entry = entries.at(i);
+        const qsizetype typedLength = position - entry.key.position;
+        if (typedLength < 0 || typedLength + entry.key.prefixLength > before.size()
+            || entry.key.suffixLength > after.size()) {
+            continue;
+        }
+
+        // Whatever was typed since the request has to be the start of the suggestion.
+        const QStringView typed = before.last(typedLength);
+        if (!QStringView(entry.completion).startsWith(typed))
+            continue;
+        const QString rest = entry.completion.mid(typedLength);
+        if (rest.trimmed().isEmpty())
+            continue;
+
+        auto suffixHash = suffixHashes.constFind(entry.key.suffixLength);
+        if (suffixHash == suffixHashes.constEnd()) {
+            suffixHash = suffixHashes.insert(
+                entry.key.suffixLength, qHash(after.first(entry.key.suffixLength)));
+        }
+        if (suffixHash.value() != entry.key.suffixHash)
+            continue;
+
+        const QStringView prefix = before.first(before.size() - typedLength)
+                                       .last(entry.key.prefixLength);
+        if (qHash(prefix) != entry.key.prefixHash)
+            continue;
+
+        entries.move(i, 0);
+        return rest;
+    }
+    return std::nullopt;
+}
+
+void CompletionCache::removeDocument(const QString &filePath)
+{
+    m_entries.remove(filePath);
+}
+
+void CompletionCache::clear()
+{
+    m_entries.clear();
+}
+
+int CompletionCache::entryCount(const QString &filePath) const
+{
+    return int(m_entries.value(filePath).size());
+}
+
+} // namespace QodeAssist
@@ -0,0 +1,64 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringView>
+
+#include <optional>
+
+namespace QodeAssist {
+
+/**
+ * @brief Recent completions per document, keyed by the text around the cursor they were made for.
+ *
+ * A key covers the window of text before and after the cursor that was sent with the request,
+ * so edits outside it do not matter. An entry is found again when that window is what it was
+ * when the completion was requested, or when the only difference is that the start of the
+ * suggestion has been typed at the cursor since; the rest of the suggestion is returned then.
+ * Only hashes of the window are kept. Each document holds its most recently used entries.
+ */
+class CompletionCache
+{
+public:
+    struct Key
+    {
+        int position = 0;
+        qsizetype prefixLength = 0;
+        size_t prefixHash = 0;
+        qsizetype suffixLength = 0;
+        size_t suffixHash = 0;
+    };
+
+    explicit CompletionCache(int entriesPerDocument = 16);
+
+    // prefix is the text sent before position, suffix the text sent after it.
+    static Key keyFor(int position, QStringView prefix, QStringView suffix);
+
+    void insert(const QString &filePath, const Key &key, const QString &completion);
+    // before ends at position and after starts there. Entries whose window, plus whatever was
+    // typed since, is longer than what is passed in are not found.
+    std::optional<QString> find(
+        const QString &filePath, int position, QStringView before, QStringView after);
+    void removeDocument(const QString &filePath);
+    void clear();
+
+    int entryCount(const QString &filePath) const;
+
+private:
+    struct Entry
+    {
+        Key key;
+        QString completion;
+    };
+
+    // Most recently used first.
+    QHash<QString, QList<Entry>> m_entries;
+    int m_entriesPerDocument;
+};
+
+} // namespace QodeAssist
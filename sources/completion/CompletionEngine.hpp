@@ -27,6 +27,10 @@ public:
     virtual void cancel(quint64 requestId) = 0;
 
 signals:
+    // Emitted while a response streams in, with the whole suggestion so far; engines that only
+    // produce complete responses never emit it. completionReady or completionFailed still ends
+    // every request.
+    void completionProgress(quint64 requestId, const QString &text);
     void completionReady(quint64 requestId, const QString &text);
     void completionFailed(quint64 requestId, const QString &error);
 };
@@ -0,0 +1,68 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#include "completion/CompletionScheduler.hpp"
+
+#include <algorithm>
+
+namespace QodeAssist {
+
+namespace {
+constexpr int kGapWindow = 32;
+constexpr int kMinGapSamples = 8;
+// Longer gaps are pauses, not the rhythm of typing.
+constexpr qint64 kMaxTypingGapMs = 1000;
+constexpr double kPauseFactor = 2.0;
+constexpr double kLatencyShare = 0.1;
+constexpr double kLatencySpreadShare = 0.05;
+constexpr int kMinDelayMs = 50;
+constexpr int kMaxDelayMs = 1500;
+} // namespace
+
+void CompletionScheduler::recordKeystroke(qint64 timestampMs)
+{
+    const qint64 gap = m_lastKeystroke < 0 ? -1 : timestampMs - m_lastKeystroke;
+    m_lastKeystroke = timestampMs;
+    if (gap <= 0 || gap > kMaxTypingGapMs)
+        return;
+
+    m_gaps.append(gap);
+    if (m_gaps.size() > kGapWindow)
+        m_gaps.removeFirst();
+}
+
+void CompletionScheduler::reset()
+{
+    m_gaps.clear();
+    m_lastKeystroke = -1;
+}
+
+qint64 CompletionScheduler::typicalKeystrokeGap() const
+{
+    if (m_gaps.size() < kMinGapSamples)
+        return -1;
+
+    QList<qint64> sorted = m_gaps;
+    const auto middle = sorted.begin() + sorted.size() / 2;
+    std::nth_element(sorted.begin(), middle, sorted.end());
+    return *middle;
+}
+
+int CompletionScheduler::debounceDelay(
+    int fallbackMs, qint64 latencyP50Ms, qint64 latencyP95Ms) const
+{
+    const qint64 gap = typicalKeystrokeGap();
+    if (gap < 0)
+        return fallbackMs;
+
+    double delay = kPauseFactor * double(gap);
+    if (latencyP50Ms > 0) {
+        delay += kLatencyShare * double(latencyP50Ms);
+        if (latencyP95Ms > latencyP50Ms)
+            delay += kLatencySpreadShare * double(latencyP95Ms - latencyP50Ms);
+    }
+    return qBound(kMinDelayMs, int(delay), kMaxDelayMs);
+}
+
+} // namespace QodeAssist
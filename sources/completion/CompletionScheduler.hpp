@@ -0,0 +1,37 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#pragma once
+
+#include <QList>
+#include <QtGlobal>
+
+namespace QodeAssist {
+
+/**
+ * @brief Picks the delay between the last keystroke and an automatic completion request.
+ *
+ * Learns the user's usual gap between keystrokes from the median of recent gaps, leaving out
+ * pauses, and waits for a pause clearly longer than that. The slower the provider has been
+ * recently, the longer it waits on top, since a request outdated by the next keystroke costs
+ * more of a slow server's time.
+ */
+class CompletionScheduler
+{
+public:
+    void recordKeystroke(qint64 timestampMs);
+    void reset();
+
+    // -1 until enough keystrokes have been seen.
+    qint64 typicalKeystrokeGap() const;
+
+    // Latencies are -1 when unknown. Falls back to fallbackMs while the typing rhythm is unknown.
+    int debounceDelay(int fallbackMs, qint64 latencyP50Ms, qint64 latencyP95Ms) const;
+
+private:
+    QList<qint64> m_gaps; // oldest first
+    qint64 m_lastKeystroke = -1;
+};
+
+} // namespace QodeAssist
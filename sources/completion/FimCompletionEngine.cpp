@@ -5,6 +5,7 @@
 #include "completion/FimCompletionEngine.hpp"
 
 #include <LLMQore/BaseClient.hpp>
+#include <QElapsedTimer>
 #include <QJsonArray>
 #include <QUrl>
 
@@ -18,7 +19,18 @@ namespace QodeAssist {
 
 namespace {
 constexpr int kSemanticContextTokenBudget = 1000;
+
+// Partial output can be shown as is unless it is heading into a code block, which CodeHandler
+// can only unwrap once the whole response is in.
+bool isShowablePartial(const QString &text, const QString &outputHandler)
+{
+    if (outputHandler == QLatin1String("Raw text"))
+        return true;
+    if (outputHandler == QLatin1String("Force processing"))
+        return false;
+    return !text.contains(QLatin1Char('`'));
 }
+} // namespace
 
 FimCompletionEngine::FimCompletionEngine(
     const Settings::GeneralSettings &generalSettings,
@@ -54,6 +66,9 @@ FimCompletionEngine::~FimCompletionEngine()
 
 void FimCompletionEngine::request(quint64 requestId, const CompletionContext &context)
 {
+    QElapsedTimer phaseTimer;
+    phaseTimer.start();
+
     auto documentInfo = m_documentReader.readDocument(context.filePath);
     if (!documentInfo.document) {
         const QString error = QString("Document is not available: %1").arg(context.filePath);
@@ -62,16 +77,17 @@ void FimCompletionEngine::request(quint64 requestId, const CompletionContext &co
         return;
     }
 
-    Context::DocumentContextReader
-        reader(documentInfo.document, documentInfo.mimeType, documentInfo.filePath);
-    auto updatedContext = reader.prepareContext(context.line, context.column, m_completeSettings);
-
     bool isPreset1Active = m_contextManager.isSpecifyCompletion(documentInfo);
 
     const auto providerName = !isPreset1Active ? m_generalSettings.ccProvider()
                                                : m_generalSettings.ccPreset1Provider();
     const auto modelName = !isPreset1Active ? m_generalSettings.ccModel()
                                             : m_generalSettings.ccPreset1Model();
+
+    Context::DocumentContextReader
+        reader(documentInfo.document, documentInfo.mimeType, documentInfo.filePath);
+    auto updatedContext
+        = reader.prepareContext(context.line, context.column, m_completeSettings, modelName);
     const auto url = !isPreset1Active ? m_generalSettings.ccUrl()
                                       : m_generalSettings.ccPreset1Url();
 
@@ -126,6 +142,8 @@ void FimCompletionEngine::request(quint64 requestId, const CompletionContext &co
         }
     }
 
+    const qint64 contextMs = phaseTimer.restart();
+    qint64 enrichmentMs = -1;
     if (m_enricher && promptTemplate->type() == Templates::TemplateType::Chat
         && m_completeSettings.completionMode.stringValue()
                == QLatin1StringView(Constants::CC_MODE_FIM_WITH_CONTEXT)) {
@@ -134,9 +152,11 @@ void FimCompletionEngine::request(quint64 requestId, const CompletionContext &co
             updatedContext.prefix.value_or(""),
             context.line,
             context.column,
-            kSemanticContextTokenBudget);
+            kSemanticContextTokenBudget,
+            modelName);
         if (!enrichment.isEmpty())
             systemPrompt.append(enrichment);
+        enrichmentMs = phaseTimer.restart();
     }
 
     updatedContext.systemPrompt = systemPrompt;
@@ -163,6 +183,12 @@ void FimCompletionEngine::request(quint64 requestId, const CompletionContext &co
         false,
         false);
 
+    connect(
+        provider->client(),
+        &::LLMQore::BaseClient::chunkReceived,
+        this,
+        &FimCompletionEngine::handleChunk,
+        Qt::UniqueConnection);
     connect(
         provider->client(),
         &::LLMQore::BaseClient::requestCompleted,
@@ -187,8 +213,23 @@ void FimCompletionEngine::request(quint64 requestId, const CompletionContext &co
 
     auto llmRequestId
         = provider->sendRequest(QUrl(url), payload, resolveEndpoint(promptTemplate, isPreset1Active));
-    m_activeRequests.insert(llmRequestId, {requestId, context.filePath, provider});
+    const qint64 payloadMs = phaseTimer.elapsed();
+
+    ActiveRequest active;
+    active.requestId = requestId;
+    active.filePath = context.filePath;
+    active.provider = provider;
+    active.streaming = m_completeSettings.streamCompletion();
+    active.sent.start();
+    m_activeRequests.insert(llmRequestId, active);
+
     m_performanceLogger.startTimeMeasurement(llmRequestId);
+    m_performanceLogger.describeRequest(
+        llmRequestId,
+        {provider->name(), modelName, m_completeSettings.completionMode.stringValue()});
+    m_performanceLogger.recordPhase(llmRequestId, RequestPhase::Context, contextMs);
+    m_performanceLogger.recordPhase(llmRequestId, RequestPhase::Enrichment, enrichmentMs);
+    m_performanceLogger.recordPhase(llmRequestId, RequestPhase::Payload, payloadMs);
 }
 
 void FimCompletionEngine::cancel(quint64 requestId)
@@ -199,13 +240,35 @@ void FimCompletionEngine::cancel(quint64 requestId)
         const auto llmRequestId = it.key();
         auto *provider = it.value().provider;
         m_activeRequests.erase(it);
-        m_performanceLogger.endTimeMeasurement(llmRequestId);
+        m_performanceLogger.cancelTimeMeasurement(llmRequestId);
         if (provider)
             provider->cancelRequest(llmRequestId);
         return;
     }
 }
 
+void FimCompletionEngine::handleChunk(const ::LLMQore::RequestID &requestId, const QString &chunk)
+{
+    auto it = m_activeRequests.find(requestId);
+    if (it == m_activeRequests.end() || chunk.isEmpty())
+        return;
+
+    ActiveRequest &active = it.value();
+    if (active.firstByteMs < 0) {
+        active.firstByteMs = active.sent.elapsed();
+        m_performanceLogger.recordPhase(requestId, RequestPhase::FirstByte, active.firstByteMs);
+    }
+
+    if (!active.streaming)
+        return;
+
+    active.received.append(chunk);
+    if (!isShowablePartial(active.received, m_completeSettings.modelOutputHandler.stringValue()))
+        return;
+
+    emit completionProgress(active.requestId, active.received);
+}
+
 void FimCompletionEngine::handleFullResponse(
     const ::LLMQore::RequestID &requestId, const QString &fullText)
 {
@@ -215,9 +278,16 @@ void FimCompletionEngine::handleFullResponse(
 
     const ActiveRequest active = it.value();
     m_activeRequests.erase(it);
+    recordStream(requestId, active);
+
+    QElapsedTimer postProcessTimer;
+    postProcessTimer.start();
+    const QString completion = postProcess(fullText, active.filePath);
+    m_performanceLogger
+        .recordPhase(requestId, RequestPhase::PostProcess, postProcessTimer.elapsed());
     m_performanceLogger.endTimeMeasurement(requestId);
 
-    emit completionReady(active.requestId, postProcess(fullText, active.filePath));
+    emit completionReady(active.requestId, completion);
 }
 
 void FimCompletionEngine::handleRequestFinalized(
@@ -244,13 +314,25 @@ void FimCompletionEngine::handleRequestFailed(
 
     const ActiveRequest active = it.value();
     m_activeRequests.erase(it);
-    m_performanceLogger.endTimeMeasurement(requestId);
+    m_performanceLogger.failTimeMeasurement(requestId);
 
     LOG_MESSAGE(QString("Request %1 failed: %2").arg(requestId, error));
 
     emit completionFailed(active.requestId, error);
 }
 
+void FimCompletionEngine::recordStream(
+    const ::LLMQore::RequestID &requestId, const ActiveRequest &active)
+{
+    // Without chunks the whole wait counts as time to first byte.
+    if (active.firstByteMs < 0) {
+        m_performanceLogger.recordPhase(requestId, RequestPhase::FirstByte, active.sent.elapsed());
+        return;
+    }
+    m_performanceLogger
+        .recordPhase(requestId, RequestPhase::Stream, active.sent.elapsed() - active.firstByteMs);
+}
+
 QString FimCompletionEngine::resolveEndpoint(
     Templates::PromptTemplate *promptTemplate, bool isPreset1Active) const
 {
@@ -261,7 +343,7 @@ QString FimCompletionEngine::resolveEndpoint(
 
 QString FimCompletionEngine::postProcess(const QString &completion, const QString &filePath) const
 {
-    LOG_MESSAGE(QString("Completions before filter: \n%1").arg(completion));
+    LOG_DEBUG(Completion, QString("Completions before filter: \n%1").arg(completion));
 
     const QString outputHandler = m_completeSettings.modelOutputHandler.stringValue();
     QString processedCompletion;
@@ -279,12 +361,12 @@ QString FimCompletionEngine::postProcess(const QString &completion, const QStrin
     if (processedCompletion.endsWith('\n')) {
         QString withoutTrailing = processedCompletion.chopped(1);
         if (!withoutTrailing.contains('\n')) {
-            LOG_MESSAGE(QString("Removed trailing newline from single-line completion"));
+            LOG_DEBUG(Completion, QString("Removed trailing newline from single-line completion"));
             processedCompletion = withoutTrailing;
         }
     }
 
-    LOG_MESSAGE(QString("Completion after filter: \n%1").arg(processedCompletion));
+    LOG_DEBUG(Completion, QString("Completion after filter: \n%1").arg(processedCompletion));
 
     return processedCompletion;
 }
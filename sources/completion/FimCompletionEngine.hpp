@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <QElapsedTimer>
 #include <QHash>
 
 #include "completion/CompletionEngine.hpp"
@@ -39,6 +40,7 @@ public:
     void cancel(quint64 requestId) override;
 
 private slots:
+    void handleChunk(const ::LLMQore::RequestID &requestId, const QString &chunk);
     void handleFullResponse(const ::LLMQore::RequestID &requestId, const QString &fullText);
     void handleRequestFinalized(
         const ::LLMQore::RequestID &requestId, const ::LLMQore::CompletionInfo &info);
@@ -50,8 +52,14 @@ private:
         quint64 requestId = 0;
         QString filePath;
         Providers::Provider *provider = nullptr;
+        bool streaming = false;
+        QString received;
+        QElapsedTimer sent;
+        qint64 firstByteMs = -1;
     };
 
+    void recordStream(const ::LLMQore::RequestID &requestId, const ActiveRequest &active);
+
     QString resolveEndpoint(Templates::PromptTemplate *promptTemplate, bool isPreset1Active) const;
     QString postProcess(const QString &completion, const QString &filePath) const;
 
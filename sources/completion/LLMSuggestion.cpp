@@ -142,6 +142,14 @@ bool LLMSuggestion::applyPart(Part part, TextEditor::TextEditorWidget *widget)
         }
     }
 
+    // Inserting the rest as a new suggestion replaces, and so destroys, this one.
+    const std::function<void()> acceptedCallback = m_acceptedCallback;
+    const auto insertRest = [widget, &acceptedCallback](const QList<Data> &rest) {
+        auto suggestion = std::make_unique<LLMSuggestion>(rest, widget->document(), 0);
+        suggestion->setAcceptedCallback(acceptedCallback);
+        widget->insertSuggestion(std::move(suggestion));
+    };
+
     if (!subText.contains('\n')) {
         currentCursor.insertText(subText);
 
@@ -153,9 +161,8 @@ bool LLMSuggestion::applyPart(Part part, TextEditor::TextEditorWidget *widget)
             const Utils::Text::Position
                 newEnd{newStart.line, newStart.column + int(remainingText.length())};
             const Utils::Text::Range newRange{newStart, newEnd};
-            const QList<Data> newSuggestion{{newRange, newStart, remainingText}};
-            widget->insertSuggestion(
-                std::make_unique<LLMSuggestion>(newSuggestion, widget->document(), 0));
+            insertRest({{newRange, newStart, remainingText}});
+            return false;
         }
     } else {
         currentCursor.insertText(subText);
@@ -166,13 +173,14 @@ bool LLMSuggestion::applyPart(Part part, TextEditor::TextEditorWidget *widget)
                 const Utils::Text::Position newStart{int(range.begin.line + subText.count('\n')), 0};
                 const Utils::Text::Position newEnd{newStart.line, int(newCompletionText.length())};
                 const Utils::Text::Range newRange{newStart, newEnd};
-                const QList<Data> newSuggestion{{newRange, newEnd, newCompletionText}};
-                widget->insertSuggestion(
-                    std::make_unique<LLMSuggestion>(newSuggestion, widget->document(), 0));
+                insertRest({{newRange, newEnd, newCompletionText}});
+                return false;
             }
         }
     }
 
+    if (acceptedCallback)
+        acceptedCallback();
     return false;
 }
 
@@ -215,8 +223,15 @@ bool LLMSuggestion::apply()
     }
 
     editCursor.endEditBlock();
+    if (m_acceptedCallback)
+        m_acceptedCallback();
     return true;
 }
 
+void LLMSuggestion::setAcceptedCallback(std::function<void()> callback)
+{
+    m_acceptedCallback = std::move(callback);
+}
+
 } // namespace QodeAssist
 
@@ -7,6 +7,8 @@
 #include <texteditor/texteditor.h>
 #include <texteditor/textsuggestion.h>
 
+#include <functional>
+
 namespace QodeAssist {
 
 class LLMSuggestion : public TextEditor::CyclicSuggestion
@@ -22,6 +24,12 @@ public:
     bool applyPart(Part part, TextEditor::TextEditorWidget *widget);
     bool apply() override;
 
+    // Called once the whole suggestion has been inserted, by apply() or part by part.
+    void setAcceptedCallback(std::function<void()> callback);
+
     static int calculateReplaceLength(const QString &suggestion, const QString &rightText);
+
+private:
+    std::function<void()> m_acceptedCallback;
 };
 } // namespace QodeAssist
@@ -0,0 +1,324 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#include "BpeTokenizer.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+
+#include <array>
+#include <limits>
+#include <vector>
+
+namespace QodeAssist::Context {
+
+namespace {
+
+constexpr int kNoRank = std::numeric_limits<int>::max();
+constexpr int kCachedEntries = 4096;
+constexpr qsizetype kMinCachedLength = 256;
+
+// cl100k-style split: contractions, words with an optional leading non-letter, up to three digits,
+// punctuation runs, newlines and whitespace.
+constexpr char kPretokenizerPattern[]
+    = R"('(?i:[sdmt]|ll|ve|re)|[^\r\n\p{L}\p{N}]?+\p{L}+|\p{N}{1,3}| ?[^\s\p{L}\p{N}]++[\r\n]*)"
+      R"(|\s*[\r\n]|\s+(?!\S)|\s+)";
+
+// Inverse of GPT-2's bytes_to_unicode(): printable Latin-1 bytes map to themselves, the rest to
+// U+0100 onwards in byte order.
+std::array<int, 324> byteLevelDecodeTable()
+{
+    std::array<int, 324> table;
+    table.fill(-1);
+    int shifted = 0;
+    for (int byte = 0; byte < 256; ++byte) {
+        const bool printable = (byte >= '!' && byte <= '~') || (byte >= 0xA1 && byte <= 0xAC)
+                               || (byte >= 0xAE && byte <= 0xFF);
+        const int codePoint = printable ? byte : 256 + shifted++;
+        table[codePoint] = byte;
+    }
+    return table;
+}
+
+bool decodeByteLevelToken(const QString &token, std::string &bytes)
+{
+    static const std::array<int, 324> table = byteLevelDecodeTable();
+
+    bytes.clear();
+    bytes.reserve(token.size());
+    for (const QChar ch : token) {
+        const int codePoint = ch.unicode();
+        if (codePoint >= int(table.size()) || table[codePoint] < 0)
+            return false;
+        bytes.push_back(char(table[codePoint]));
+    }
+    return true;
+}
+
+bool decodeSentencePieceToken(const QString &token, std::string &bytes)
+{
+    bytes.clear();
+    if (token.size() == 6 && token.startsWith("<0x") && token.endsWith('>')) {
+        bool ok = false;
+        const int byte = token.mid(3, 2).toInt(&ok, 16);
+        if (ok) {
+            bytes.push_back(char(byte));
+            return true;
+        }
+    }
+
+    QString text = token;
+    text.replace(QChar(0x2581), QChar(' '));
+    const QByteArray utf8 = text.toUtf8();
+    bytes.assign(utf8.constData(), size_t(utf8.size()));
+    return !bytes.empty();
+}
+
+bool usesByteLevel(const QJsonValue &value)
+{
+    if (value.isObject()) {
+        const QJsonObject object = value.toObject();
+        if (object.value("type").toString() == "ByteLevel")
+            return true;
+        for (auto it = object.constBegin(); it != object.constEnd(); ++it) {
+            if (usesByteLevel(it.value()))
+                return true;
+        }
+    } else if (value.isArray()) {
+        for (const QJsonValue &item : value.toArray()) {
+            if (usesByteLevel(item))
+                return true;
+        }
+    }
+    return false;
+}
+
+bool readFile(const QString &filePath, QByteArray &content, QString *error)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (error)
+            *error = QString("Cannot open tokenizer file %1: %2")
+                         .arg(filePath, file.errorString());
+        return false;
+    }
+    content = file.readAll();
+    return true;
+}
+
+quint64 contentKey(const QString &text)
+{
+    return quint64(qHash(text, 0x51ed27u)) ^ (quint64(text.size()) << 40);
+}
+
+} // namespace
+
+BpeTokenizer::BpeTokenizer(const QString &name, RankTable ranks)
+    : m_name(name)
+    , m_ranks(std::move(ranks))
+    , m_pretokenizer(
+          QString::fromLatin1(kPretokenizerPattern),
+          QRegularExpression::UseUnicodePropertiesOption)
+    , m_cache(kCachedEntries)
+{}
+
+std::unique_ptr<BpeTokenizer> BpeTokenizer::fromTiktokenFile(
+    const QString &filePath, QString *error)
+{
+    QByteArray content;
+    if (!readFile(filePath, content, error))
+        return nullptr;
+
+    RankTable ranks;
+    ranks.reserve(size_t(content.count('\n')) + 1);
+
+    for (const QByteArray &line : content.split('\n')) {
+        const QByteArray trimmed = line.trimmed();
+        if (trimmed.isEmpty())
+            continue;
+
+        const qsizetype separator = trimmed.indexOf(' ');
+        if (separator <= 0) {
+            if (error)
+                *error = QString("Malformed tiktoken line in %1").arg(filePath);
+            return nullptr;
+        }
+
+        bool ok = false;
+        const int rank = trimmed.mid(separator + 1).toInt(&ok);
+        const QByteArray token = QByteArray::fromBase64(trimmed.left(separator));
+        if (!ok || token.isEmpty()) {
+            if (error)
+                *error = QString("Malformed tiktoken line in %1").arg(filePath);
+            return nullptr;
+        }
+        ranks.emplace(std::string(token.constData(), size_t(token.size())), rank);
+    }
+
+    if (ranks.empty()) {
+        if (error)
+            *error = QString("Tokenizer file %1 has no entries").arg(filePath);
+        return nullptr;
+    }
+
+    return std::unique_ptr<BpeTokenizer>(
+        new BpeTokenizer(QFileInfo(filePath).completeBaseName(), std::move(ranks)));
+}
+
+std::unique_ptr<BpeTokenizer> BpeTokenizer::fromHuggingFaceFile(
+    const QString &filePath, QString *error)
+{
+    QByteArray content;
+    if (!readFile(filePath, content, error))
+        return nullptr;
+
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(content, &parseError);
+    if (parseError.error != QJsonParseError::NoError || !document.isObject()) {
+        if (error)
+            *error = QString("Invalid tokenizer JSON %1: %2")
+                         .arg(filePath, parseError.errorString());
+        return nullptr;
+    }
+
+    const QJsonObject root = document.object();
+    const QJsonObject model = root.value("model").toObject();
+    if (model.value("type").toString() != "BPE") {
+        if (error)
+            *error = QString("Tokenizer %1 is not a BPE model").arg(filePath);
+        return nullptr;
+    }
+
+    const bool byteLevel = usesByteLevel(root.value("pre_tokenizer"))
+                           || usesByteLevel(root.value("decoder"));
+    const QJsonObject vocab = model.value("vocab").toObject();
+
+    RankTable ranks;
+    ranks.reserve(size_t(vocab.size()));
+
+    std::string bytes;
+    for (auto it = vocab.constBegin(); it != vocab.constEnd(); ++it) {
+        const bool decoded = byteLevel ? decodeByteLevelToken(it.key(), bytes)
+                                       : decodeSentencePieceToken(it.key(), bytes);
+        if (!decoded)
+            continue;
+
+        const int rank = it.value().toInt();
+        auto [existing, inserted] = ranks.emplace(bytes, rank);
+        if (!inserted && rank < existing->second)
+            existing->second = rank;
+    }
+
+    if (ranks.empty()) {
+        if (error)
+            *error = QString("Tokenizer file %1 has no usable vocabulary").arg(filePath);
+        return nullptr;
+    }
+
+    QString name = QFileInfo(filePath).completeBaseName();
+    if (name == "tokenizer")
+        name = QFileInfo(filePath).dir().dirName();
+
+    return std::unique_ptr<BpeTokenizer>(new BpeTokenizer(name, std::move(ranks)));
+}
+
+QString BpeTokenizer::name() const
+{
+    return m_name;
+}
+
+int BpeTokenizer::vocabularySize() const
+{
+    return int(m_ranks.size());
+}
+
+int BpeTokenizer::countTokens(const QString &text) const
+{
+    if (text.isEmpty())
+        return 0;
+
+    const bool cacheable = text.size() >= kMinCachedLength;
+    const quint64 key = cacheable ? contentKey(text) : 0;
+    if (cacheable) {
+        QMutexLocker locker(&m_cacheMutex);
+        if (const int *cached = m_cache.object(key))
+            return *cached;
+    }
+
+    int tokens = 0;
+    QRegularExpressionMatchIterator it = m_pretokenizer.globalMatch(text);
+    while (it.hasNext()) {
+        const QByteArray piece = it.next().capturedView().toUtf8();
+        tokens += countPieceTokens(std::string_view(piece.constData(), size_t(piece.size())));
+    }
+
+    if (cacheable) {
+        QMutexLocker locker(&m_cacheMutex);
+        m_cache.insert(key, new int(tokens));
+    }
+
+    return tokens;
+}
+
+int BpeTokenizer::rankOf(std::string_view bytes) const
+{
+    const auto it = m_ranks.find(bytes);
+    return it != m_ranks.end() ? it->second : kNoRank;
+}
+
+int BpeTokenizer::countPieceTokens(std::string_view piece) const
+{
+    if (piece.size() <= 1)
+        return int(piece.size());
+    if (rankOf(piece) != kNoRank)
+        return 1;
+
+    // parts[i] is the start offset of the i-th current token and the rank of merging it with its
+    // right neighbour; the final entry only marks the end of the piece.
+    struct Part
+    {
+        size_t start;
+        int rank;
+    };
+    std::vector<Part> parts;
+    parts.reserve(piece.size() + 1);
+    for (size_t i = 0; i <= piece.size(); ++i)
+        parts.push_back({i, kNoRank});
+
+    auto mergedRank = [&](size_t i) {
+        if (i + 2 >= parts.size())
+            return kNoRank;
+        return rankOf(piece.substr(parts[i].start, parts[i + 2].start - parts[i].start));
+    };
+
+    for (size_t i = 0; i + 2 < parts.size(); ++i)
+        parts[i].rank = mergedRank(i);
+
+    while (parts.size() > 2) {
+        size_t best = 0;
+        int bestRank = kNoRank;
+        for (size_t i = 0; i + 1 < parts.size(); ++i) {
+            if (parts[i].rank < bestRank) {
+                bestRank = parts[i].rank;
+                best = i;
+            }
+        }
+        if (bestRank == kNoRank)
+            break;
+
+        parts.erase(parts.begin() + qsizetype(best) + 1);
+        parts[best].rank = mergedRank(best);
+        if (best > 0)
+            parts[best - 1].rank = mergedRank(best - 1);
+    }
+
+    return int(parts.size()) - 1;
+}
+
+} // namespace QodeAssist::Context
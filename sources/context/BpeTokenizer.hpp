@@ -0,0 +1,76 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#pragma once
+
+#include <QCache>
+#include <QMutex>
+#include <QRegularExpression>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "ITokenizer.hpp"
+
+namespace QodeAssist::Context {
+
+/**
+ * @brief Byte-level BPE token counter driven by a merge-rank table.
+ *
+ * Text is split into pieces with a GPT-style pre-tokenizer regex, every piece is encoded as UTF-8
+ * and merged greedily by lowest rank, the same way tiktoken does it. Counts for longer texts are
+ * cached by content hash, since the chat token counter and the completion budget keep asking for
+ * the same system prompts and history rows.
+ */
+class BpeTokenizer : public ITokenizer
+{
+public:
+    /**
+     * @brief Loads a tiktoken rank file: one "<base64 token> <rank>" pair per line (OpenAI
+     * *.tiktoken, Llama 3 tokenizer.model, Qwen qwen.tiktoken).
+     */
+    static std::unique_ptr<BpeTokenizer> fromTiktokenFile(
+        const QString &filePath, QString *error = nullptr);
+
+    /**
+     * @brief Loads the vocabulary of a Hugging Face tokenizer.json with a BPE model. Both
+     * byte-level vocabularies and SentencePiece-style ones ("▁" word marker, <0xNN> byte
+     * fallback) are accepted; token ids are used as merge ranks.
+     */
+    static std::unique_ptr<BpeTokenizer> fromHuggingFaceFile(
+        const QString &filePath, QString *error = nullptr);
+
+    QString name() const override;
+    int countTokens(const QString &text) const override;
+
+    int vocabularySize() const;
+
+private:
+    struct StringHash
+    {
+        using is_transparent = void;
+        size_t operator()(std::string_view value) const
+        {
+            return std::hash<std::string_view>{}(value);
+        }
+    };
+
+    using RankTable = std::unordered_map<std::string, int, StringHash, std::equal_to<>>;
+
+    BpeTokenizer(const QString &name, RankTable ranks);
+
+    int countPieceTokens(std::string_view piece) const;
+    int rankOf(std::string_view bytes) const;
+
+    QString m_name;
+    RankTable m_ranks;
+    QRegularExpression m_pretokenizer;
+
+    mutable QMutex m_cacheMutex;
+    mutable QCache<quint64, int> m_cache;
+};
+
+} // namespace QodeAssist::Context
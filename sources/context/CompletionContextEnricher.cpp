@@ -214,7 +214,12 @@ QStringList qmlEnrichment(const QString &filePath)
 } // anonymous namespace
 
 QString SemanticContextEnricher::enrichmentFor(
-    const DocumentInfo &documentInfo, const QString &prefix, int line, int column, int maxTokens)
+    const DocumentInfo &documentInfo,
+    const QString &prefix,
+    int line,
+    int column,
+    int maxTokens,
+    const QString &modelName)
 {
     const ProgrammingLanguage language
         = ProgrammingLanguageUtils::fromMimeType(documentInfo.mimeType);
@@ -231,21 +236,22 @@ QString SemanticContextEnricher::enrichmentFor(
         return {};
     }
 
-    const QString clamped = clampSectionsToTokenBudget(sections, maxTokens);
+    const QString clamped = clampSectionsToTokenBudget(sections, maxTokens, modelName);
     if (clamped.isEmpty())
         return {};
 
     return QString("\n\n# Project code model context (may lag unsaved edits)\n%1\n").arg(clamped);
 }
 
-QString clampSectionsToTokenBudget(const QStringList &sections, int maxTokens)
+QString clampSectionsToTokenBudget(
+    const QStringList &sections, int maxTokens, const QString &modelName)
 {
     QStringList kept;
     int remaining = maxTokens;
     for (const QString &section : sections) {
         if (section.isEmpty())
             continue;
-        const int cost = TokenUtils::estimateTokens(section);
+        const int cost = TokenUtils::estimateTokens(section, modelName);
         if (cost > remaining)
             continue;
         kept.append(section);
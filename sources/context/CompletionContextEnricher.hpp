@@ -21,7 +21,8 @@ public:
         const QString &prefix,
         int line,
         int column,
-        int maxTokens)
+        int maxTokens,
+        const QString &modelName)
         = 0;
 };
 
@@ -33,10 +34,13 @@ public:
         const QString &prefix,
         int line,
         int column,
-        int maxTokens) override;
+        int maxTokens,
+        const QString &modelName) override;
 };
 
-QString clampSectionsToTokenBudget(const QStringList &sections, int maxTokens);
+// Tokens are counted with the tokenizer of modelName's family.
+QString clampSectionsToTokenBudget(
+    const QStringList &sections, int maxTokens, const QString &modelName = {});
 QStringList identifiersNearCursor(const QString &prefix, int maxIdentifiers);
 
 } // namespace QodeAssist::Context
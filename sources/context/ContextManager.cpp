@@ -48,7 +48,9 @@ QStringList ContextManager::allowedPaths(const QStringList &filePaths) const
         auto project = ProjectExplorer::ProjectManager::projectForFile(
             Utils::FilePath::fromString(path));
         if (project && m_ignoreManager->shouldIgnore(path, project)) {
-            LOG_MESSAGE(QString("Ignoring file in context due to .qodeassistignore: %1").arg(path));
+            LOG_DEBUG(
+                Context,
+                QString("Ignoring file in context due to .qodeassistignore: %1").arg(path));
             continue;
         }
 
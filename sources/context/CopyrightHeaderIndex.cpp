@@ -0,0 +1,178 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#include "CopyrightHeaderIndex.hpp"
+
+#include <QList>
+#include <QRegularExpression>
+#include <QTextBlock>
+
+namespace QodeAssist::Context {
+
+namespace {
+
+// Generated files can carry thousands of #define/#include lines right after the license; the
+// header never legitimately runs this long, so stop looking there.
+constexpr int kMaxHeaderLines = 300;
+
+const QRegularExpression &getYearRegex()
+{
+    static const QRegularExpression yearRegex("\\b(19|20)\\d{2}\\b");
+    return yearRegex;
+}
+
+const QRegularExpression &getNameRegex()
+{
+    static const QRegularExpression nameRegex("\\b[A-Z][a-z.]+ [A-Z][a-z.]+\\b");
+    return nameRegex;
+}
+
+const QRegularExpression &getCommentRegex()
+{
+    static const QRegularExpression commentRegex(
+        R"((/\*[\s\S]*?\*/|//.*$|#.*$|//{2,}[\s\S]*?//{2,}))", QRegularExpression::MultilineOption);
+    return commentRegex;
+}
+
+bool isHeaderLine(const QString &line, bool &inBlockComment)
+{
+    const QString trimmed = line.trimmed();
+    const bool header = inBlockComment || trimmed.isEmpty() || trimmed.startsWith("//")
+                        || trimmed.startsWith('#') || trimmed.startsWith("/*");
+    if (!header)
+        return false;
+
+    qsizetype pos = 0;
+    while (true) {
+        const qsizetype next = line.indexOf(inBlockComment ? "*/" : "/*", pos);
+        if (next < 0)
+            break;
+        inBlockComment = !inBlockComment;
+        pos = next + 2;
+    }
+    return true;
+}
+
+bool hasCopyrightIndicator(const QString &text)
+{
+    return text.contains("copyright") || text.contains("(c)") || text.contains("©")
+           || text.contains("copr.") || text.contains("all rights reserved")
+           || text.contains("proprietary") || text.contains("licensed under")
+           || text.contains("license:") || text.contains("gpl") || text.contains("lgpl")
+           || text.contains("mit license") || text.contains("apache license")
+           || text.contains("bsd license") || text.contains("mozilla public license")
+           || text.contains("copyleft");
+}
+
+} // namespace
+
+CopyrightHeaderIndex::CopyrightHeaderIndex(QTextDocument *document)
+    : QObject(document)
+    , m_document(document)
+{
+    connect(
+        document,
+        &QTextDocument::contentsChange,
+        this,
+        &CopyrightHeaderIndex::handleContentsChange);
+}
+
+CopyrightHeaderIndex *CopyrightHeaderIndex::forDocument(QTextDocument *document)
+{
+    if (!document)
+        return nullptr;
+
+    if (auto *index = document->findChild<CopyrightHeaderIndex *>(
+            QString(), Qt::FindDirectChildrenOnly))
+        return index;
+
+    return new CopyrightHeaderIndex(document);
+}
+
+CopyrightInfo CopyrightHeaderIndex::scan(const QTextDocument *document, int *headerEnd)
+{
+    CopyrightInfo result = {-1, -1, false};
+    if (headerEnd)
+        *headerEnd = 0;
+    if (!document)
+        return result;
+
+    QString text;
+    bool inBlockComment = false;
+    QTextBlock block = document->begin();
+    while (block.isValid() && block.blockNumber() < kMaxHeaderLines) {
+        const QString line = block.text();
+        if (!isHeaderLine(line, inBlockComment))
+            break;
+        if (block.blockNumber() > 0)
+            text.append('\n');
+        text.append(line);
+        block = block.next();
+    }
+
+    // An edit on the first line after the header can turn it into a comment and extend the region.
+    if (headerEnd)
+        *headerEnd = block.isValid() ? block.position() + block.length()
+                                     : document->characterCount();
+
+    QList<CopyrightInfo> copyrightBlocks;
+
+    QRegularExpressionMatchIterator matchIterator = getCommentRegex().globalMatch(text);
+    while (matchIterator.hasNext()) {
+        QRegularExpressionMatch match = matchIterator.next();
+        QString matchedText = match.captured().toLower();
+
+        bool hasIndicator = hasCopyrightIndicator(matchedText);
+        bool hasYear = getYearRegex().match(matchedText).hasMatch();
+        bool hasName = getNameRegex().match(matchedText).hasMatch();
+
+        if ((hasIndicator && (hasYear || hasName)) || (hasYear && hasName)) {
+            CopyrightInfo info;
+            info.startLine = document->findBlock(match.capturedStart()).blockNumber();
+            info.endLine = document->findBlock(match.capturedEnd()).blockNumber();
+            info.found = true;
+
+            copyrightBlocks.append(info);
+        }
+    }
+
+    for (int i = 0; i < copyrightBlocks.size() - 1; ++i) {
+        if (copyrightBlocks[i].endLine + 1 >= copyrightBlocks[i + 1].startLine) {
+            copyrightBlocks[i].endLine = copyrightBlocks[i + 1].endLine;
+            copyrightBlocks.removeAt(i + 1);
+            --i;
+        }
+    }
+
+    if (!copyrightBlocks.isEmpty())
+        return copyrightBlocks.first();
+
+    return result;
+}
+
+CopyrightInfo CopyrightHeaderIndex::copyrightInfo()
+{
+    if (m_dirty) {
+        m_info = scan(m_document, &m_headerEnd);
+        m_dirty = false;
+        ++m_scanCount;
+    }
+    return m_info;
+}
+
+int CopyrightHeaderIndex::scanCount() const
+{
+    return m_scanCount;
+}
+
+void CopyrightHeaderIndex::handleContentsChange(int position, int charsRemoved, int charsAdded)
+{
+    Q_UNUSED(charsRemoved)
+    Q_UNUSED(charsAdded)
+
+    if (!m_dirty && position <= m_headerEnd)
+        m_dirty = true;
+}
+
+} // namespace QodeAssist::Context
@@ -0,0 +1,56 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#pragma once
+
+#include <QObject>
+#include <QTextDocument>
+
+namespace QodeAssist::Context {
+
+struct CopyrightInfo
+{
+    int startLine;
+    int endLine;
+    bool found;
+};
+
+/**
+ * @brief Per-document cache of the copyright header found in the top-of-file comment region.
+ *
+ * The index is attached to the QTextDocument as a child object, so every completion engine and
+ * the quick refactor handler reading the same document share one instance. The header is scanned
+ * lazily and only rescanned after an edit touches the leading comment region (or the first line
+ * following it); edits further down the file keep the cached result.
+ */
+class CopyrightHeaderIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    static CopyrightHeaderIndex *forDocument(QTextDocument *document);
+
+    /**
+     * @brief Scans the leading comment region of @c document without touching any cache.
+     * @c headerEnd, if given, receives the character position up to which an edit invalidates
+     * the result.
+     */
+    static CopyrightInfo scan(const QTextDocument *document, int *headerEnd = nullptr);
+
+    CopyrightInfo copyrightInfo();
+    int scanCount() const;
+
+private:
+    explicit CopyrightHeaderIndex(QTextDocument *document);
+
+    void handleContentsChange(int position, int charsRemoved, int charsAdded);
+
+    QTextDocument *m_document;
+    CopyrightInfo m_info{-1, -1, false};
+    int m_headerEnd = 0;
+    int m_scanCount = 0;
+    bool m_dirty = true;
+};
+
+} // namespace QodeAssist::Context
@@ -8,26 +8,10 @@
 #include <QTextBlock>
 
 #include "CodeCompletionSettings.hpp"
+#include "CopyrightHeaderIndex.hpp"
 #include "ProgrammingLanguage.hpp"
-
-const QRegularExpression &getYearRegex()
-{
-    static const QRegularExpression yearRegex("\\b(19|20)\\d{2}\\b");
-    return yearRegex;
-}
-
-const QRegularExpression &getNameRegex()
-{
-    static const QRegularExpression nameRegex("\\b[A-Z][a-z.]+ [A-Z][a-z.]+\\b");
-    return nameRegex;
-}
-
-const QRegularExpression &getCommentRegex()
-{
-    static const QRegularExpression commentRegex(
-        R"((/\*[\s\S]*?\*/|//.*$|#.*$|//{2,}[\s\S]*?//{2,}))", QRegularExpression::MultilineOption);
-    return commentRegex;
-}
+#include "TokenUtils.hpp"
+#include "TokenizerRegistry.hpp"
 
 namespace QodeAssist::Context {
 
@@ -37,7 +21,8 @@ DocumentContextReader::DocumentContextReader(
     , m_mimeType(mimeType)
     , m_filePath(filePath)
 {
-    m_copyrightInfo = findCopyright();
+    auto *index = CopyrightHeaderIndex::forDocument(document);
+    m_copyrightInfo = index ? index->copyrightInfo() : CopyrightInfo{-1, -1, false};
 }
 
 QString DocumentContextReader::getLineText(int lineNumber, int cursorPosition) const
@@ -45,23 +30,14 @@ QString DocumentContextReader::getLineText(int lineNumber, int cursorPosition) c
     if (!m_document || lineNumber < 0)
         return QString();
 
-    QTextBlock block = m_document->begin();
-    int currentLine = 0;
-
-    while (block.isValid()) {
-        if (currentLine == lineNumber) {
-            QString text = block.text();
-            if (cursorPosition >= 0 && cursorPosition <= text.length()) {
-                text = text.left(cursorPosition);
-            }
-            return text;
-        }
-
-        block = block.next();
-        currentLine++;
-    }
+    const QTextBlock block = m_document->findBlockByNumber(lineNumber);
+    if (!block.isValid())
+        return QString();
 
-    return QString();
+    QString text = block.text();
+    if (cursorPosition >= 0 && cursorPosition <= text.length())
+        text.truncate(cursorPosition);
+    return text;
 }
 
 QString DocumentContextReader::getContextBefore(
@@ -118,130 +94,58 @@ QString DocumentContextReader::getLanguageAndFileInfo() const
 
 CopyrightInfo DocumentContextReader::findCopyright()
 {
-    CopyrightInfo result = {-1, -1, false};
-
-    QString text = m_document->toPlainText();
-    QRegularExpressionMatchIterator matchIterator = getCommentRegex().globalMatch(text);
-
-    QList<CopyrightInfo> copyrightBlocks;
-
-    while (matchIterator.hasNext()) {
-        QRegularExpressionMatch match = matchIterator.next();
-        QString matchedText = match.captured().toLower();
-
-        bool hasCopyrightIndicator = matchedText.contains("copyright")
-                                     || matchedText.contains("(c)") || matchedText.contains("©")
-                                     || matchedText.contains("copr.")
-                                     || matchedText.contains("all rights reserved")
-                                     || matchedText.contains("proprietary")
-                                     || matchedText.contains("licensed under")
-                                     || matchedText.contains("license:")
-                                     || matchedText.contains("gpl") || matchedText.contains("lgpl")
-                                     || matchedText.contains("mit license")
-                                     || matchedText.contains("apache license")
-                                     || matchedText.contains("bsd license")
-                                     || matchedText.contains("mozilla public license")
-                                     || matchedText.contains("copyleft");
-
-        bool hasYear = getYearRegex().match(matchedText).hasMatch();
-        bool hasName = getNameRegex().match(matchedText).hasMatch();
-
-        if ((hasCopyrightIndicator && (hasYear || hasName)) || (hasYear && hasName)) {
-            int startPos = match.capturedStart();
-            int endPos = match.capturedEnd();
-
-            CopyrightInfo info;
-            info.startLine = m_document->findBlock(startPos).blockNumber();
-            info.endLine = m_document->findBlock(endPos).blockNumber();
-            info.found = true;
-
-            copyrightBlocks.append(info);
-        }
-    }
-
-    for (int i = 0; i < copyrightBlocks.size() - 1; ++i) {
-        if (copyrightBlocks[i].endLine + 1 >= copyrightBlocks[i + 1].startLine) {
-            copyrightBlocks[i].endLine = copyrightBlocks[i + 1].endLine;
-            copyrightBlocks.removeAt(i + 1);
-            --i;
-        }
-    }
-
-    if (!copyrightBlocks.isEmpty()) { // temproary solution, need cache
-        return copyrightBlocks.first();
-    }
-
-    return result;
+    return CopyrightHeaderIndex::scan(m_document);
 }
 
 QString DocumentContextReader::getContextBetween(
     int startLine, int startCursorPosition, int endLine, int endCursorPosition) const
 {
-    QString context;
-
     startLine = qMax(startLine, 0);
     endLine = qMin(endLine, m_document->blockCount() - 1);
 
     if (startLine > endLine) {
-        return context;
+        return QString();
     }
 
-    if (startLine == endLine) {
-        auto block = m_document->findBlockByNumber(startLine);
-        if (!block.isValid()) {
-            return context;
-        }
+    const QTextBlock startBlock = m_document->findBlockByNumber(startLine);
+    const QTextBlock endBlock = startLine == endLine ? startBlock
+                                                     : m_document->findBlockByNumber(endLine);
+    if (!startBlock.isValid() || !endBlock.isValid()) {
+        return QString();
+    }
 
-        auto text = block.text();
+    // Block lengths include the separator, so text length is one less.
+    const int startLength = startBlock.length() - 1;
+    const int endLength = endBlock.length() - 1;
+    const int startOffset = startCursorPosition < 0 ? 0 : qMin(startCursorPosition, startLength);
+    const int endOffset = endCursorPosition < 0 ? endLength : qMin(endCursorPosition, endLength);
 
-        if (startCursorPosition < 0) {
-            startCursorPosition = 0;
-        }
-        if (endCursorPosition < 0) {
-            endCursorPosition = text.size();
-        }
-
-        if (startCursorPosition >= endCursorPosition) {
-            return context;
-        }
+    return sliceDocument(
+        startBlock, startBlock.position() + startOffset, endBlock.position() + endOffset);
+}
 
-        return text.mid(startCursorPosition, endCursorPosition - startCursorPosition);
+QString DocumentContextReader::sliceDocument(
+    const QTextBlock &startBlock, int fromPosition, int toPosition) const
+{
+    QString context;
+    if (fromPosition >= toPosition) {
+        return context;
     }
 
-    // first line
-    {
-        auto block = m_document->findBlockByNumber(startLine);
-        if (!block.isValid()) {
-            return context;
-        }
-        auto text = block.text();
-        if (startCursorPosition < 0) {
-            context += text + "\n";
-        } else {
-            context += text.right(text.size() - startCursorPosition) + "\n";
-        }
-    }
+    context.reserve(toPosition - fromPosition);
 
-    // intermediate lines, if any
-    for (int i = startLine + 1; i <= endLine - 1; ++i) {
-        auto block = m_document->findBlockByNumber(i);
-        if (!block.isValid()) {
-            return context;
-        }
-        context += block.text() + "\n";
-    }
+    for (QTextBlock block = startBlock; block.isValid() && block.position() < toPosition;
+         block = block.next()) {
+        const int blockStart = block.position();
+        const QString text = block.text();
+        const int sliceStart = qMax(fromPosition - blockStart, 0);
+        const int sliceEnd = qMin(toPosition - blockStart, int(text.size()));
 
-    // last line
-    {
-        auto block = m_document->findBlockByNumber(endLine);
-        if (!block.isValid()) {
-            return context;
+        if (sliceEnd > sliceStart) {
+            context.append(QStringView(text).mid(sliceStart, sliceEnd - sliceStart));
         }
-        auto text = block.text();
-        if (endCursorPosition < 0) {
-            context += text;
-        } else {
-            context += text.left(endCursorPosition);
+        if (toPosition > blockStart + text.size()) {
+            context.append('\n');
         }
     }
 
@@ -254,8 +158,20 @@ CopyrightInfo DocumentContextReader::copyrightInfo() const
 }
 
 LLMCore::ContextData DocumentContextReader::prepareContext(
-    int lineNumber, int cursorPosition, const Settings::CodeCompletionSettings &settings) const
+    int lineNumber,
+    int cursorPosition,
+    const Settings::CodeCompletionSettings &settings,
+    const QString &modelName) const
 {
+    if (settings.useContextTokenBudget()) {
+        return prepareContextWithinBudget(
+            lineNumber,
+            cursorPosition,
+            settings.contextTokenBudget(),
+            settings.contextPrefixShare() / 100.0,
+            modelName);
+    }
+
     QString contextBefore;
     QString contextAfter;
     if (settings.readFullFile()) {
@@ -276,4 +192,134 @@ LLMCore::ContextData DocumentContextReader::prepareContext(
     return {.prefix = contextBefore, .suffix = contextAfter, .fileContext = fileContext};
 }
 
+LLMCore::ContextData DocumentContextReader::prepareContextWithinBudget(
+    int lineNumber,
+    int cursorPosition,
+    int tokenBudget,
+    double prefixShare,
+    const QString &modelName) const
+{
+    QString fileContext;
+    fileContext.append("\n ").append(getLanguageAndFileInfo());
+
+    const QTextBlock cursorBlock = m_document->findBlockByNumber(lineNumber);
+    if (!cursorBlock.isValid()) {
+        return {.prefix = QString(), .suffix = QString(), .fileContext = fileContext};
+    }
+
+    const int firstLine = m_copyrightInfo.found ? m_copyrightInfo.endLine + 1 : 0;
+    const QString cursorLine = cursorBlock.text();
+    const int column = cursorPosition < 0 ? -1 : qMin(cursorPosition, int(cursorLine.size()));
+
+    // Same convention as getContext{Before,After}: a negative column puts the whole cursor line
+    // into both the prefix and the suffix.
+    const int prefixEnd = cursorBlock.position() + (column < 0 ? int(cursorLine.size()) : column);
+    int prefixStart = prefixEnd;
+    int suffixStart = cursorBlock.position() + qMax(column, 0);
+    int suffixEnd = suffixStart;
+
+    int prefixBudget = qRound(qMax(tokenBudget, 0) * qBound(0.0, prefixShare, 1.0));
+    int suffixBudget = qMax(tokenBudget, 0) - prefixBudget;
+    int prefixTokens = 0;
+    int suffixTokens = 0;
+
+    QTextBlock above = cursorBlock.previous();
+    QTextBlock below = cursorBlock.next();
+    bool prefixOpen = lineNumber >= firstLine;
+    bool suffixOpen = true;
+
+    if (!prefixOpen) {
+        suffixBudget += prefixBudget;
+        prefixBudget = 0;
+    }
+
+    // Resolved once; the registry takes a lock on every lookup.
+    const std::shared_ptr<const ITokenizer> tokenizer
+        = TokenizerRegistry::instance().tokenizerForModel(modelName);
+    auto countTokens = [&tokenizer](const QString &text) {
+        if (text.isEmpty())
+            return 0;
+        return tokenizer ? tokenizer->countTokens(text) : TokenUtils::heuristicTokens(text);
+    };
+
+    // Counts the tokens of a partial line at the cursor. A line longer than the remaining budget is
+    // trimmed proportionally, keeping the part next to the cursor, and closes that side.
+    auto fitPartialLine = [&countTokens](const QString &text, int budget, int &tokens, bool &open) {
+        const int lineTokens = countTokens(text);
+        if (lineTokens <= budget) {
+            tokens += lineTokens;
+            return int(text.size());
+        }
+        tokens = budget;
+        open = false;
+        return int(qint64(text.size()) * budget / lineTokens);
+    };
+
+    if (prefixOpen) {
+        const QString head = cursorLine.left(prefixEnd - cursorBlock.position());
+        prefixStart = prefixEnd - fitPartialLine(head, prefixBudget, prefixTokens, prefixOpen);
+
+        const QString tail = cursorLine.mid(suffixStart - cursorBlock.position());
+        suffixEnd = suffixStart + fitPartialLine(tail, suffixBudget, suffixTokens, suffixOpen);
+    } else {
+        below = m_document->findBlockByNumber(firstLine);
+        if (below.isValid()) {
+            suffixStart = below.position();
+            suffixEnd = suffixStart
+                        + fitPartialLine(below.text(), suffixBudget, suffixTokens, suffixOpen);
+            below = below.next();
+        }
+    }
+
+    auto growPrefix = [&]() {
+        while (prefixOpen) {
+            if (!above.isValid() || above.blockNumber() < firstLine) {
+                prefixOpen = false;
+                break;
+            }
+            const int lineTokens = countTokens(above.text());
+            if (prefixTokens + lineTokens > prefixBudget)
+                break;
+            prefixTokens += lineTokens;
+            prefixStart = above.position();
+            above = above.previous();
+        }
+    };
+
+    auto growSuffix = [&]() {
+        while (suffixOpen) {
+            if (!below.isValid()) {
+                suffixOpen = false;
+                break;
+            }
+            const int lineTokens = countTokens(below.text());
+            if (suffixTokens + lineTokens > suffixBudget)
+                break;
+            suffixTokens += lineTokens;
+            suffixEnd = below.position() + below.length() - 1;
+            below = below.next();
+        }
+    };
+
+    growPrefix();
+    if (!prefixOpen) {
+        suffixBudget += prefixBudget - prefixTokens;
+        prefixBudget = prefixTokens;
+    }
+    growSuffix();
+    if (!suffixOpen && prefixOpen) {
+        prefixBudget += suffixBudget - suffixTokens;
+        suffixBudget = suffixTokens;
+        growPrefix();
+    }
+
+    const QTextBlock prefixBlock = m_document->findBlock(prefixStart);
+    const QTextBlock suffixBlock = m_document->findBlock(suffixStart);
+
+    return {
+        .prefix = sliceDocument(prefixBlock, prefixStart, prefixEnd),
+        .suffix = sliceDocument(suffixBlock, suffixStart, suffixEnd),
+        .fileContext = fileContext};
+}
+
 } // namespace QodeAssist::Context
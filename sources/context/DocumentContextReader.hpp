@@ -5,20 +5,15 @@
 #pragma once
 
 #include <texteditor/textdocument.h>
+#include <QTextBlock>
 #include <QTextDocument>
 
+#include "CopyrightHeaderIndex.hpp"
 #include "llmcore/ContextData.hpp"
 #include <settings/CodeCompletionSettings.hpp>
 
 namespace QodeAssist::Context {
 
-struct CopyrightInfo
-{
-    int startLine;
-    int endLine;
-    bool found;
-};
-
 class DocumentContextReader
 {
 public:
@@ -58,10 +53,36 @@ public:
 
     CopyrightInfo copyrightInfo() const;
 
+    // modelName picks the tokenizer the token budget is counted with; see TokenizerRegistry.
     LLMCore::ContextData prepareContext(
-        int lineNumber, int cursorPosition, const Settings::CodeCompletionSettings &settings) const;
+        int lineNumber,
+        int cursorPosition,
+        const Settings::CodeCompletionSettings &settings,
+        const QString &modelName = {}) const;
+
+    /**
+     * @brief Grows the prefix and suffix outward from @c cursorPosition on @c lineNumber, one
+     * line at a time, until the estimated token count reaches @c tokenBudget.
+     *
+     * @c prefixShare (0..1) of the budget goes to the prefix and the rest to the suffix; budget a
+     * side cannot use because it reached the start or end of the file is handed to the other side.
+     * Only the selected range is copied out of the document. Tokens are counted with the
+     * tokenizer TokenizerRegistry has for @c modelName.
+     */
+    LLMCore::ContextData prepareContextWithinBudget(
+        int lineNumber,
+        int cursorPosition,
+        int tokenBudget,
+        double prefixShare,
+        const QString &modelName = {}) const;
 
 private:
+    /**
+     * @brief Copies the characters in [@c fromPosition, @c toPosition) with a single allocation,
+     * walking blocks forward from @c startBlock, which must contain @c fromPosition.
+     */
+    QString sliceDocument(const QTextBlock &startBlock, int fromPosition, int toPosition) const;
+
     TextEditor::TextDocument *m_textDocument;
     QTextDocument *m_document;
     QString m_mimeType;
@@ -13,6 +13,8 @@
 #include <QTextCursor>
 #include <QTextStream>
 
+#include "LineDiff.hpp"
+
 namespace QodeAssist::Context {
 
 FileEditManager &FileEditManager::instance()
@@ -53,14 +55,16 @@ void FileEditManager::addFileEdit(
     edit.wasAutoApplied = false;
     edit.isFromHistory = isFromHistory;
 
-    LOG_MESSAGE(QString("Creating diff for edit %1").arg(editId));
+    LOG_DEBUG(Context, QString("Creating diff for edit %1").arg(editId));
     locker.unlock();
     edit.diffInfo = createDiffInfo(oldContent, newContent, filePath);
     locker.relock();
-    LOG_MESSAGE(QString("Diff created for edit %1: %2 hunk(s), fallback: %3")
-                   .arg(editId)
-                   .arg(edit.diffInfo.hunks.size())
-                   .arg(edit.diffInfo.useFallback ? "yes" : "no"));
+    LOG_DEBUG(
+        Context,
+        QString("Diff created for edit %1: %2 hunk(s), fallback: %3")
+            .arg(editId)
+            .arg(edit.diffInfo.hunks.size())
+            .arg(edit.diffInfo.useFallback ? "yes" : "no"));
 
     if (isFromHistory) {
         edit.status = Archived;
@@ -163,7 +167,7 @@ bool FileEditManager::applyFileEdit(const QString &editId)
     
     locker.unlock();
     
-    LOG_MESSAGE(QString("Applying edit %1 using fragment replacement").arg(editId));
+    LOG_DEBUG(Context, QString("Applying edit %1 using fragment replacement").arg(editId));
     
     QString errorMsg;
     bool isAppend = oldContentCopy.isEmpty();
@@ -245,7 +249,7 @@ bool FileEditManager::undoFileEdit(const QString &editId)
     
     locker.unlock();
     
-    LOG_MESSAGE(QString("Undoing edit %1 using REVERSE fragment replacement").arg(editId));
+    LOG_DEBUG(Context, QString("Undoing edit %1 using REVERSE fragment replacement").arg(editId));
     
     QString errorMsg;
     bool isAppend = oldContentCopy.isEmpty();
@@ -320,7 +324,7 @@ bool FileEditManager::performFileEdit(
                     cursor.insertText(newContent);
                     cursor.endEditBlock();
                     
-                    LOG_MESSAGE(QString("Appended to open editor: %1").arg(filePath));
+                    LOG_DEBUG(Context, QString("Appended to open editor: %1").arg(filePath));
                     setError("Applied successfully (appended to end of file)");
                     return true;
                 }
@@ -340,7 +344,9 @@ bool FileEditManager::performFileEdit(
                     cursor.insertText(newContent);
                     cursor.endEditBlock();
                     
-                    LOG_MESSAGE(QString("Updated open editor (exact match): %1").arg(filePath));
+                    LOG_DEBUG(
+                        Context,
+                        QString("Updated open editor (exact match): %1").arg(filePath));
                     setError("Applied successfully (exact match)");
                     return true;
                 }
@@ -362,8 +368,11 @@ bool FileEditManager::performFileEdit(
                             cursor.insertText(newContent);
                             cursor.endEditBlock();
                             
-                            LOG_MESSAGE(QString("Updated open editor (fuzzy match %1%%): %2")
-                                            .arg(qRound(similarity * 100)).arg(filePath));
+                            LOG_DEBUG(
+                                Context,
+                                QString("Updated open editor (fuzzy match %1%%): %2")
+                                    .arg(qRound(similarity * 100))
+                                    .arg(filePath));
                             setError(QString("Applied with fuzzy match (%1%% similarity)").arg(qRound(similarity * 100)));
                             return true;
                         }
@@ -394,7 +403,7 @@ bool FileEditManager::performFileEdit(
     
     if (oldContent.isEmpty()) {
         updatedContent = currentContent + newContent;
-        LOG_MESSAGE(QString("Appending to file: %1").arg(filePath));
+        LOG_DEBUG(Context, QString("Appending to file: %1").arg(filePath));
         setError("Applied successfully (appended to end of file)");
     }
     else if (currentContent.contains(oldContent)) {
@@ -402,8 +411,11 @@ bool FileEditManager::performFileEdit(
         updatedContent = currentContent.left(matchPos) 
                        + newContent 
                        + currentContent.mid(matchPos + oldContent.length());
-        LOG_MESSAGE(QString("Using exact match for file update: %1 at position %2")
-                       .arg(filePath).arg(matchPos));
+        LOG_DEBUG(
+            Context,
+            QString("Using exact match for file update: %1 at position %2")
+                .arg(filePath)
+                .arg(matchPos));
         setError("Applied successfully (exact match)");
     } else {
         double similarity = 0.0;
@@ -419,8 +431,12 @@ bool FileEditManager::performFileEdit(
             updatedContent = currentContent.left(matchPos) 
                            + newContent 
                            + currentContent.mid(matchPos + matchedContent.length());
-            LOG_MESSAGE(QString("Using fuzzy match (%1%%) for file update: %2 at position %3")
-                            .arg(qRound(similarity * 100)).arg(filePath).arg(matchPos));
+            LOG_DEBUG(
+                Context,
+                QString("Using fuzzy match (%1%%) for file update: %2 at position %3")
+                    .arg(qRound(similarity * 100))
+                    .arg(filePath)
+                    .arg(matchPos));
             setError(QString("Applied with fuzzy match (%1%% similarity)").arg(qRound(similarity * 100)));
         } else {
             QString msg = QString("Content not found. Best match: %1%% (threshold: 82%%). "
@@ -540,8 +556,10 @@ QString FileEditManager::findBestMatchLineBased(
         *outSimilarity = bestSimilarity;
     }
     
-    LOG_MESSAGE(QString("Line-based search complete, best similarity: %1%%")
-                   .arg(qRound(bestSimilarity * 100)));
+    LOG_DEBUG(
+        Context,
+        QString("Line-based search complete, best similarity: %1%%")
+            .arg(qRound(bestSimilarity * 100)));
     
     return bestMatch;
 }
@@ -563,7 +581,9 @@ QString FileEditManager::findBestMatch(const QString &fileContent, const QString
     
     const int MAX_SEARCH_LENGTH = 50000;
     if (searchLen > MAX_SEARCH_LENGTH) {
-        LOG_MESSAGE(QString("Search content too large (%1 chars), using line-based search").arg(searchLen));
+        LOG_DEBUG(
+            Context,
+            QString("Search content too large (%1 chars), using line-based search").arg(searchLen));
         return findBestMatchLineBased(fileContent, searchContent, threshold, outSimilarity);
     }
     
@@ -602,14 +622,17 @@ QString FileEditManager::findBestMatch(const QString &fileContent, const QString
                 
                 if (similarity >= 0.95) {
                     if (outSimilarity) *outSimilarity = bestSimilarity;
-                    LOG_MESSAGE(QString("Found excellent match early (similarity: %1%%), stopping search").arg(qRound(similarity * 100)));
+                    LOG_DEBUG(
+                        Context,
+                        QString("Found excellent match early (similarity: %1%%), stopping search")
+                            .arg(qRound(similarity * 100)));
                     return bestMatch;
                 }
             }
         }
         
         if (i > searchLen * 3 && bestSimilarity < 0.5) {
-            LOG_MESSAGE("Early termination: no good matches found in first 3x search area");
+            LOG_DEBUG(Context, "Early termination: no good matches found in first 3x search area");
             break;
         }
     }
@@ -619,9 +642,14 @@ QString FileEditManager::findBestMatch(const QString &fileContent, const QString
     }
     
     if (!bestMatch.isEmpty()) {
-        LOG_MESSAGE(QString("Fuzzy match found with similarity: %1%%").arg(qRound(bestSimilarity * 100)));
+        LOG_DEBUG(
+            Context,
+            QString("Fuzzy match found with similarity: %1%%").arg(qRound(bestSimilarity * 100)));
     } else {
-        LOG_MESSAGE(QString("No match found above threshold. Best similarity: %1%%").arg(qRound(bestSimilarity * 100)));
+        LOG_DEBUG(
+            Context,
+            QString("No match found above threshold. Best similarity: %1%%")
+                .arg(qRound(bestSimilarity * 100)));
     }
     
     return bestMatch;
@@ -640,7 +668,7 @@ QString FileEditManager::findBestMatchWithNormalization(
     }
     
     if (fileContent.contains(searchContent)) {
-        LOG_MESSAGE("Match found: Exact match");
+        LOG_DEBUG(Context, "Match found: Exact match");
         if (outSimilarity) *outSimilarity = 1.0;
         if (outMatchType) *outMatchType = "exact";
         return searchContent;
@@ -650,8 +678,9 @@ QString FileEditManager::findBestMatchWithNormalization(
     QString bestMatch = findBestMatch(fileContent, searchContent, 0.0, &bestSim);
     
     if (!bestMatch.isEmpty() && bestSim >= 0.70) {
-        LOG_MESSAGE(QString("Match found: Fuzzy match (%1%% similarity)")
-                       .arg(qRound(bestSim * 100)));
+        LOG_DEBUG(
+            Context,
+            QString("Match found: Fuzzy match (%1%% similarity)").arg(qRound(bestSim * 100)));
         if (outSimilarity) *outSimilarity = bestSim;
         if (outMatchType) {
             if (bestSim >= 0.85) {
@@ -703,9 +732,11 @@ bool FileEditManager::performFragmentReplacement(
     } else {
         double minThreshold = isUndo ? 0.70 : 0.85;
         
-        LOG_MESSAGE(QString("Fragment replacement: isUndo=%1, threshold=%2%%")
-                       .arg(isUndo ? "yes" : "no")
-                       .arg(qRound(minThreshold * 100)));
+        LOG_DEBUG(
+            Context,
+            QString("Fragment replacement: isUndo=%1, threshold=%2%%")
+                .arg(isUndo ? "yes" : "no")
+                .arg(qRound(minThreshold * 100)));
         
         double similarity = 0.0;
         QString matchType;
@@ -738,10 +769,12 @@ bool FileEditManager::performFragmentReplacement(
                           + replaceContent 
                           + currentContent.mid(matchPos + matchedContent.length());
             
-            LOG_MESSAGE(QString("Replaced content at position %1 (length: %2 -> %3)")
-                           .arg(matchPos)
-                           .arg(matchedContent.length())
-                           .arg(replaceContent.length()));
+            LOG_DEBUG(
+                Context,
+                QString("Replaced content at position %1 (length: %2 -> %3)")
+                    .arg(matchPos)
+                    .arg(matchedContent.length())
+                    .arg(replaceContent.length()));
             
             if (errorMsg) {
                 if (matchType == "exact") {
@@ -785,7 +818,10 @@ bool FileEditManager::performFragmentReplacement(
                         if (errorMsg && errorMsg->isEmpty()) {
                             *errorMsg = isUndo ? "Successfully undone" : "Successfully applied";
                         }
-                        LOG_MESSAGE(QString("Applied fragment replacement to open editor: %1").arg(filePath));
+                        LOG_DEBUG(
+                            Context,
+                            QString("Applied fragment replacement to open editor: %1")
+                                .arg(filePath));
                         return true;
                     }
                 } catch (...) {
@@ -813,7 +849,7 @@ bool FileEditManager::performFragmentReplacement(
     if (errorMsg && errorMsg->isEmpty()) {
         *errorMsg = isUndo ? "Successfully undone" : "Successfully applied";
     }
-    LOG_MESSAGE(QString("Applied fragment replacement to file: %1").arg(filePath));
+    LOG_DEBUG(Context, QString("Applied fragment replacement to file: %1").arg(filePath));
     return true;
 }
 
@@ -915,7 +951,9 @@ bool FileEditManager::undoAllEditsForRequest(const QString &requestId, QString *
         
         locker.unlock();
         
-        LOG_MESSAGE(QString("Undoing edit %1 using REVERSE fragment replacement (mass undo)").arg(editId));
+        LOG_DEBUG(
+            Context,
+            QString("Undoing edit %1 using REVERSE fragment replacement (mass undo)").arg(editId));
         
         QString errMsg;
         bool isAppend = oldContentCopy.isEmpty();
@@ -999,7 +1037,9 @@ bool FileEditManager::reapplyAllEditsForRequest(const QString &requestId, QStrin
         
         locker.unlock();
         
-        LOG_MESSAGE(QString("Reapplying edit %1 using fragment replacement (mass apply)").arg(editId));
+        LOG_DEBUG(
+            Context,
+            QString("Reapplying edit %1 using fragment replacement (mass apply)").arg(editId));
         
         QString errMsg;
         bool isAppend = oldContentCopy.isEmpty();
@@ -1078,7 +1118,7 @@ void FileEditManager::archiveAllNonArchivedEdits()
 
 QString FileEditManager::readFileContent(const QString &filePath) const
 {
-    LOG_MESSAGE(QString("Reading current file content: %1").arg(filePath));
+    LOG_DEBUG(Context, QString("Reading current file content: %1").arg(filePath));
     
     auto editors = Core::EditorManager::visibleEditors();
     for (auto *editor : editors) {
@@ -1258,47 +1298,12 @@ FileEditManager::DiffInfo FileEditManager::createDiffInfo(
     LOG_MESSAGE(QString("  Original lines: %1, Modified lines: %2")
                    .arg(originalLines.size()).arg(modifiedLines.size()));
     
-    int origLen = originalLines.size();
-    int modLen = modifiedLines.size();
-    
-    QVector<QVector<int>> lcs(origLen + 1, QVector<int>(modLen + 1, 0));
-    
-    for (int i = 1; i <= origLen; ++i) {
-        for (int j = 1; j <= modLen; ++j) {
-            if (originalLines[i - 1] == modifiedLines[j - 1]) {
-                lcs[i][j] = lcs[i - 1][j - 1] + 1;
-            } else {
-                lcs[i][j] = qMax(lcs[i - 1][j], lcs[i][j - 1]);
-            }
-        }
-    }
-    
-    LOG_MESSAGE(QString("  LCS computation complete. LCS length: %1").arg(lcs[origLen][modLen]));
+    const LineDiff::Alignment changes = LineDiff::align(originalLines, modifiedLines);
     
     QList<DiffHunk> hunks;
-    DiffHunk currentHunk;
-    bool inHunk = false;
-    
-    int i = origLen;
-    int j = modLen;
     int hunkCount = 0;
     
-    QList<QPair<int, int>> changes;
-    while (i > 0 || j > 0) {
-        if (i > 0 && j > 0 && originalLines[i - 1] == modifiedLines[j - 1]) {
-            changes.prepend({i - 1, j - 1});
-            i--;
-            j--;
-        } else if (j > 0 && (i == 0 || lcs[i][j - 1] >= lcs[i - 1][j])) {
-            changes.prepend({-1, j - 1});
-            j--;
-        } else if (i > 0) {
-            changes.prepend({i - 1, -1});
-            i--;
-        }
-    }
-    
-    LOG_MESSAGE(QString("  Backtracking complete. Total operations: %1").arg(changes.size()));
+    LOG_MESSAGE(QString("  Line alignment complete. Total operations: %1").arg(changes.size()));
     
     int idx = 0;
     while (idx < changes.size()) {
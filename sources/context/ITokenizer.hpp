@@ -0,0 +1,22 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#pragma once
+
+#include <QString>
+
+namespace QodeAssist::Context {
+
+class ITokenizer
+{
+public:
+    virtual ~ITokenizer() = default;
+
+    virtual QString name() const = 0;
+
+    // Must be safe to call from several threads at once.
+    virtual int countTokens(const QString &text) const = 0;
+};
+
+} // namespace QodeAssist::Context
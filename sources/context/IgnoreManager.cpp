@@ -10,15 +10,50 @@
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
-#include <QRegularExpression>
+#include <QMutexLocker>
+#include <QReadLocker>
 #include <QTextStream>
+#include <QWriteLocker>
+
+#include <atomic>
 
 #include "logger/Logger.hpp"
 
 namespace QodeAssist::Context {
 
+namespace {
+
+constexpr qsizetype kMaxCachedPaths = 50000;
+// Each open project has one live generation; superseded ones are only dropped in bulk.
+constexpr qsizetype kMaxCachedGenerations = 16;
+
+std::atomic<quint64> nextRulesGeneration{1};
+
+struct MatchCache
+{
+    QHash<QString, bool> paths;
+    QHash<QString, bool> directories;
+};
+
+// Results by rules generation, as queried on this thread. Worker threads of the tool pool keep
+// theirs between tool calls.
+MatchCache &threadMatchCache(quint64 generation)
+{
+    thread_local QHash<quint64, MatchCache> caches;
+    auto it = caches.find(generation);
+    if (it == caches.end()) {
+        if (caches.size() >= kMaxCachedGenerations)
+            caches.clear();
+        it = caches.insert(generation, {});
+    }
+    return it.value();
+}
+
+} // namespace
+
 IgnoreManager::IgnoreManager(QObject *parent)
     : QObject(parent)
+    , m_rules(std::make_shared<const RulesSnapshot>())
 {
     auto projectManager = ProjectExplorer::ProjectManager::instance();
     if (projectManager) {
@@ -43,15 +78,11 @@ IgnoreManager::~IgnoreManager()
 
 void IgnoreManager::cleanupConnections()
 {
-    QList<ProjectExplorer::Project *> projects = m_projectConnections.keys();
-    for (ProjectExplorer::Project *project : projects) {
-        if (project) {
-            disconnect(m_projectConnections.take(project));
-        }
-    }
+    QMutexLocker locker(&m_writeMutex);
+    for (const QMetaObject::Connection &connection : std::as_const(m_projectConnections))
+        disconnect(connection);
     m_projectConnections.clear();
-    m_projectIgnorePatterns.clear();
-    m_ignoreCache.clear();
+    setSnapshot(std::make_shared<const RulesSnapshot>());
 }
 
 bool IgnoreManager::shouldIgnore(const QString &filePath, ProjectExplorer::Project *project) const
@@ -59,88 +90,140 @@ bool IgnoreManager::shouldIgnore(const QString &filePath, ProjectExplorer::Proje
     if (!project)
         return false;
 
-    if (!m_projectIgnorePatterns.contains(project)) {
-        const_cast<IgnoreManager *>(this)->reloadIgnorePatterns(project);
+    const std::shared_ptr<const ProjectIgnoreRules> rules = rulesFor(project);
+    if (!rules || rules->matcher.isEmpty())
+        return false;
+
+    QString relativePath;
+    if (filePath.size() > rules->projectPath.size() && filePath.startsWith(rules->projectPath)
+        && filePath.at(rules->projectPath.size()) == '/') {
+        relativePath = filePath.mid(rules->projectPath.size() + 1);
+    } else {
+        relativePath = QDir(rules->projectPath).relativeFilePath(filePath);
     }
 
-    const QStringList &patterns = m_projectIgnorePatterns[project];
-    if (patterns.isEmpty())
-        return false;
+    return matchesIgnorePatterns(relativePath, *rules);
+}
 
-    QDir projectDir(project->projectDirectory().toUrlishString());
-    QString relativePath = projectDir.relativeFilePath(filePath);
+std::shared_ptr<const IgnoreManager::RulesSnapshot> IgnoreManager::snapshot() const
+{
+    QReadLocker locker(&m_rulesLock);
+    return m_rules;
+}
 
-    return matchesIgnorePatterns(relativePath, patterns);
+void IgnoreManager::setSnapshot(std::shared_ptr<const RulesSnapshot> snapshot)
+{
+    QWriteLocker locker(&m_rulesLock);
+    m_rules = std::move(snapshot);
 }
 
-bool IgnoreManager::matchesIgnorePatterns(const QString &path, const QStringList &patterns) const
+std::shared_ptr<const IgnoreManager::ProjectIgnoreRules> IgnoreManager::rulesFor(
+    ProjectExplorer::Project *project) const
 {
-    QString cacheKey = path + ":" + patterns.join("|");
-    if (m_ignoreCache.contains(cacheKey))
-        return m_ignoreCache[cacheKey];
+    if (auto rules = snapshot()->value(project))
+        return rules;
 
-    bool result = isPathExcluded(path, patterns);
-    m_ignoreCache.insert(cacheKey, result);
-    return result;
+    // First query for this project: compile outside the lock, keep whichever copy lands first.
+    return const_cast<IgnoreManager *>(this)->publishRules(project, compileRules(project), true);
 }
 
-bool IgnoreManager::isPathExcluded(const QString &path, const QStringList &patterns) const
+std::shared_ptr<const IgnoreManager::ProjectIgnoreRules> IgnoreManager::compileRules(
+    ProjectExplorer::Project *project) const
 {
-    bool excluded = false;
+    auto rules = std::make_shared<ProjectIgnoreRules>();
+    rules->generation = nextRulesGeneration.fetch_add(1);
+    rules->projectPath = project->projectDirectory().toUrlishString();
+    rules->matcher = IgnoreMatcher(loadIgnorePatterns(project));
+    return rules;
+}
 
-    for (const QString &pattern : patterns) {
-        if (pattern.isEmpty() || pattern.startsWith('#'))
-            continue;
+std::shared_ptr<const IgnoreManager::ProjectIgnoreRules> IgnoreManager::publishRules(
+    ProjectExplorer::Project *project,
+    std::shared_ptr<const ProjectIgnoreRules> rules,
+    bool keepExisting)
+{
+    QMutexLocker locker(&m_writeMutex);
 
-        bool isNegative = pattern.startsWith('!');
-        QString actualPattern = isNegative ? pattern.mid(1) : pattern;
+    const std::shared_ptr<const RulesSnapshot> current = snapshot();
+    if (keepExisting) {
+        if (auto existing = current->value(project))
+            return existing;
+    }
 
-        bool matches = matchPathWithPattern(path, actualPattern);
+    auto next = std::make_shared<RulesSnapshot>(*current);
+    next->insert(project, rules);
+    setSnapshot(std::move(next));
 
-        if (matches) {
-            excluded = !isNegative;
-        }
+    if (!m_projectConnections.contains(project)) {
+        // Only used as a key; the project is being destroyed when this runs.
+        auto connection = connect(project, &QObject::destroyed, this, [this, project]() {
+            unpublishRules(project);
+        });
+        m_projectConnections.insert(project, connection);
     }
 
-    return excluded;
+    return rules;
 }
 
-bool IgnoreManager::matchPathWithPattern(const QString &path, const QString &pattern) const
+void IgnoreManager::unpublishRules(ProjectExplorer::Project *project)
 {
-    QString adjustedPattern = pattern.trimmed();
-
-    bool matchFromRoot = adjustedPattern.startsWith('/');
-    if (matchFromRoot)
-        adjustedPattern = adjustedPattern.mid(1);
+    QMutexLocker locker(&m_writeMutex);
 
-    bool matchDirOnly = adjustedPattern.endsWith('/');
-    if (matchDirOnly)
-        adjustedPattern.chop(1);
+    if (m_projectConnections.contains(project))
+        disconnect(m_projectConnections.take(project));
 
-    QString regexPattern = QRegularExpression::escape(adjustedPattern);
-
-    regexPattern.replace("\\*\\*", ".*");
+    const std::shared_ptr<const RulesSnapshot> current = snapshot();
+    if (!current->contains(project))
+        return;
 
-    regexPattern.replace("\\*", "[^/]*");
+    auto next = std::make_shared<RulesSnapshot>(*current);
+    next->remove(project);
+    setSnapshot(std::move(next));
+}
 
-    regexPattern.replace("\\?", ".");
+bool IgnoreManager::matchesIgnorePatterns(
+    const QString &path, const ProjectIgnoreRules &rules) const
+{
+    MatchCache &cache = threadMatchCache(rules.generation);
+    const auto cached = cache.paths.constFind(path);
+    if (cached != cache.paths.constEnd())
+        return cached.value();
+
+    const bool result = isPathExcluded(path, rules);
+    if (cache.paths.size() >= kMaxCachedPaths)
+        cache.paths.clear();
+    cache.paths.insert(path, result);
+    return result;
+}
 
-    if (matchFromRoot)
-        regexPattern = QString("^%1").arg(regexPattern);
-    else
-        regexPattern = QString("(^|/)%1").arg(regexPattern);
+bool IgnoreManager::isPathExcluded(const QString &path, const ProjectIgnoreRules &rules) const
+{
+    if (rules.matcher.canPruneDirectories()) {
+        for (qsizetype slash = path.indexOf('/'); slash > 0; slash = path.indexOf('/', slash + 1)) {
+            if (isDirectoryExcluded(path.left(slash), rules))
+                return true;
+        }
+    }
 
-    if (matchDirOnly)
-        regexPattern = QString("%1$").arg(regexPattern);
-    else
-        regexPattern = QString("%1($|/)").arg(regexPattern);
+    return rules.matcher.matches(path);
+}
 
-    QRegularExpression regex(regexPattern);
-    QRegularExpressionMatch match = regex.match(path);
-    return match.hasMatch();
+bool IgnoreManager::isDirectoryExcluded(
+    const QString &directory, const ProjectIgnoreRules &rules) const
+{
+    MatchCache &cache = threadMatchCache(rules.generation);
+    const auto cached = cache.directories.constFind(directory);
+    if (cached != cache.directories.constEnd())
+        return cached.value();
+
+    const bool result = rules.matcher.excludesDirectory(directory);
+    if (cache.directories.size() >= kMaxCachedPaths)
+        cache.directories.clear();
+    cache.directories.insert(directory, result);
+    return result;
 }
 
-QStringList IgnoreManager::loadIgnorePatterns(ProjectExplorer::Project *project)
+QStringList IgnoreManager::loadIgnorePatterns(ProjectExplorer::Project *project) const
 {
     QStringList patterns;
     if (!project)
@@ -178,73 +261,27 @@ void IgnoreManager::reloadIgnorePatterns(ProjectExplorer::Project *project)
     if (!project)
         return;
 
-    QStringList patterns = loadIgnorePatterns(project);
-    m_projectIgnorePatterns[project] = patterns;
-
-    QStringList keysToRemove;
-    QString projectPath = project->projectDirectory().toUrlishString();
-    for (auto it = m_ignoreCache.begin(); it != m_ignoreCache.end(); ++it) {
-        if (it.key().contains(projectPath))
-            keysToRemove << it.key();
-    }
-
-    for (const QString &key : keysToRemove)
-        m_ignoreCache.remove(key);
-
-    if (!m_projectConnections.contains(project)) {
-        QPointer<ProjectExplorer::Project> projectPtr(project);
-        auto connection = connect(project, &QObject::destroyed, this, [this, projectPtr]() {
-            if (projectPtr) {
-                m_projectIgnorePatterns.remove(projectPtr);
-                m_projectConnections.remove(projectPtr);
-
-                QStringList keysToRemove;
-                for (auto it = m_ignoreCache.begin(); it != m_ignoreCache.end(); ++it) {
-                    if (it.key().contains(projectPtr->projectDirectory().toUrlishString()))
-                        keysToRemove << it.key();
-                }
-
-                for (const QString &key : keysToRemove)
-                    m_ignoreCache.remove(key);
-            }
-        });
-
-        m_projectConnections[project] = connection;
-    }
+    publishRules(project, compileRules(project), false);
+    emit rulesChanged();
 }
 
 void IgnoreManager::removeIgnorePatterns(ProjectExplorer::Project *project)
 {
-    m_projectIgnorePatterns.remove(project);
-
-    QStringList keysToRemove;
-    for (auto it = m_ignoreCache.begin(); it != m_ignoreCache.end(); ++it) {
-        if (it.key().contains(project->projectDirectory().toUrlishString()))
-            keysToRemove << it.key();
-    }
-
-    for (const QString &key : keysToRemove)
-        m_ignoreCache.remove(key);
-
-    if (m_projectConnections.contains(project)) {
-        disconnect(m_projectConnections[project]);
-        m_projectConnections.remove(project);
-    }
+    unpublishRules(project);
+    emit rulesChanged();
 
     LOG_MESSAGE(QString("Removed ignore patterns for project: %1").arg(project->displayName()));
 }
 
 void IgnoreManager::reloadAllPatterns()
 {
-    QList<ProjectExplorer::Project *> projects = m_projectIgnorePatterns.keys();
+    const QList<ProjectExplorer::Project *> projects = snapshot()->keys();
 
     for (ProjectExplorer::Project *project : projects) {
         if (project) {
             reloadIgnorePatterns(project);
         }
     }
-
-    m_ignoreCache.clear();
 }
 
 QString IgnoreManager::ignoreFilePath(ProjectExplorer::Project *project) const
@@ -5,16 +5,30 @@
 #pragma once
 
 #include <QHash>
+#include <QMutex>
 #include <QObject>
-#include <QPointer>
+#include <QReadWriteLock>
 #include <QStringList>
 
+#include <memory>
+
+#include "IgnoreMatcher.hpp"
+
 namespace ProjectExplorer {
 class Project;
 }
 
 namespace QodeAssist::Context {
 
+/**
+ * @brief Answers whether a file is excluded by its project's .qodeassistignore.
+ *
+ * shouldIgnore() may be called from any thread, e.g. from tools running in QtConcurrent. The
+ * compiled rules of all projects form an immutable snapshot; readers only hold m_rulesLock to
+ * copy the pointer to it, and reloads build a new snapshot under m_writeMutex and swap it in.
+ * Match results are cached per thread and per rules generation, so a reload invalidates them and
+ * queries alternating between projects keep the results of each.
+ */
 class IgnoreManager : public QObject
 {
     Q_OBJECT
@@ -29,18 +43,44 @@ public:
 
     void reloadAllPatterns();
 
+signals:
+    // Rules of a project were reloaded or dropped; results of earlier queries may differ now.
+    void rulesChanged();
+
 private slots:
     void cleanupConnections();
 
 private:
-    bool matchesIgnorePatterns(const QString &path, const QStringList &patterns) const;
-    bool isPathExcluded(const QString &path, const QStringList &patterns) const;
-    bool matchPathWithPattern(const QString &path, const QString &pattern) const;
-    QStringList loadIgnorePatterns(ProjectExplorer::Project *project);
+    struct ProjectIgnoreRules
+    {
+        quint64 generation = 0;
+        QString projectPath;
+        IgnoreMatcher matcher;
+    };
+
+    using RulesSnapshot
+        = QHash<ProjectExplorer::Project *, std::shared_ptr<const ProjectIgnoreRules>>;
+
+    std::shared_ptr<const RulesSnapshot> snapshot() const;
+    void setSnapshot(std::shared_ptr<const RulesSnapshot> snapshot);
+    std::shared_ptr<const ProjectIgnoreRules> rulesFor(ProjectExplorer::Project *project) const;
+    std::shared_ptr<const ProjectIgnoreRules> compileRules(ProjectExplorer::Project *project) const;
+    std::shared_ptr<const ProjectIgnoreRules> publishRules(
+        ProjectExplorer::Project *project,
+        std::shared_ptr<const ProjectIgnoreRules> rules,
+        bool keepExisting);
+    void unpublishRules(ProjectExplorer::Project *project);
+
+    bool matchesIgnorePatterns(const QString &path, const ProjectIgnoreRules &rules) const;
+    bool isPathExcluded(const QString &path, const ProjectIgnoreRules &rules) const;
+    bool isDirectoryExcluded(const QString &directory, const ProjectIgnoreRules &rules) const;
+    QStringList loadIgnorePatterns(ProjectExplorer::Project *project) const;
     QString ignoreFilePath(ProjectExplorer::Project *project) const;
 
-    QHash<ProjectExplorer::Project *, QStringList> m_projectIgnorePatterns;
-    mutable QHash<QString, bool> m_ignoreCache;
+    // Replaced only while holding m_writeMutex.
+    std::shared_ptr<const RulesSnapshot> m_rules;
+    mutable QReadWriteLock m_rulesLock;
+    QMutex m_writeMutex;
     QHash<ProjectExplorer::Project *, QMetaObject::Connection> m_projectConnections;
 };
 
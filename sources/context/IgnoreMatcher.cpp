@@ -0,0 +1,119 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#include "IgnoreMatcher.hpp"
+
+namespace QodeAssist::Context {
+
+namespace {
+
+QRegularExpression compileAlternation(const QStringList &alternatives)
+{
+    QRegularExpression regex(QString("(?:%1)").arg(alternatives.join(")|(?:")));
+    regex.optimize();
+    return regex;
+}
+
+} // namespace
+
+IgnoreMatcher::IgnoreMatcher(const QStringList &patterns)
+{
+    QStringList groupAlternatives;
+    QStringList directoryAlternatives;
+    bool groupNegative = false;
+    bool hasNegative = false;
+
+    const auto flushGroup = [&] {
+        if (groupAlternatives.isEmpty())
+            return;
+        m_groups.append({compileAlternation(groupAlternatives), groupNegative});
+        groupAlternatives.clear();
+    };
+
+    for (const QString &pattern : patterns) {
+        if (pattern.isEmpty() || pattern.startsWith('#'))
+            continue;
+
+        const bool negative = pattern.startsWith('!');
+        const QString actualPattern = negative ? pattern.mid(1) : pattern;
+
+        bool directoryOnly = false;
+        const QString regex = patternToRegex(actualPattern, &directoryOnly);
+
+        if (negative != groupNegative)
+            flushGroup();
+        groupNegative = negative;
+        groupAlternatives.append(regex);
+
+        hasNegative = hasNegative || negative;
+        if (!negative && !directoryOnly)
+            directoryAlternatives.append(regex);
+    }
+    flushGroup();
+
+    m_canPruneDirectories = !hasNegative && !directoryAlternatives.isEmpty();
+    if (m_canPruneDirectories)
+        m_directoryRegex = compileAlternation(directoryAlternatives);
+}
+
+bool IgnoreMatcher::isEmpty() const
+{
+    return m_groups.isEmpty();
+}
+
+bool IgnoreMatcher::matches(const QString &relativePath) const
+{
+    for (auto group = m_groups.crbegin(); group != m_groups.crend(); ++group) {
+        if (group->regex.match(relativePath).hasMatch())
+            return !group->negative;
+    }
+    return false;
+}
+
+bool IgnoreMatcher::canPruneDirectories() const
+{
+    return m_canPruneDirectories;
+}
+
+bool IgnoreMatcher::excludesDirectory(const QString &relativeDirectory) const
+{
+    // A non directory-only pattern matching "dir" also matches "dir/anything", and without
+    // negated patterns nothing below can be re-included.
+    return m_canPruneDirectories && m_directoryRegex.match(relativeDirectory).hasMatch();
+}
+
+QString IgnoreMatcher::patternToRegex(const QString &pattern, bool *directoryOnly)
+{
+    QString adjustedPattern = pattern.trimmed();
+
+    const bool matchFromRoot = adjustedPattern.startsWith('/');
+    if (matchFromRoot)
+        adjustedPattern = adjustedPattern.mid(1);
+
+    const bool matchDirOnly = adjustedPattern.endsWith('/');
+    if (matchDirOnly)
+        adjustedPattern.chop(1);
+
+    if (directoryOnly)
+        *directoryOnly = matchDirOnly;
+
+    QString regexPattern = QRegularExpression::escape(adjustedPattern);
+    regexPattern.replace("\\*\\*", ".*");
+    regexPattern.replace("\\*", "[^/]*");
+    regexPattern.replace("\\?", ".");
+
+    if (matchFromRoot)
+        regexPattern = QString("^%1").arg(regexPattern);
+    else
+        regexPattern = QString("(^|/)%1").arg(regexPattern);
+
+    if (matchDirOnly)
+        regexPattern = QString("%1$").arg(regexPattern);
+    else
+        regexPattern = QString("%1($|/)").arg(regexPattern);
+
+    return regexPattern;
+}
+
+} // namespace QodeAssist::Context
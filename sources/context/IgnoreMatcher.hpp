@@ -0,0 +1,53 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#pragma once
+
+#include <QList>
+#include <QRegularExpression>
+#include <QStringList>
+
+namespace QodeAssist::Context {
+
+/**
+ * @brief .qodeassistignore patterns compiled once into a few combined regular expressions.
+ *
+ * Consecutive patterns of the same polarity share one alternation, so a typical ignore file
+ * without "!" rules becomes a single regex. Rules are checked from the last group backwards and
+ * the first group that matches decides, which keeps the "last matching pattern wins" semantics
+ * of matching the patterns one by one.
+ *
+ * When there are no negated patterns, a directory matched by a non directory-only pattern is
+ * ignored together with everything below it; excludesDirectory() lets callers stop there
+ * instead of matching every file in it.
+ */
+class IgnoreMatcher
+{
+public:
+    IgnoreMatcher() = default;
+    explicit IgnoreMatcher(const QStringList &patterns);
+
+    bool isEmpty() const;
+
+    // relativePath uses '/' separators and is relative to the project directory.
+    bool matches(const QString &relativePath) const;
+
+    bool canPruneDirectories() const;
+    bool excludesDirectory(const QString &relativeDirectory) const;
+
+    static QString patternToRegex(const QString &pattern, bool *directoryOnly = nullptr);
+
+private:
+    struct RuleGroup
+    {
+        QRegularExpression regex;
+        bool negative = false;
+    };
+
+    QList<RuleGroup> m_groups;
+    QRegularExpression m_directoryRegex;
+    bool m_canPruneDirectories = false;
+};
+
+} // namespace QodeAssist::Context
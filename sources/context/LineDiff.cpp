@@ -0,0 +1,318 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#include "LineDiff.hpp"
+
+#include <QHash>
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace QodeAssist::Context {
+
+namespace {
+
+constexpr int kMinCost = 256;
+
+class LineAligner
+{
+public:
+    LineAligner(std::vector<int> original, std::vector<int> modified)
+        : m_a(std::move(original))
+        , m_b(std::move(modified))
+        , m_matchA(m_a.size(), -1)
+        , m_matchB(m_b.size(), -1)
+    {}
+
+    void run() { compare(0, int(m_a.size()), 0, int(m_b.size())); }
+
+    const std::vector<int> &matchA() const { return m_matchA; }
+    const std::vector<int> &matchB() const { return m_matchB; }
+
+private:
+    void match(int i, int j)
+    {
+        m_matchA[size_t(i)] = j;
+        m_matchB[size_t(j)] = i;
+    }
+
+    void compare(int aLo, int aHi, int bLo, int bHi)
+    {
+        while (aLo < aHi && bLo < bHi && m_a[size_t(aLo)] == m_b[size_t(bLo)])
+            match(aLo++, bLo++);
+        while (aLo < aHi && bLo < bHi && m_a[size_t(aHi - 1)] == m_b[size_t(bHi - 1)])
+            match(--aHi, --bHi);
+
+        if (aLo == aHi || bLo == bHi)
+            return;
+
+        if (patience(aLo, aHi, bLo, bHi) == Anchoring::NoUniqueLines)
+            bisect(aLo, aHi, bLo, bHi);
+    }
+
+    enum class Anchoring { Anchored, NoUniqueLines, NoCommonLines };
+
+    // Anchors on lines that occur exactly once in both ranges, taking the longest run of them
+    // that appears in the same order on both sides.
+    Anchoring patience(int aLo, int aHi, int bLo, int bHi)
+    {
+        struct Occurrence
+        {
+            int countA = 0;
+            int countB = 0;
+            int positionB = -1;
+        };
+
+        std::unordered_map<int, Occurrence> occurrences;
+        occurrences.reserve(size_t(aHi - aLo));
+        for (int i = aLo; i < aHi; ++i)
+            ++occurrences[m_a[size_t(i)]].countA;
+        bool hasCommonLines = false;
+        for (int j = bLo; j < bHi; ++j) {
+            const auto it = occurrences.find(m_b[size_t(j)]);
+            if (it == occurrences.end())
+                continue;
+            ++it->second.countB;
+            it->second.positionB = j;
+            hasCommonLines = true;
+        }
+        // A full rewrite: nothing to align, and bisect() would take O(N * D) to find that out.
+        if (!hasCommonLines)
+            return Anchoring::NoCommonLines;
+
+        // {position in A, position in B}, in A order.
+        std::vector<std::pair<int, int>> unique;
+        for (int i = aLo; i < aHi; ++i) {
+            const Occurrence &occurrence = occurrences[m_a[size_t(i)]];
+            if (occurrence.countA == 1 && occurrence.countB == 1)
+                unique.emplace_back(i, occurrence.positionB);
+        }
+        if (unique.empty())
+            return Anchoring::NoUniqueLines;
+
+        // Longest increasing subsequence of B positions by patience sorting.
+        std::vector<int> tails;
+        std::vector<int> previous(unique.size(), -1);
+        for (int k = 0; k < int(unique.size()); ++k) {
+            const auto pile = std::lower_bound(
+                tails.begin(), tails.end(), unique[size_t(k)].second, [&unique](int tail, int b) {
+                    return unique[size_t(tail)].second < b;
+                });
+            if (pile != tails.begin())
+                previous[size_t(k)] = *(pile - 1);
+            if (pile == tails.end())
+                tails.push_back(k);
+            else
+                *pile = k;
+        }
+
+        std::vector<int> chain;
+        for (int k = tails.back(); k >= 0; k = previous[size_t(k)])
+            chain.push_back(k);
+        std::reverse(chain.begin(), chain.end());
+
+        int nextA = aLo;
+        int nextB = bLo;
+        for (const int k : chain) {
+            const auto [i, j] = unique[size_t(k)];
+            compare(nextA, i, nextB, j);
+            match(i, j);
+            nextA = i + 1;
+            nextB = j + 1;
+        }
+        compare(nextA, aHi, nextB, bHi);
+        return Anchoring::Anchored;
+    }
+
+    // Myers' middle snake: walks the shortest edit script from both ends at once and splits the
+    // ranges where the two walks meet.
+    void bisect(int aLo, int aHi, int bLo, int bHi)
+    {
+        const int n = aHi - aLo;
+        const int m = bHi - bLo;
+        const int maxD = (n + m + 1) / 2;
+        const int offset = maxD;
+        const int length = 2 * maxD + 2;
+        const int delta = n - m;
+        const bool front = (delta % 2) != 0;
+
+        m_forward.assign(size_t(length), -1);
+        m_backward.assign(size_t(length), -1);
+        m_forward[size_t(offset + 1)] = 0;
+        m_backward[size_t(offset + 1)] = 0;
+
+        int k1Start = 0;
+        int k1End = 0;
+        int k2Start = 0;
+        int k2End = 0;
+
+        // Like xdiff, give up on the shortest script once it gets expensive and split at the
+        // furthest point either walk reached; the result stays a valid, near-minimal diff.
+        const int maxCost = std::max(kMinCost, int(std::sqrt(double(n + m))));
+
+        for (int d = 0; d < maxD; ++d) {
+            if (d >= maxCost) {
+                splitAtFurthest(aLo, aHi, bLo, bHi, offset);
+                return;
+            }
+
+            for (int k1 = -d + k1Start; k1 <= d - k1End; k1 += 2) {
+                const int k1Offset = offset + k1;
+                int x1 = (k1 == -d
+                          || (k1 != d
+                              && m_forward[size_t(k1Offset - 1)] < m_forward[size_t(k1Offset + 1)]))
+                             ? m_forward[size_t(k1Offset + 1)]
+                             : m_forward[size_t(k1Offset - 1)] + 1;
+                int y1 = x1 - k1;
+                while (x1 < n && y1 < m && m_a[size_t(aLo + x1)] == m_b[size_t(bLo + y1)]) {
+                    ++x1;
+                    ++y1;
+                }
+                m_forward[size_t(k1Offset)] = x1;
+
+                if (x1 > n) {
+                    k1End += 2;
+                } else if (y1 > m) {
+                    k1Start += 2;
+                } else if (front) {
+                    const int k2Offset = offset + delta - k1;
+                    if (k2Offset >= 0 && k2Offset < length && m_backward[size_t(k2Offset)] != -1
+                        && x1 >= n - m_backward[size_t(k2Offset)]) {
+                        split(aLo, aHi, bLo, bHi, x1, y1);
+                        return;
+                    }
+                }
+            }
+
+            for (int k2 = -d + k2Start; k2 <= d - k2End; k2 += 2) {
+                const int k2Offset = offset + k2;
+                int x2 = (k2 == -d
+                          || (k2 != d
+                              && m_backward[size_t(k2Offset - 1)]
+                                     < m_backward[size_t(k2Offset + 1)]))
+                             ? m_backward[size_t(k2Offset + 1)]
+                             : m_backward[size_t(k2Offset - 1)] + 1;
+                int y2 = x2 - k2;
+                while (x2 < n && y2 < m
+                       && m_a[size_t(aHi - x2 - 1)] == m_b[size_t(bHi - y2 - 1)]) {
+                    ++x2;
+                    ++y2;
+                }
+                m_backward[size_t(k2Offset)] = x2;
+
+                if (x2 > n) {
+                    k2End += 2;
+                } else if (y2 > m) {
+                    k2Start += 2;
+                } else if (!front) {
+                    const int k1Offset = offset + delta - k2;
+                    if (k1Offset >= 0 && k1Offset < length && m_forward[size_t(k1Offset)] != -1) {
+                        const int x1 = m_forward[size_t(k1Offset)];
+                        const int y1 = offset + x1 - k1Offset;
+                        if (x1 >= n - x2) {
+                            split(aLo, aHi, bLo, bHi, x1, y1);
+                            return;
+                        }
+                    }
+                }
+            }
+        }
+        // No line in common: everything in the ranges is removed and added.
+    }
+
+    // Every diagonal either walk has touched holds a point on some edit path.
+    void splitAtFurthest(int aLo, int aHi, int bLo, int bHi, int offset)
+    {
+        const int n = aHi - aLo;
+        const int m = bHi - bLo;
+
+        int bestProgress = -1;
+        int bestX = 0;
+        int bestY = 0;
+        for (int index = 0; index < int(m_forward.size()); ++index) {
+            const int x = m_forward[size_t(index)];
+            const int y = x - (index - offset);
+            if (x >= 0 && x <= n && y >= 0 && y <= m && x + y > bestProgress) {
+                bestProgress = x + y;
+                bestX = x;
+                bestY = y;
+            }
+        }
+        for (int index = 0; index < int(m_backward.size()); ++index) {
+            const int x = m_backward[size_t(index)];
+            const int y = x - (index - offset);
+            if (x >= 0 && x <= n && y >= 0 && y <= m && x + y > bestProgress) {
+                bestProgress = x + y;
+                bestX = n - x;
+                bestY = m - y;
+            }
+        }
+
+        if (bestProgress >= 0)
+            split(aLo, aHi, bLo, bHi, bestX, bestY);
+    }
+
+    void split(int aLo, int aHi, int bLo, int bHi, int x, int y)
+    {
+        // Cannot happen once common ends are trimmed, but would otherwise recurse forever.
+        if ((x == 0 && y == 0) || (x == aHi - aLo && y == bHi - bLo))
+            return;
+        compare(aLo, aLo + x, bLo, bLo + y);
+        compare(aLo + x, aHi, bLo + y, bHi);
+    }
+
+    const std::vector<int> m_a;
+    const std::vector<int> m_b;
+    std::vector<int> m_matchA;
+    std::vector<int> m_matchB;
+    // Scratch diagonals for bisect(); only live until the split point is found.
+    std::vector<int> m_forward;
+    std::vector<int> m_backward;
+};
+
+} // namespace
+
+LineDiff::Alignment LineDiff::align(const QStringList &original, const QStringList &modified)
+{
+    QHash<QString, int> lineIds;
+    lineIds.reserve(original.size() + modified.size());
+    const auto intern = [&lineIds](const QStringList &lines) {
+        std::vector<int> ids;
+        ids.reserve(size_t(lines.size()));
+        for (const QString &line : lines) {
+            auto it = lineIds.constFind(line);
+            if (it == lineIds.constEnd())
+                it = lineIds.insert(line, int(lineIds.size()));
+            ids.push_back(it.value());
+        }
+        return ids;
+    };
+
+    std::vector<int> originalIds = intern(original);
+    std::vector<int> modifiedIds = intern(modified);
+
+    LineAligner aligner(std::move(originalIds), std::move(modifiedIds));
+    aligner.run();
+
+    Alignment alignment;
+    alignment.reserve(qMax(original.size(), modified.size()));
+    const int originalSize = int(original.size());
+    const int modifiedSize = int(modified.size());
+    int i = 0;
+    int j = 0;
+    while (i < originalSize || j < modifiedSize) {
+        if (i < originalSize && aligner.matchA()[size_t(i)] < 0)
+            alignment.append({i++, -1});
+        else if (j < modifiedSize && aligner.matchB()[size_t(j)] < 0)
+            alignment.append({-1, j++});
+        else
+            alignment.append({i++, j++});
+    }
+    return alignment;
+}
+
+} // namespace QodeAssist::Context
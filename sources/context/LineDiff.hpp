@@ -0,0 +1,33 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#pragma once
+
+#include <QList>
+#include <QPair>
+#include <QStringList>
+
+namespace QodeAssist::Context {
+
+/**
+ * @brief Line-level diff in linear space.
+ *
+ * Lines are interned to integer ids, then aligned with the patience heuristic: lines that occur
+ * exactly once on both sides anchor the alignment and the gaps between anchors are diffed
+ * recursively. Gaps without such lines fall back to Myers' O(ND) algorithm using the
+ * middle-snake split, so memory stays proportional to the number of lines. As in xdiff, the
+ * search for a minimal script is cut short on very dissimilar inputs.
+ */
+class LineDiff
+{
+public:
+    // One entry per line in order: {originalIndex, modifiedIndex} for an unchanged line,
+    // {originalIndex, -1} for a removed one and {-1, modifiedIndex} for an added one. Within a
+    // changed block removals come before additions.
+    using Alignment = QList<QPair<int, int>>;
+
+    static Alignment align(const QStringList &original, const QStringList &modified);
+};
+
+} // namespace QodeAssist::Context
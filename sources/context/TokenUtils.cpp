@@ -3,6 +3,7 @@
 // Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
 
 #include "TokenUtils.hpp"
+#include "TokenizerRegistry.hpp"
 
 #include <QFileInfo>
 #include <QImageReader>
@@ -14,13 +15,20 @@
 
 namespace QodeAssist::Context {
 
-int TokenUtils::estimateTokens(const QString &text)
+int TokenUtils::estimateTokens(const QString &text, const QString &modelName)
 {
     if (text.isEmpty()) {
         return 0;
     }
 
-    // TODO: need to improve
+    if (const auto tokenizer = TokenizerRegistry::instance().tokenizerForModel(modelName))
+        return tokenizer->countTokens(text);
+
+    return heuristicTokens(text);
+}
+
+int TokenUtils::heuristicTokens(const QString &text)
+{
     return text.length() / 4;
 }
 
@@ -61,25 +69,26 @@ int TokenUtils::estimateImageAttachmentTokens(const QString &filePath)
     return 85 + tiles * 170;
 }
 
-int TokenUtils::estimateFileTokens(const Context::ContentFile &file)
+int TokenUtils::estimateFileTokens(const Context::ContentFile &file, const QString &modelName)
 {
     if (isImageFilePath(file.filename))
         return estimateImageAttachmentTokens(QString());
 
     int total = 0;
 
-    total += estimateTokens(file.filename);
-    total += estimateTokens(file.content);
+    total += estimateTokens(file.filename, modelName);
+    total += estimateTokens(file.content, modelName);
     total += 5;
 
     return total;
 }
 
-int TokenUtils::estimateFilesTokens(const QList<Context::ContentFile> &files)
+int TokenUtils::estimateFilesTokens(
+    const QList<Context::ContentFile> &files, const QString &modelName)
 {
     int total = 0;
     for (const auto &file : files) {
-        total += estimateFileTokens(file);
+        total += estimateFileTokens(file, modelName);
     }
     return total;
 }
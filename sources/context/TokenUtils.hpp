@@ -13,9 +13,13 @@ namespace QodeAssist::Context {
 class TokenUtils
 {
 public:
-    static int estimateTokens(const QString &text);
-    static int estimateFileTokens(const Context::ContentFile &file);
-    static int estimateFilesTokens(const QList<Context::ContentFile> &files);
+    // Counts with the tokenizer of the model's family from TokenizerRegistry, or the "default"
+    // family when no model is given. Falls back to heuristicTokens() when no vocabulary is found.
+    static int estimateTokens(const QString &text, const QString &modelName = {});
+    static int heuristicTokens(const QString &text);
+    static int estimateFileTokens(const Context::ContentFile &file, const QString &modelName = {});
+    static int estimateFilesTokens(
+        const QList<Context::ContentFile> &files, const QString &modelName = {});
     static bool isImageFilePath(const QString &filePath);
     static int estimateImageAttachmentTokens(const QString &filePath);
 };
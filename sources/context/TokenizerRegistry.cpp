@@ -0,0 +1,198 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#include "TokenizerRegistry.hpp"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QMutexLocker>
+
+#include "BpeTokenizer.hpp"
+#include "logger/Logger.hpp"
+
+namespace QodeAssist::Context {
+
+namespace {
+
+constexpr char kDefaultFamily[] = "default";
+
+struct FamilyRule
+{
+    const char *needle;
+    const char *family;
+};
+
+// Checked in order, so more specific names come first.
+constexpr FamilyRule kFamilyRules[] = {
+    {"gpt-4o", "o200k_base"},
+    {"gpt-4.1", "o200k_base"},
+    {"gpt-5", "o200k_base"},
+    {"o1", "o200k_base"},
+    {"o3", "o200k_base"},
+    {"o4", "o200k_base"},
+    {"gpt-4", "cl100k_base"},
+    {"gpt-3.5", "cl100k_base"},
+    {"claude", "claude"},
+    {"codellama", "codellama"},
+    {"llama3", "llama3"},
+    {"llama-3", "llama3"},
+    {"llama", "llama"},
+    {"qwen", "qwen"},
+    {"deepseek", "deepseek"},
+    {"codestral", "mistral"},
+    {"devstral", "mistral"},
+    {"mistral", "mistral"},
+    {"mixtral", "mistral"},
+    {"starcoder", "starcoder2"},
+    {"gemma", "gemma"},
+    {"gemini", "gemma"},
+};
+
+} // namespace
+
+TokenizerRegistry &TokenizerRegistry::instance()
+{
+    static TokenizerRegistry registry;
+    return registry;
+}
+
+TokenizerRegistry::TokenizerRegistry()
+{
+    m_loader.setMaxThreadCount(1);
+}
+
+void TokenizerRegistry::setVocabularyDirectory(const QString &directory)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_directory == directory)
+        return;
+    m_directory = directory;
+    ++m_generation;
+    m_loaded.clear();
+    m_loading.clear();
+}
+
+QString TokenizerRegistry::vocabularyDirectory() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_directory;
+}
+
+void TokenizerRegistry::registerTokenizer(
+    const QString &family, std::shared_ptr<const ITokenizer> tokenizer)
+{
+    QMutexLocker locker(&m_mutex);
+    if (tokenizer)
+        m_registered.insert(family, std::move(tokenizer));
+    else
+        m_registered.remove(family);
+}
+
+QString TokenizerRegistry::familyForModel(const QString &modelName)
+{
+    const QString name = modelName.toLower();
+    if (name.isEmpty())
+        return kDefaultFamily;
+
+    for (const FamilyRule &rule : kFamilyRules) {
+        const QLatin1StringView needle(rule.needle);
+        // Short OpenAI reasoning names ("o1", "o3-mini") only count at the start of the name.
+        const bool matches = needle.size() <= 2 ? name.startsWith(needle) : name.contains(needle);
+        if (matches)
+            return QString::fromLatin1(rule.family);
+    }
+
+    return kDefaultFamily;
+}
+
+std::shared_ptr<const ITokenizer> TokenizerRegistry::tokenizerForModel(const QString &modelName)
+{
+    const QString family = familyForModel(modelName);
+    if (auto tokenizer = tokenizerForFamily(family))
+        return tokenizer;
+    if (family != QLatin1StringView(kDefaultFamily))
+        return tokenizerForFamily(kDefaultFamily);
+    return nullptr;
+}
+
+void TokenizerRegistry::preload(const QStringList &modelNames)
+{
+    QMutexLocker locker(&m_mutex);
+    startLoad(kDefaultFamily);
+    for (const QString &modelName : modelNames)
+        startLoad(familyForModel(modelName));
+}
+
+void TokenizerRegistry::waitForLoads()
+{
+    m_loader.waitForDone();
+}
+
+std::shared_ptr<const ITokenizer> TokenizerRegistry::tokenizerForFamily(const QString &family)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (auto registered = m_registered.value(family))
+        return registered;
+
+    const auto cached = m_loaded.constFind(family);
+    if (cached != m_loaded.constEnd())
+        return cached.value();
+
+    // Parsing a vocabulary takes long enough to stall typing; count heuristically meanwhile.
+    startLoad(family);
+    return nullptr;
+}
+
+void TokenizerRegistry::startLoad(const QString &family)
+{
+    if (m_directory.isEmpty() || m_loaded.contains(family) || m_loading.contains(family))
+        return;
+
+    m_loading.insert(family);
+    m_loader.start([this, family, directory = m_directory, generation = m_generation] {
+        auto tokenizer = loadFamily(directory, family);
+
+        QMutexLocker locker(&m_mutex);
+        if (generation != m_generation)
+            return;
+        m_loaded.insert(family, std::move(tokenizer));
+        m_loading.remove(family);
+    });
+}
+
+std::shared_ptr<const ITokenizer> TokenizerRegistry::loadFamily(
+    const QString &directory, const QString &family)
+{
+    const QDir dir(directory);
+    QString error;
+
+    const QString tiktokenPath = dir.filePath(family + ".tiktoken");
+    if (QFileInfo::exists(tiktokenPath)) {
+        if (auto tokenizer = BpeTokenizer::fromTiktokenFile(tiktokenPath, &error)) {
+            LOG_MESSAGE(QString("Loaded tokenizer %1 (%2 tokens)")
+                            .arg(tiktokenPath)
+                            .arg(tokenizer->vocabularySize()));
+            return tokenizer;
+        }
+        LOG_MESSAGE(error);
+    }
+
+    for (const QString &jsonPath :
+         {dir.filePath(family + ".json"), dir.filePath(family + "/tokenizer.json")}) {
+        if (!QFileInfo::exists(jsonPath))
+            continue;
+        if (auto tokenizer = BpeTokenizer::fromHuggingFaceFile(jsonPath, &error)) {
+            LOG_MESSAGE(QString("Loaded tokenizer %1 (%2 tokens)")
+                            .arg(jsonPath)
+                            .arg(tokenizer->vocabularySize()));
+            return tokenizer;
+        }
+        LOG_MESSAGE(error);
+    }
+
+    return nullptr;
+}
+
+} // namespace QodeAssist::Context
@@ -0,0 +1,73 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+
+#include <memory>
+
+#include "ITokenizer.hpp"
+
+namespace QodeAssist::Context {
+
+/**
+ * @brief Resolves a model name to a tokenizer loaded from the local vocabulary directory.
+ *
+ * Model names are mapped to a family ("cl100k_base", "o200k_base", "llama3", "qwen", ...) and the
+ * directory is searched for "<family>.tiktoken", "<family>.json" or "<family>/tokenizer.json".
+ * Families without a file fall back to "default", and if that is missing too callers get nullptr
+ * and use the character heuristic. Loaded tokenizers, and misses, are kept until the directory
+ * changes.
+ *
+ * Vocabularies are read and parsed on a worker thread, never by the caller: a family that is not
+ * loaded yet gets nullptr, and the character heuristic, until its load has finished. preload()
+ * starts the loads for the configured models ahead of their first use.
+ */
+class TokenizerRegistry
+{
+public:
+    static TokenizerRegistry &instance();
+
+    void setVocabularyDirectory(const QString &directory);
+    QString vocabularyDirectory() const;
+
+    // Registers a tokenizer for a family, bypassing the directory lookup.
+    void registerTokenizer(const QString &family, std::shared_ptr<const ITokenizer> tokenizer);
+
+    std::shared_ptr<const ITokenizer> tokenizerForModel(const QString &modelName);
+
+    // Starts loading the tokenizers of these models, and the default one, in the background.
+    void preload(const QStringList &modelNames);
+    // Blocks until every load started so far has finished.
+    void waitForLoads();
+
+    static QString familyForModel(const QString &modelName);
+
+private:
+    TokenizerRegistry();
+
+    std::shared_ptr<const ITokenizer> tokenizerForFamily(const QString &family);
+    // Requires m_mutex.
+    void startLoad(const QString &family);
+    static std::shared_ptr<const ITokenizer> loadFamily(
+        const QString &directory, const QString &family);
+
+    mutable QMutex m_mutex;
+    QString m_directory;
+    // Bumped when the directory changes, so loads of the previous one are dropped.
+    quint64 m_generation = 0;
+    QHash<QString, std::shared_ptr<const ITokenizer>> m_loaded;
+    QSet<QString> m_loading;
+    QHash<QString, std::shared_ptr<const ITokenizer>> m_registered;
+    // Declared last, so it waits for running loads before the rest is destroyed.
+    QThreadPool m_loader;
+};
+
+} // namespace QodeAssist::Context
@@ -8,6 +8,28 @@
 
 namespace QodeAssist {
 
+// Phases are only recorded when measured, so a request may have any subset of them.
+enum class RequestPhase {
+    Context,     // reading the document and building the prompt context
+    Enrichment,  // semantic context from the code model
+    Payload,     // building and sending the request
+    FirstByte,   // from sending to the first streamed chunk
+    Stream,      // from the first chunk to the complete response
+    PostProcess, // CodeHandler and other clean-up of the response
+};
+
+enum class RequestOutcome {
+    Completed,
+    Failed,
+};
+
+struct RequestLabels
+{
+    QString provider;
+    QString model;
+    QString requestType;
+};
+
 class IRequestPerformanceLogger
 {
 public:
@@ -15,7 +37,21 @@ public:
 
     virtual void startTimeMeasurement(const QString &requestId) = 0;
     virtual void endTimeMeasurement(const QString &requestId) = 0;
+    // Records a request that ended in an error; its times are kept out of the percentiles.
+    virtual void failTimeMeasurement(const QString &requestId) = 0;
+    // Drops a measurement without recording it, for requests that were abandoned.
+    virtual void cancelTimeMeasurement(const QString &requestId) = 0;
     virtual void logPerformance(const QString &requestId, qint64 elapsedMs) = 0;
+    // Both only apply between startTimeMeasurement and the end or cancellation of the request.
+    // Context, Enrichment and Payload happen before the request is sent and are added to the
+    // total measured from startTimeMeasurement.
+    virtual void describeRequest(const QString &requestId, const RequestLabels &labels) = 0;
+    virtual void recordPhase(const QString &requestId, RequestPhase phase, qint64 elapsedMs) = 0;
+    virtual void recordCacheLookup(const QString &cache, bool hit) = 0;
+
+    // Completion time of recent completed requests at the given percentile (0-100), or -1 without
+    // data.
+    virtual qint64 latencyPercentile(int percentile) const = 0;
 };
 
 } // namespace QodeAssist
@@ -0,0 +1,100 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+
+namespace QodeAssist {
+
+/**
+ * @brief Bounded queue that any number of threads push to without locking and one thread drains.
+ *
+ * Each slot carries a sequence number that tells producers and the consumer whose turn it is
+ * (Vyukov's bounded queue). A push fails instead of waiting when the queue is full, so a burst of
+ * messages can never stall the thread that produces them.
+ */
+template<typename T>
+class LogRingBuffer
+{
+public:
+    // The capacity is rounded up to a power of two.
+    explicit LogRingBuffer(size_t capacity)
+        : m_mask(roundUp(capacity) - 1)
+        , m_slots(std::make_unique<Slot[]>(m_mask + 1))
+    {
+        for (size_t i = 0; i <= m_mask; ++i)
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    LogRingBuffer(const LogRingBuffer &) = delete;
+    LogRingBuffer &operator=(const LogRingBuffer &) = delete;
+
+    size_t capacity() const { return m_mask + 1; }
+
+    bool tryPush(T value)
+    {
+        size_t position = m_pushPosition.load(std::memory_order_relaxed);
+        Slot *slot = nullptr;
+        while (true) {
+            slot = &m_slots[position & m_mask];
+            const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const auto difference = std::ptrdiff_t(sequence) - std::ptrdiff_t(position);
+            if (difference == 0) {
+                if (m_pushPosition.compare_exchange_weak(
+                        position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = m_pushPosition.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->value = std::move(value);
+        slot->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Only ever called from one thread at a time.
+    std::optional<T> tryPop()
+    {
+        Slot &slot = m_slots[m_popPosition & m_mask];
+        const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (std::ptrdiff_t(sequence) - std::ptrdiff_t(m_popPosition + 1) < 0)
+            return std::nullopt;
+
+        std::optional<T> value(std::move(slot.value));
+        slot.value = T();
+        slot.sequence.store(m_popPosition + m_mask + 1, std::memory_order_release);
+        ++m_popPosition;
+        return value;
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    static size_t roundUp(size_t capacity)
+    {
+        size_t size = 2;
+        while (size < capacity)
+            size *= 2;
+        return size;
+    }
+
+    const size_t m_mask;
+    std::unique_ptr<Slot[]> m_slots;
+    alignas(64) std::atomic<size_t> m_pushPosition{0};
+    alignas(64) size_t m_popPosition = 0;
+};
+
+} // namespace QodeAssist
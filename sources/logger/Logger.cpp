@@ -5,8 +5,66 @@
 #include "Logger.hpp"
 #include <coreplugin/messagemanager.h>
 
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTimer>
+
 namespace QodeAssist {
 
+namespace {
+
+constexpr size_t kQueueCapacity = 4096;
+// How long messages wait before they are written out together.
+constexpr int kFlushIntervalMs = 100;
+constexpr qint64 kMaxLogFileSize = 5 * 1024 * 1024;
+constexpr int kRotatedLogFiles = 3;
+
+const QLatin1String kPrefix("[QodeAssist] ");
+
+QString categoryName(LogCategory category)
+{
+    switch (category) {
+    case LogCategory::General:
+        return QStringLiteral("general");
+    case LogCategory::Completion:
+        return QStringLiteral("completion");
+    case LogCategory::Chat:
+        return QStringLiteral("chat");
+    case LogCategory::Context:
+        return QStringLiteral("context");
+    case LogCategory::Tools:
+        return QStringLiteral("tools");
+    }
+    return {};
+}
+
+QString rotatedPath(const QString &filePath, int index)
+{
+    return QString("%1.%2").arg(filePath).arg(index);
+}
+
+void writeToFile(const QString &filePath, const QString &text)
+{
+    QFile file(filePath);
+    // Nowhere to report this; the message pane still has the log.
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text))
+        return;
+    file.write(text.toUtf8());
+    if (file.size() < kMaxLogFileSize)
+        return;
+    file.close();
+
+    QFile::remove(rotatedPath(filePath, kRotatedLogFiles));
+    for (int index = kRotatedLogFiles - 1; index >= 1; --index)
+        QFile::rename(rotatedPath(filePath, index), rotatedPath(filePath, index + 1));
+    QFile::rename(filePath, rotatedPath(filePath, 1));
+}
+
+} // namespace
+
 Logger &Logger::instance()
 {
     static Logger instance;
@@ -14,8 +72,18 @@ Logger &Logger::instance()
 }
 
 Logger::Logger()
-    : m_loggingEnabled(false)
-{}
+    : m_queue(kQueueCapacity)
+{
+    // The first message may come from a worker thread; flushes belong on the GUI thread.
+    if (auto *app = QCoreApplication::instance())
+        moveToThread(app->thread());
+    m_fileWriter.setMaxThreadCount(1);
+}
+
+Logger::~Logger()
+{
+    m_fileWriter.waitForDone();
+}
 
 void Logger::setLoggingEnabled(bool enable)
 {
@@ -24,36 +92,121 @@ void Logger::setLoggingEnabled(bool enable)
 
 bool Logger::isLoggingEnabled() const
 {
-    return m_loggingEnabled;
+    return m_loggingEnabled.load(std::memory_order_relaxed);
+}
+
+void Logger::setDebugCategories(LogCategories categories)
+{
+    m_debugCategories = categories.toInt();
+}
+
+bool Logger::isDebugEnabled(LogCategory category) const
+{
+    return isLoggingEnabled()
+           && (m_debugCategories.load(std::memory_order_relaxed) & quint32(category)) != 0;
+}
+
+void Logger::setLogFile(const QString &filePath)
+{
+    if (!filePath.isEmpty())
+        QDir().mkpath(QFileInfo(filePath).absolutePath());
+    m_logFilePath = filePath;
 }
 
 void Logger::log(const QString &message, bool silent)
 {
-    if (!m_loggingEnabled)
+    if (!isLoggingEnabled())
         return;
 
-    const QString prefixedMessage = QLatin1String("[QodeAssist] ") + message;
-    if (silent) {
-        Core::MessageManager::writeSilently(prefixedMessage);
-    } else {
-        Core::MessageManager::writeFlashing(prefixedMessage);
-    }
+    enqueue({kPrefix + message, QDateTime::currentMSecsSinceEpoch(), silent});
+}
+
+void Logger::log(LogCategory category, const QString &message)
+{
+    if (!isDebugEnabled(category))
+        return;
+
+    enqueue(
+        {QString("[QodeAssist][%1] %2").arg(categoryName(category), message),
+         QDateTime::currentMSecsSinceEpoch(),
+         true});
 }
 
 void Logger::logMessages(const QStringList &messages, bool silent)
 {
-    if (!m_loggingEnabled)
+    if (!isLoggingEnabled())
+        return;
+
+    const qint64 timestamp = QDateTime::currentMSecsSinceEpoch();
+    for (const QString &message : messages)
+        enqueue({kPrefix + message, timestamp, silent});
+}
+
+void Logger::enqueue(Entry entry)
+{
+    if (!m_queue.tryPush(std::move(entry)))
+        ++m_dropped;
+
+    if (m_flushScheduled.exchange(true))
         return;
+    QMetaObject::invokeMethod(
+        this,
+        [this] { QTimer::singleShot(kFlushIntervalMs, this, &Logger::flush); },
+        Qt::QueuedConnection);
+}
 
-    QStringList prefixedMessages;
-    for (const QString &message : messages) {
-        prefixedMessages << (QLatin1String("[QodeAssist] ") + message);
+void Logger::flush()
+{
+    // Cleared first: anything queued from here on is either drained below or schedules the next
+    // flush.
+    m_flushScheduled = false;
+
+    const bool toFile = !m_logFilePath.isEmpty();
+    QString fileText;
+    QStringList run;
+    bool runSilent = true;
+    const auto writeRun = [&run, &runSilent] {
+        if (run.isEmpty())
+            return;
+        if (runSilent)
+            Core::MessageManager::writeSilently(run);
+        else
+            Core::MessageManager::writeFlashing(run);
+        run.clear();
+    };
+
+    // At most one queue's worth per flush, so a steady stream of messages cannot hold the GUI
+    // thread here.
+    size_t drained = 0;
+    for (; drained < m_queue.capacity(); ++drained) {
+        std::optional<Entry> entry = m_queue.tryPop();
+        if (!entry)
+            break;
+        if (entry->silent != runSilent)
+            writeRun();
+        runSilent = entry->silent;
+        if (toFile) {
+            fileText += QDateTime::fromMSecsSinceEpoch(entry->timestamp).toString(Qt::ISODateWithMs)
+                        + QLatin1Char(' ') + entry->text + QLatin1Char('\n');
+        }
+        run.append(std::move(entry->text));
+    }
+
+    if (const qint64 dropped = m_dropped.exchange(0)) {
+        const QString notice = kPrefix + QString("%1 log messages dropped").arg(dropped);
+        run.append(notice);
+        if (toFile)
+            fileText += notice + QLatin1Char('\n');
     }
+    writeRun();
 
-    if (silent) {
-        Core::MessageManager::writeSilently(prefixedMessages);
-    } else {
-        Core::MessageManager::writeFlashing(prefixedMessages);
+    if (!fileText.isEmpty()) {
+        m_fileWriter.start(
+            [filePath = m_logFilePath, fileText] { writeToFile(filePath, fileText); });
     }
+
+    if (drained == m_queue.capacity() && !m_flushScheduled.exchange(true))
+        QTimer::singleShot(0, this, &Logger::flush);
 }
+
 } // namespace QodeAssist
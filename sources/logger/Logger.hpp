@@ -4,11 +4,36 @@
 
 #pragma once
 
+#include <QFlags>
 #include <QObject>
 #include <QString>
+#include <QThreadPool>
+
+#include <atomic>
+
+#include "LogRingBuffer.hpp"
 
 namespace QodeAssist {
 
+// Debug messages are tagged with the area they come from so they can be enabled per area.
+enum class LogCategory : quint32 {
+    General = 0x01,
+    Completion = 0x02,
+    Chat = 0x04,
+    Context = 0x08,
+    Tools = 0x10,
+};
+Q_DECLARE_FLAGS(LogCategories, LogCategory)
+Q_DECLARE_OPERATORS_FOR_FLAGS(LogCategories)
+
+/**
+ * @brief Plugin log, written to the General Messages pane and optionally to a file.
+ *
+ * Messages from any thread go into a lock-free queue and are written out in batches a short
+ * while later on the GUI thread, so logging costs the caller little more than formatting the
+ * message. The file, when set, is written on a worker thread and rotated once it grows large.
+ * Messages that arrive while the queue is full are dropped and counted.
+ */
 class Logger : public QObject
 {
     Q_OBJECT
@@ -19,19 +44,68 @@ public:
     void setLoggingEnabled(bool enable);
     bool isLoggingEnabled() const;
 
+    void setDebugCategories(LogCategories categories);
+    bool isDebugEnabled(LogCategory category) const;
+
+    // Also append the log to filePath; an empty path stops writing to a file.
+    void setLogFile(const QString &filePath);
+
     void log(const QString &message, bool silent = true);
+    void log(LogCategory category, const QString &message);
     void logMessages(const QStringList &messages, bool silent = true);
 
+    // Writes out everything queued so far; called on the GUI thread.
+    void flush();
+
 private:
+    struct Entry
+    {
+        QString text;
+        qint64 timestamp = 0;
+        bool silent = true;
+    };
+
     Logger();
-    ~Logger() = default;
+    ~Logger() override;
     Logger(const Logger &) = delete;
     Logger &operator=(const Logger &) = delete;
 
-    bool m_loggingEnabled;
+    void enqueue(Entry entry);
+
+    std::atomic<bool> m_loggingEnabled{false};
+    std::atomic<quint32> m_debugCategories{0};
+    std::atomic<bool> m_flushScheduled{false};
+    std::atomic<qint64> m_dropped{0};
+    LogRingBuffer<Entry> m_queue;
+    // Only touched on the GUI thread.
+    QString m_logFilePath;
+    QThreadPool m_fileWriter;
 };
 
-#define LOG_MESSAGE(msg) QodeAssist::Logger::instance().log(msg)
-#define LOG_MESSAGES(msgs) QodeAssist::Logger::instance().logMessages(msgs)
+// The message is only formatted when it is going to be logged.
+#define LOG_MESSAGE(msg) \
+    do { \
+        if (QodeAssist::Logger::instance().isLoggingEnabled()) \
+            QodeAssist::Logger::instance().log(msg); \
+    } while (false)
+#define LOG_MESSAGES(msgs) \
+    do { \
+        if (QodeAssist::Logger::instance().isLoggingEnabled()) \
+            QodeAssist::Logger::instance().logMessages(msgs); \
+    } while (false)
+
+// Detailed traces from hot paths, off unless verbose logging is on for the category. Building
+// with QODEASSIST_NO_DEBUG_LOG removes them altogether.
+#ifdef QODEASSIST_NO_DEBUG_LOG
+#define LOG_DEBUG(category, msg) \
+    do { \
+    } while (false)
+#else
+#define LOG_DEBUG(category, msg) \
+    do { \
+        if (QodeAssist::Logger::instance().isDebugEnabled(QodeAssist::LogCategory::category)) \
+            QodeAssist::Logger::instance().log(QodeAssist::LogCategory::category, msg); \
+    } while (false)
+#endif
 
 } // namespace QodeAssist
@@ -5,24 +5,146 @@
 #include "RequestPerformanceLogger.hpp"
 #include "Logger.hpp"
 
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringList>
+
+#include <algorithm>
+
 namespace QodeAssist {
 
+namespace {
+
+constexpr int kRecordLimit = 1000;
+// Recent requests behind latencyPercentile(), whatever their labels.
+constexpr int kLatencyWindow = 64;
+constexpr RequestPhase kPreSendPhases[]
+    = {RequestPhase::Context, RequestPhase::Enrichment, RequestPhase::Payload};
+const QString kTotalMetric = QStringLiteral("total");
+
+qint64 percentileOf(QList<qint64> values, int percentile)
+{
+    if (values.isEmpty())
+        return -1;
+
+    const qsizetype index = (values.size() - 1) * qBound(0, percentile, 100) / 100;
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values.at(index);
+}
+
+QString labelsKey(const RequestLabels &labels)
+{
+    return labels.provider + QLatin1Char('\n') + labels.model + QLatin1Char('\n')
+           + labels.requestType;
+}
+
+QString csvField(const QString &value)
+{
+    if (!value.contains(QLatin1Char(',')) && !value.contains(QLatin1Char('"'))
+        && !value.contains(QLatin1Char('\n'))) {
+        return value;
+    }
+    QString quoted = value;
+    quoted.replace(QLatin1Char('"'), QLatin1String("\"\""));
+    return QLatin1Char('"') + quoted + QLatin1Char('"');
+}
+
+QString csvDuration(qint64 elapsedMs)
+{
+    return elapsedMs < 0 ? QString() : QString::number(elapsedMs);
+}
+
+} // namespace
+
 void RequestPerformanceLogger::startTimeMeasurement(const QString &requestId)
 {
-    m_requestStartTimes[requestId] = QDateTime::currentMSecsSinceEpoch();
+    Measurement measurement;
+    measurement.startTime = QDateTime::currentMSecsSinceEpoch();
+    measurement.phases.fill(-1);
+    m_measurements.insert(requestId, measurement);
 }
 
 void RequestPerformanceLogger::endTimeMeasurement(const QString &requestId)
 {
-    if (!m_requestStartTimes.contains(requestId)) {
+    finishMeasurement(requestId, RequestOutcome::Completed);
+}
+
+void RequestPerformanceLogger::failTimeMeasurement(const QString &requestId)
+{
+    finishMeasurement(requestId, RequestOutcome::Failed);
+}
+
+void RequestPerformanceLogger::finishMeasurement(const QString &requestId, RequestOutcome outcome)
+{
+    const auto it = m_measurements.constFind(requestId);
+    if (it == m_measurements.constEnd()) {
         return;
     }
 
-    qint64 startTime = m_requestStartTimes[requestId];
-    qint64 endTime = QDateTime::currentMSecsSinceEpoch();
-    qint64 totalTime = endTime - startTime;
-    logPerformance(requestId, totalTime);
-    m_requestStartTimes.remove(requestId);
+    const Measurement measurement = it.value();
+    m_measurements.erase(it);
+
+    RequestRecord record;
+    record.requestId = requestId;
+    record.finishedAt = QDateTime::currentMSecsSinceEpoch();
+    record.labels = measurement.labels;
+    record.phases = measurement.phases;
+    record.total = record.finishedAt - measurement.startTime;
+    for (const RequestPhase phase : kPreSendPhases)
+        record.total += qMax<qint64>(0, measurement.phases[size_t(phase)]);
+    record.outcome = outcome;
+
+    if (outcome == RequestOutcome::Completed)
+        logPerformance(requestId, record.total);
+    else
+        LOG_MESSAGE(QString("Performance: %1 failed after %2 ms").arg(requestId).arg(record.total));
+
+    QStringList phases;
+    for (int phase = 0; phase < kPhaseCount; ++phase) {
+        if (record.phases[size_t(phase)] >= 0)
+            phases.append(QString("%1 %2 ms")
+                              .arg(phaseName(RequestPhase(phase)))
+                              .arg(record.phases[size_t(phase)]));
+    }
+    if (!phases.isEmpty())
+        LOG_MESSAGE(QString("Performance: %1 phases: %2").arg(requestId, phases.join(", ")));
+
+    m_records.append(record);
+    if (m_records.size() > kRecordLimit)
+        m_records.removeFirst();
+}
+
+void RequestPerformanceLogger::cancelTimeMeasurement(const QString &requestId)
+{
+    m_measurements.remove(requestId);
+}
+
+void RequestPerformanceLogger::describeRequest(
+    const QString &requestId, const RequestLabels &labels)
+{
+    const auto it = m_measurements.find(requestId);
+    if (it != m_measurements.end())
+        it.value().labels = labels;
+}
+
+void RequestPerformanceLogger::recordPhase(
+    const QString &requestId, RequestPhase phase, qint64 elapsedMs)
+{
+    const auto it = m_measurements.find(requestId);
+    if (it != m_measurements.end() && elapsedMs >= 0)
+        it.value().phases[size_t(phase)] = elapsedMs;
+}
+
+qint64 RequestPerformanceLogger::latencyPercentile(int percentile) const
+{
+    QList<qint64> totals;
+    for (auto it = m_records.crbegin(); it != m_records.crend() && totals.size() < kLatencyWindow;
+         ++it) {
+        if (it->outcome == RequestOutcome::Completed)
+            totals.append(it->total);
+    }
+    return percentileOf(totals, percentile);
 }
 
 void RequestPerformanceLogger::logPerformance(const QString &requestId, qint64 elapsedMs)
@@ -37,4 +159,177 @@ void RequestPerformanceLogger::logPerformance(
     LOG_MESSAGE(QString("Performance: %1 %2 took %3 ms").arg(requestId, operation).arg(elapsedMs));
 }
 
+void RequestPerformanceLogger::recordCacheLookup(const QString &cache, bool hit)
+{
+    CacheCounters &counters = m_cacheCounters[cache];
+    if (!hit) {
+        ++counters.misses;
+        return;
+    }
+
+    ++counters.hits;
+    LOG_MESSAGE(QString("Performance: %1 hit (%2 hits, %3 misses)")
+                    .arg(cache)
+                    .arg(counters.hits)
+                    .arg(counters.misses));
+}
+
+RequestPerformanceLogger::CacheCounters RequestPerformanceLogger::cacheCounters(
+    const QString &cache) const
+{
+    return m_cacheCounters.value(cache);
+}
+
+QList<RequestPerformanceLogger::RequestRecord> RequestPerformanceLogger::records() const
+{
+    return m_records;
+}
+
+QList<RequestPerformanceLogger::LatencySummary> RequestPerformanceLogger::latencySummaries() const
+{
+    // Groups in the order their labels were first seen.
+    QStringList keys;
+    QHash<QString, QList<const RequestRecord *>> groups;
+    for (const RequestRecord &record : m_records) {
+        const QString key = labelsKey(record.labels);
+        auto &group = groups[key];
+        if (group.isEmpty())
+            keys.append(key);
+        group.append(&record);
+    }
+
+    QList<LatencySummary> summaries;
+    for (const QString &key : std::as_const(keys)) {
+        QList<const RequestRecord *> completed;
+        int failed = 0;
+        for (const RequestRecord *record : std::as_const(groups[key])) {
+            if (record->outcome == RequestOutcome::Completed)
+                completed.append(record);
+            else
+                ++failed;
+        }
+
+        const RequestLabels &labels = groups[key].first()->labels;
+        const auto summarize = [&](const QString &metric, const QList<qint64> &values) {
+            // The total is listed even without a completed request, to carry the failures.
+            if (values.isEmpty() && (metric != kTotalMetric || failed == 0))
+                return;
+            summaries.append(
+                {labels,
+                 metric,
+                 int(values.size()),
+                 percentileOf(values, 50),
+                 percentileOf(values, 95),
+                 percentileOf(values, 99),
+                 failed});
+        };
+
+        for (int phase = 0; phase < kPhaseCount; ++phase) {
+            QList<qint64> values;
+            for (const RequestRecord *record : std::as_const(completed)) {
+                if (record->phases[size_t(phase)] >= 0)
+                    values.append(record->phases[size_t(phase)]);
+            }
+            summarize(phaseName(RequestPhase(phase)), values);
+        }
+        QList<qint64> totals;
+        for (const RequestRecord *record : std::as_const(completed))
+            totals.append(record->total);
+        summarize(kTotalMetric, totals);
+    }
+    return summaries;
+}
+
+QString RequestPerformanceLogger::phaseName(RequestPhase phase)
+{
+    switch (phase) {
+    case RequestPhase::Context:
+        return QStringLiteral("context");
+    case RequestPhase::Enrichment:
+        return QStringLiteral("enrichment");
+    case RequestPhase::Payload:
+        return QStringLiteral("payload");
+    case RequestPhase::FirstByte:
+        return QStringLiteral("ttfb");
+    case RequestPhase::Stream:
+        return QStringLiteral("stream");
+    case RequestPhase::PostProcess:
+        return QStringLiteral("post_process");
+    }
+    return {};
+}
+
+QString RequestPerformanceLogger::outcomeName(RequestOutcome outcome)
+{
+    switch (outcome) {
+    case RequestOutcome::Completed:
+        return QStringLiteral("completed");
+    case RequestOutcome::Failed:
+        return QStringLiteral("failed");
+    }
+    return {};
+}
+
+QByteArray RequestPerformanceLogger::exportJson() const
+{
+    QJsonArray summaries;
+    for (const LatencySummary &summary : latencySummaries()) {
+        summaries.append(QJsonObject{
+            {"provider", summary.labels.provider},
+            {"model", summary.labels.model},
+            {"requestType", summary.labels.requestType},
+            {"metric", summary.metric},
+            {"count", summary.count},
+            {"p50", summary.p50},
+            {"p95", summary.p95},
+            {"p99", summary.p99},
+            {"failed", summary.failed}});
+    }
+
+    QJsonArray requests;
+    for (const RequestRecord &record : m_records) {
+        QJsonObject phases;
+        for (int phase = 0; phase < kPhaseCount; ++phase) {
+            if (record.phases[size_t(phase)] >= 0)
+                phases.insert(phaseName(RequestPhase(phase)), record.phases[size_t(phase)]);
+        }
+        requests.append(QJsonObject{
+            {"id", record.requestId},
+            {"finishedAt",
+             QDateTime::fromMSecsSinceEpoch(record.finishedAt).toString(Qt::ISODateWithMs)},
+            {"provider", record.labels.provider},
+            {"model", record.labels.model},
+            {"requestType", record.labels.requestType},
+            {"phases", phases},
+            {"total", record.total},
+            {"outcome", outcomeName(record.outcome)}});
+    }
+
+    return QJsonDocument(QJsonObject{{"summaries", summaries}, {"requests", requests}})
+        .toJson(QJsonDocument::Indented);
+}
+
+QByteArray RequestPerformanceLogger::exportCsv() const
+{
+    QStringList header{"finished_at", "request_id", "provider", "model", "request_type"};
+    for (int phase = 0; phase < kPhaseCount; ++phase)
+        header.append(phaseName(RequestPhase(phase)) + QLatin1String("_ms"));
+    header.append({QStringLiteral("total_ms"), QStringLiteral("outcome")});
+
+    QStringList lines{header.join(QLatin1Char(','))};
+    for (const RequestRecord &record : m_records) {
+        QStringList fields{
+            QDateTime::fromMSecsSinceEpoch(record.finishedAt).toString(Qt::ISODateWithMs),
+            csvField(record.requestId),
+            csvField(record.labels.provider),
+            csvField(record.labels.model),
+            csvField(record.labels.requestType)};
+        for (int phase = 0; phase < kPhaseCount; ++phase)
+            fields.append(csvDuration(record.phases[size_t(phase)]));
+        fields.append({QString::number(record.total), outcomeName(record.outcome)});
+        lines.append(fields.join(QLatin1Char(',')));
+    }
+    return (lines.join(QLatin1Char('\n')) + QLatin1Char('\n')).toUtf8();
+}
+
 } // namespace QodeAssist
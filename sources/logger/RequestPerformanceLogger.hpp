@@ -2,25 +2,93 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 // Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
 
+#pragma once
+
 #include "IRequestPerformanceLogger.hpp"
 #include <QDateTime>
+#include <QHash>
+#include <QList>
 #include <QMap>
 
+#include <array>
+
 namespace QodeAssist {
 
 class RequestPerformanceLogger : public IRequestPerformanceLogger
 {
 public:
+    static constexpr int kPhaseCount = int(RequestPhase::PostProcess) + 1;
+
+    struct CacheCounters
+    {
+        qint64 hits = 0;
+        qint64 misses = 0;
+    };
+
+    // A finished request; phases that were not measured are -1.
+    struct RequestRecord
+    {
+        QString requestId;
+        qint64 finishedAt = 0;
+        RequestLabels labels;
+        std::array<qint64, kPhaseCount> phases;
+        qint64 total = 0;
+        RequestOutcome outcome = RequestOutcome::Completed;
+    };
+
+    // Percentiles of one metric, either a phase or the total, over the retained completed
+    // requests with the same labels; failed ones are only counted.
+    struct LatencySummary
+    {
+        RequestLabels labels;
+        QString metric;
+        int count = 0;
+        qint64 p50 = 0;
+        qint64 p95 = 0;
+        qint64 p99 = 0;
+        int failed = 0;
+    };
+
     RequestPerformanceLogger() = default;
     ~RequestPerformanceLogger() override = default;
 
     void startTimeMeasurement(const QString &requestId) override;
     void endTimeMeasurement(const QString &requestId) override;
+    void failTimeMeasurement(const QString &requestId) override;
+    void cancelTimeMeasurement(const QString &requestId) override;
     void logPerformance(const QString &requestId, qint64 elapsedMs) override;
     void logPerformance(const QString &requestId, const QString &operation, qint64 elapsedMs);
+    void describeRequest(const QString &requestId, const RequestLabels &labels) override;
+    void recordPhase(const QString &requestId, RequestPhase phase, qint64 elapsedMs) override;
+    void recordCacheLookup(const QString &cache, bool hit) override;
+    qint64 latencyPercentile(int percentile) const override;
+
+    CacheCounters cacheCounters(const QString &cache) const;
+    QList<RequestRecord> records() const;
+    QList<LatencySummary> latencySummaries() const;
+
+    static QString phaseName(RequestPhase phase);
+    static QString outcomeName(RequestOutcome outcome);
+
+    // Summaries and the retained requests.
+    QByteArray exportJson() const;
+    // One row per retained request.
+    QByteArray exportCsv() const;
 
 private:
-    QMap<QString, qint64> m_requestStartTimes;
+    void finishMeasurement(const QString &requestId, RequestOutcome outcome);
+
+    struct Measurement
+    {
+        qint64 startTime = 0;
+        RequestLabels labels;
+        std::array<qint64, kPhaseCount> phases;
+    };
+
+    QMap<QString, Measurement> m_measurements;
+    QHash<QString, CacheCounters> m_cacheCounters;
+    // Most recently finished last.
+    QList<RequestRecord> m_records;
 };
 
 } // namespace QodeAssist
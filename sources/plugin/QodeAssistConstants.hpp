@@ -10,6 +10,7 @@ const char ACTION_ID[] = "QodeAssist.Action";
 const char MENU_ID[] = "QodeAssist.Menu";
 
 const char QODE_ASSIST_REQUEST_SUGGESTION[] = "QodeAssist.RequestSuggestion";
+const char QODE_ASSIST_EXPORT_COMPLETION_LATENCY[] = "QodeAssist.ExportCompletionLatency";
 
 const char QODE_ASSIST_CHAT_CONTEXT[] = "QodeAssist.ChatContext";
 const char QODE_ASSIST_CHAT_NAV_ID[] = "QodeAssistChat";
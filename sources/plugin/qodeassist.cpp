@@ -27,9 +27,11 @@
 #include <texteditor/texteditor.h>
 #include <utils/icon.h>
 #include <QAction>
+#include <QFileDialog>
 #include <QMainWindow>
 #include <QMenu>
 #include <QMessageBox>
+#include <QSaveFile>
 #include <QTranslator>
 
 #include <QInputDialog>
@@ -40,6 +42,11 @@
 #include "completion/FimCompletionEngine.hpp"
 #include "context/CompletionContextEnricher.hpp"
 #include "context/ContextManager.hpp"
+#include "context/TokenizerRegistry.hpp"
+#include "tools/ChatHistorySearch.hpp"
+#include "tools/HistoryIndexCache.hpp"
+#include "tools/ProjectTextIndex.hpp"
+#include "tools/SymbolIndex.hpp"
 #include "tools/ProposeCompletionTool.hpp"
 #include "UpdateStatusWidget.hpp"
 #include "plugin/Version.hpp"
@@ -50,6 +57,7 @@
 #include "context/DocumentReaderQtCreator.hpp"
 #include "templates/PromptProviderFim.hpp"
 #include "providers/ProvidersManager.hpp"
+#include "logger/Logger.hpp"
 #include "logger/RequestPerformanceLogger.hpp"
 #include "mcp/McpClientsManager.hpp"
 #include "mcp/McpServerManager.hpp"
@@ -96,15 +104,29 @@
 #include "ChatViewTest.hpp"
 #include "ClaudeCacheControlTest.hpp"
 #include "CodeHandlerTest.hpp"
+#include "CompletionCacheTest.hpp"
+#include "CompletionSchedulerTest.hpp"
 #include "ConversationCoordinatorTest.hpp"
 #include "DocumentContextReaderTest.hpp"
 #include "FimCompletionEngineTest.hpp"
+#include "HistoryIndexTest.hpp"
+#include "HistorySearchIndexTest.hpp"
+#include "IgnoreManagerTest.hpp"
+#include "IgnoreMatcherTest.hpp"
+#include "LineDiffTest.hpp"
 #include "LlmChatBackendTest.hpp"
 #include "LlmSuggestionTest.hpp"
+#include "LogRingBufferTest.hpp"
+#include "MessageSegmenterTest.hpp"
+#include "RequestPerformanceLoggerTest.hpp"
 #include "RowAudienceTest.hpp"
 #include "SessionPermissionsTest.hpp"
 #include "SessionTest.hpp"
+#include "SymbolTableTest.hpp"
+#include "TextScannerTest.hpp"
+#include "TokenizerTest.hpp"
 #include "ToolsManagerGateTest.hpp"
+#include "TrigramIndexTest.hpp"
 #include "TurnContextTest.hpp"
 #endif
 
@@ -240,17 +262,47 @@ public:
         Settings::setupProjectPanel();
         ConfigurationManager::instance().init();
 
+        const auto applyTokenizers = [] {
+            const auto &settings = Settings::generalSettings();
+            auto &registry = Context::TokenizerRegistry::instance();
+            registry.setVocabularyDirectory(settings.tokenizersPath().toFSPathString());
+            // Parsed on a worker now instead of on the GUI thread at the first count.
+            registry.preload(
+                {settings.ccModel(),
+                 settings.ccPreset1Model(),
+                 settings.caModel(),
+                 settings.qrModel()});
+        };
+        applyTokenizers();
+        auto &generalSettings = Settings::generalSettings();
+        const QList<Utils::BaseAspect *> tokenizerAspects{
+            &generalSettings.tokenizersPath,
+            &generalSettings.ccModel,
+            &generalSettings.ccPreset1Model,
+            &generalSettings.caModel,
+            &generalSettings.qrModel};
+        for (Utils::BaseAspect *aspect : tokenizerAspects)
+            connect(aspect, &Utils::BaseAspect::changed, this, applyTokenizers);
+
         m_proposeCompletionTool = new Tools::ProposeCompletionTool(this);
 
         m_mcpServerManager = new Mcp::McpServerManager(this);
         m_mcpServerManager->init();
 
         Mcp::McpClientsManager::instance().init();
+        Tools::ProjectTextIndex::instance().init();
+        Tools::SymbolIndex::instance().init();
 
         if (Settings::generalSettings().enableCheckUpdate()) {
             QTimer::singleShot(3000, this, &QodeAssistPlugin::checkForUpdates);
         }
 
+        ActionBuilder exportLatencyAction(this, Constants::QODE_ASSIST_EXPORT_COMPLETION_LATENCY);
+        exportLatencyAction.setText(Tr::tr("Export QodeAssist Completion Latency..."));
+        exportLatencyAction.setToolTip(
+            Tr::tr("Save per-phase timings and percentiles of recent completion requests"));
+        exportLatencyAction.addOnTriggered(this, [this] { exportCompletionLatency(); });
+
         ActionBuilder quickRefactorAction(this, "QodeAssist.QuickRefactor");
         const QKeySequence quickRefactorShortcut = QKeySequence(Qt::CTRL | Qt::ALT | Qt::Key_R);
         quickRefactorAction.setDefaultKeySequence(quickRefactorShortcut);
@@ -354,8 +406,19 @@ public:
 #ifdef WITH_TESTS
         addTest<CodeHandlerTest>();
         addTest<LlmSuggestionTest>();
+        addTest<CompletionCacheTest>();
+        addTest<CompletionSchedulerTest>();
+        addTest<RequestPerformanceLoggerTest>();
         addTest<ClaudeCacheControlTest>();
         addTest<DocumentContextReaderTest>();
+        addTest<TokenizerTest>();
+        addTest<IgnoreMatcherTest>();
+        addTest<IgnoreManagerTest>();
+        addTest<LineDiffTest>();
+        addTest<LogRingBufferTest>();
+        addTest<TrigramIndexTest>();
+        addTest<TextScannerTest>();
+        addTest<SymbolTableTest>();
         addTest<ChatHistorySerializerTest>();
         addTest<SessionTest>();
         addTest<RowAudienceTest>();
@@ -370,7 +433,10 @@ public:
         addTest<ConversationCoordinatorTest>();
         addTest<BlockCodecTest>();
         addTest<ChatFileStoreTest>();
+        addTest<HistoryIndexTest>();
+        addTest<HistorySearchIndexTest>();
         addTest<ChatViewTest>();
+        addTest<MessageSegmenterTest>();
         addTest<FimCompletionEngineTest>();
         addTest<AgenticCompletionEngineTest>();
         addTest<AcpCompletionEngineTest>();
@@ -418,7 +484,12 @@ public:
             m_proposeCompletionTool,
             this);
         m_completionController = new CodeCompletionController(
-            m_fimEngine, m_agenticEngine, m_acpEngine, *m_completionContextManager, this);
+            m_fimEngine,
+            m_agenticEngine,
+            m_acpEngine,
+            *m_completionContextManager,
+            m_performanceLogger,
+            this);
     }
 
     bool delayedInitialize() final
@@ -429,6 +500,11 @@ public:
 
     ShutdownFlag aboutToShutdown() final
     {
+        Tools::ProjectTextIndex::instance().shutdown();
+        Tools::SymbolIndex::instance().shutdown();
+        Tools::ChatHistorySearch::instance().shutdown();
+        Tools::HistoryIndexCache::instance().shutdown();
+        Logger::instance().flush();
         return SynchronousShutdown;
     }
 
@@ -552,6 +628,38 @@ private:
         }
     }
 
+    void exportCompletionLatency()
+    {
+        const QString jsonFilter = Tr::tr("JSON (*.json)");
+        const QString csvFilter = Tr::tr("CSV (*.csv)");
+        QString selectedFilter = jsonFilter;
+        const QString filePath = QFileDialog::getSaveFileName(
+            Core::ICore::dialogParent(),
+            Tr::tr("Export Completion Latency"),
+            QString("qodeassist-latency-%1.json")
+                .arg(QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss")),
+            jsonFilter + ";;" + csvFilter,
+            &selectedFilter);
+        if (filePath.isEmpty())
+            return;
+
+        const bool csv = filePath.endsWith(".csv", Qt::CaseInsensitive)
+                         || (selectedFilter == csvFilter
+                             && !filePath.endsWith(".json", Qt::CaseInsensitive));
+        const QByteArray data = csv ? m_performanceLogger.exportCsv()
+                                    : m_performanceLogger.exportJson();
+        QSaveFile file(filePath);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text) || file.write(data) != data.size()
+            || !file.commit()) {
+            QMessageBox::warning(
+                Core::ICore::dialogParent(),
+                Tr::tr("Export Completion Latency"),
+                Tr::tr("Cannot write %1: %2").arg(filePath, file.errorString()));
+            return;
+        }
+        LOG_MESSAGE(QString("Exported completion latency to %1").arg(filePath));
+    }
+
     void checkForUpdates()
     {
         connect(
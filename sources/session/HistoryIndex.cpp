@@ -0,0 +1,201 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#include "session/HistoryIndex.hpp"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QSaveFile>
+
+#include "session/HistorySerializer.hpp"
+
+namespace QodeAssist::Session {
+
+namespace {
+
+constexpr int kIndexFormat = 1;
+constexpr int kTitleLength = 60;
+constexpr int kPreviewLength = 200;
+
+QString elided(const QString &text, int maxLength)
+{
+    if (text.length() > maxLength)
+        return text.left(maxLength - 1) + QChar(0x2026);
+    return text;
+}
+
+QString firstUserText(const ConversationHistory &history)
+{
+    for (const Message &message : history.messages()) {
+        if (message.role != MessageRole::User)
+            continue;
+        QString text;
+        for (const ContentBlock &block : message.blocks) {
+            if (const auto *textBlock = std::get_if<TextBlock>(&block))
+                text += textBlock->text;
+        }
+        text = text.trimmed();
+        if (!text.isEmpty())
+            return text;
+    }
+    return {};
+}
+
+QJsonObject entryToJson(const HistoryIndex::Entry &entry)
+{
+    return {
+        {"title", entry.title},
+        {"preview", entry.preview},
+        {"messages", entry.messageCount},
+        {"tokens", entry.totalTokens},
+        {"compressedFrom", entry.compressedFrom},
+        {"size", entry.size},
+        {"modified", entry.modified}};
+}
+
+HistoryIndex::Entry entryFromJson(const QString &filePath, const QJsonObject &json)
+{
+    return {
+        .filePath = filePath,
+        .title = json["title"].toString(),
+        .preview = json["preview"].toString(),
+        .messageCount = json["messages"].toInt(),
+        .totalTokens = json["tokens"].toInteger(),
+        .compressedFrom = json["compressedFrom"].toString(),
+        .size = json["size"].toInteger(),
+        .modified = json["modified"].toInteger()};
+}
+
+} // namespace
+
+HistoryIndex::HistoryIndex(const QString &directory)
+    : m_directory(directory)
+{
+    QFile file(indexFilePath(directory));
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    if (root["version"].toInt() != kIndexFormat)
+        return;
+
+    const QJsonObject chats = root["chats"].toObject();
+    const QDir dir(directory);
+    for (auto it = chats.begin(); it != chats.end(); ++it)
+        m_entries.insert(it.key(), entryFromJson(dir.filePath(it.key()), it.value().toObject()));
+}
+
+QString HistoryIndex::indexFilePath(const QString &directory)
+{
+    return QDir(directory).filePath(".qodeassist_history_index");
+}
+
+HistoryIndex::Entry HistoryIndex::summarize(
+    const ConversationHistory &history, const QJsonObject &meta)
+{
+    Entry entry;
+    const QString text = firstUserText(history);
+    entry.title = elided(text.section(QChar('\n'), 0, 0).trimmed(), kTitleLength);
+    entry.preview = elided(text.simplified(), kPreviewLength);
+    entry.messageCount = int(history.size());
+    for (const Message &message : history.messages())
+        entry.totalTokens += message.usage.promptTokens + message.usage.completionTokens;
+    entry.compressedFrom = meta["compressedFrom"].toString();
+    return entry;
+}
+
+std::optional<HistoryIndex::Entry> HistoryIndex::entry(const QString &chatFilePath)
+{
+    const QFileInfo info(chatFilePath);
+    const QString fileName = info.fileName();
+    if (!info.isFile()) {
+        if (m_entries.remove(fileName))
+            m_dirty = true;
+        return std::nullopt;
+    }
+
+    const auto it = m_entries.constFind(fileName);
+    if (it != m_entries.constEnd() && it->size == info.size()
+        && it->modified == info.lastModified().toMSecsSinceEpoch()) {
+        return *it;
+    }
+
+    const std::optional<Entry> summary = summarizeFile(QDir(m_directory).filePath(fileName));
+    if (!summary) {
+        if (m_entries.remove(fileName))
+            m_dirty = true;
+        return std::nullopt;
+    }
+
+    m_entries.insert(fileName, *summary);
+    m_dirty = true;
+    return summary;
+}
+
+void HistoryIndex::update(
+    const QString &chatFilePath, const ConversationHistory &history, const QJsonObject &meta)
+{
+    const QFileInfo info(chatFilePath);
+    Entry entry = summarize(history, meta);
+    entry.filePath = QDir(m_directory).filePath(info.fileName());
+    entry.size = info.size();
+    entry.modified = info.lastModified().toMSecsSinceEpoch();
+
+    m_entries.insert(info.fileName(), entry);
+    m_dirty = true;
+}
+
+bool HistoryIndex::isDirty() const
+{
+    return m_dirty;
+}
+
+bool HistoryIndex::save()
+{
+    if (!m_dirty)
+        return true;
+
+    QJsonObject chats;
+    for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it)
+        chats[it.key()] = entryToJson(it.value());
+    const QJsonObject root{{"version", kIndexFormat}, {"chats", chats}};
+
+    QSaveFile file(indexFilePath(m_directory));
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    if (!file.commit())
+        return false;
+
+    m_dirty = false;
+    return true;
+}
+
+std::optional<HistoryIndex::Entry> HistoryIndex::summarizeFile(const QString &chatFilePath) const
+{
+    // Taken before reading, so a write in between makes the entry stale rather than wrong.
+    const QFileInfo info(chatFilePath);
+
+    QFile file(chatFilePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return std::nullopt;
+
+    const QJsonObject root = HistorySerializer::readRoot(file.readAll());
+    if (root.isEmpty())
+        return std::nullopt;
+    const std::optional<ConversationHistory> history = HistorySerializer::fromJson(root);
+    if (!history)
+        return std::nullopt;
+
+    Entry entry = summarize(*history, root);
+    entry.filePath = chatFilePath;
+    entry.size = info.size();
+    entry.modified = info.lastModified().toMSecsSinceEpoch();
+    return entry;
+}
+
+} // namespace QodeAssist::Session
@@ -0,0 +1,68 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#pragma once
+
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+
+#include <optional>
+
+#include "session/ConversationHistory.hpp"
+
+namespace QodeAssist::Session {
+
+/**
+ * @brief Summaries of the chats saved in one history directory.
+ *
+ * Kept in a small file next to the chats and updated as they are saved, so listing them or
+ * following a chain of compressed chats does not parse each one. An entry only counts while its
+ * chat file has the size and modification time it was summarized at; otherwise the chat is read
+ * and summarized again. Writers replace the file atomically; an update lost to a concurrent
+ * writer only costs one more summary later.
+ */
+class HistoryIndex
+{
+public:
+    struct Entry
+    {
+        QString filePath;
+        QString title;
+        QString preview;
+        int messageCount = 0;
+        qint64 totalTokens = 0;
+        QString compressedFrom;
+        qint64 size = 0;
+        qint64 modified = 0;
+
+        bool operator==(const Entry &other) const = default;
+    };
+
+    explicit HistoryIndex(const QString &directory);
+
+    static QString indexFilePath(const QString &directory);
+    // meta holds the keys stored next to the messages, such as compressedFrom.
+    static Entry summarize(const ConversationHistory &history, const QJsonObject &meta = {});
+
+    std::optional<Entry> entry(const QString &chatFilePath);
+
+    void update(
+        const QString &chatFilePath, const ConversationHistory &history, const QJsonObject &meta);
+    // Anything changed since the index was read or last saved.
+    bool isDirty() const;
+    // Writes the index out if anything changed since it was read.
+    bool save();
+
+private:
+    std::optional<Entry> summarizeFile(const QString &chatFilePath) const;
+
+    QString m_directory;
+    // By file name.
+    QHash<QString, Entry> m_entries;
+    bool m_dirty = false;
+};
+
+} // namespace QodeAssist::Session
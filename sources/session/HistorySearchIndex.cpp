@@ -0,0 +1,468 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#include "session/HistorySearchIndex.hpp"
+
+#include <QDataStream>
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonDocument>
+
+#include <algorithm>
+#include <cmath>
+
+#include "session/FileEditPayload.hpp"
+
+namespace QodeAssist::Session {
+
+namespace {
+
+constexpr quint32 kMagic = 0x51414853; // "QAHS"
+constexpr quint32 kFormat = 2;
+constexpr int kCompactDeadThreshold = 256;
+constexpr qsizetype kMinTermLength = 2;
+// Longer runs are hashes, base64 and the like, which nobody searches for.
+constexpr qsizetype kMaxTermLength = 64;
+constexpr qsizetype kMinPrefixLength = 3;
+// Characters of context kept on each side of a word in a passage.
+constexpr qsizetype kExcerptContext = 80;
+// Later words of a long chat share passages already cut or go without one.
+constexpr int kMaxExcerptsPerChat = 32;
+// Smallest serialized chat entry and posting, to bound counts read from a damaged file.
+constexpr qint64 kMinChatBytes = 4 + 8 + 4 + 4;
+constexpr qint64 kMinPostingBytes = 4 + 4 + 2;
+
+// BM25 parameters, the usual defaults.
+constexpr double kK1 = 1.2;
+constexpr double kB = 0.75;
+
+void appendBlockText(const ContentBlock &block, QString &text)
+{
+    if (const auto *textBlock = std::get_if<TextBlock>(&block)) {
+        text += textBlock->text;
+    } else if (const auto *toolCall = std::get_if<ToolCallBlock>(&block)) {
+        text += toolCall->name;
+        text += QChar(' ');
+        text += QString::fromUtf8(
+            QJsonDocument(toolCall->arguments).toJson(QJsonDocument::Compact));
+    } else if (const auto *fileEdit = std::get_if<FileEditBlock>(&block)) {
+        if (const auto payload = parseFileEditPayload(fileEdit->payload))
+            text += payload->value("file").toString();
+    } else if (const auto *attachment = std::get_if<AttachmentBlock>(&block)) {
+        text += attachment->fileName;
+    } else if (const auto *image = std::get_if<ImageBlock>(&block)) {
+        text += image->fileName;
+    }
+    text += QChar('\n');
+}
+
+// Calls found(start, length) for each word of text.
+template<typename Found>
+void forEachTerm(const QString &text, Found found)
+{
+    qsizetype start = -1;
+    const auto flush = [&](qsizetype end) {
+        const qsizetype length = end - start;
+        if (start >= 0 && length >= kMinTermLength && length <= kMaxTermLength)
+            found(start, length);
+        start = -1;
+    };
+
+    for (qsizetype i = 0; i < text.size(); ++i) {
+        if (text.at(i).isLetterOrNumber()) {
+            if (start < 0)
+                start = i;
+        } else {
+            flush(i);
+        }
+    }
+    flush(text.size());
+}
+
+QString excerptOf(const QString &text, qsizetype from, qsizetype to)
+{
+    QString excerpt = text.mid(from, to - from).simplified();
+    if (from > 0)
+        excerpt.prepend(QChar(0x2026));
+    if (to < text.size())
+        excerpt.append(QChar(0x2026));
+    return excerpt;
+}
+
+} // namespace
+
+QStringList HistorySearchIndex::termsOf(const QString &text)
+{
+    QStringList terms;
+    forEachTerm(text, [&](qsizetype start, qsizetype length) {
+        terms.append(text.mid(start, length).toLower());
+    });
+    return terms;
+}
+
+HistorySearchIndex::TermCounts HistorySearchIndex::termCountsOf(const ConversationHistory &history)
+{
+    return chatTermsOf(history).counts;
+}
+
+HistorySearchIndex::ChatTerms HistorySearchIndex::chatTermsOf(const ConversationHistory &history)
+{
+    ChatTerms terms;
+    QString text;
+    QString other;
+    for (const Message &message : history.messages()) {
+        // Passages are cut from the text of a message; the other blocks are searched only.
+        text.clear();
+        other.clear();
+        for (const ContentBlock &block : message.blocks)
+            appendBlockText(block, std::holds_alternative<TextBlock>(block) ? text : other);
+
+        qsizetype excerptEnd = -1;
+        forEachTerm(text, [&](qsizetype start, qsizetype length) {
+            const QString term = text.mid(start, length).toLower();
+            ++terms.counts[term];
+            if (terms.excerptOf.contains(term))
+                return;
+            if (start + length <= excerptEnd) {
+                terms.excerptOf.insert(term, int(terms.excerpts.size()) - 1);
+                return;
+            }
+            if (terms.excerpts.size() >= kMaxExcerptsPerChat)
+                return;
+
+            const qsizetype from = std::max<qsizetype>(0, start - kExcerptContext);
+            excerptEnd = std::min(text.size(), start + length + kExcerptContext);
+            terms.excerptOf.insert(term, int(terms.excerpts.size()));
+            terms.excerpts.append(excerptOf(text, from, excerptEnd));
+        });
+
+        for (const QString &term : termsOf(other))
+            ++terms.counts[term];
+    }
+    return terms;
+}
+
+void HistorySearchIndex::setChat(const QString &filePath, qint64 stamp, const TermCounts &terms)
+{
+    setChat(filePath, stamp, ChatTerms{.counts = terms});
+}
+
+void HistorySearchIndex::setChat(const QString &filePath, qint64 stamp, const ChatTerms &terms)
+{
+    const auto existing = m_chatIds.constFind(filePath);
+    if (existing != m_chatIds.constEnd())
+        markDead(existing.value());
+
+    const auto id = ChatId(m_chatEntries.size());
+    quint32 length = 0;
+    for (auto it = terms.counts.cbegin(); it != terms.counts.cend(); ++it) {
+        const int excerpt = terms.excerptOf.value(it.key(), -1);
+        m_postings[it.key()].push_back(
+            {id, quint32(it.value()), excerpt >= 0 ? quint16(excerpt) : kNoExcerpt});
+        length += quint32(it.value());
+    }
+
+    m_chatEntries.push_back({filePath, stamp, length, true, terms.excerpts});
+    m_chatIds.insert(filePath, id);
+    m_totalLength += length;
+
+    if (m_deadChats > kCompactDeadThreshold && m_deadChats > m_chatIds.size())
+        compact();
+}
+
+void HistorySearchIndex::removeChat(const QString &filePath)
+{
+    const auto it = m_chatIds.constFind(filePath);
+    if (it == m_chatIds.constEnd())
+        return;
+
+    markDead(it.value());
+    m_chatIds.erase(it);
+}
+
+void HistorySearchIndex::clear()
+{
+    m_postings.clear();
+    m_chatEntries.clear();
+    m_chatIds.clear();
+    m_totalLength = 0;
+    m_deadChats = 0;
+}
+
+bool HistorySearchIndex::contains(const QString &filePath) const
+{
+    return m_chatIds.contains(filePath);
+}
+
+qint64 HistorySearchIndex::stamp(const QString &filePath) const
+{
+    const auto it = m_chatIds.constFind(filePath);
+    return it != m_chatIds.constEnd() ? m_chatEntries[it.value()].stamp : 0;
+}
+
+QStringList HistorySearchIndex::chats() const
+{
+    return m_chatIds.keys();
+}
+
+int HistorySearchIndex::chatCount() const
+{
+    return int(m_chatIds.size());
+}
+
+QList<HistorySearchIndex::Hit> HistorySearchIndex::search(const QString &query, int limit) const
+{
+    QStringList words = termsOf(query);
+    words.removeDuplicates();
+    if (words.isEmpty() || m_chatIds.isEmpty() || limit <= 0)
+        return {};
+
+    const double chatCount = double(m_chatIds.size());
+    const double averageLength = std::max(1.0, double(m_totalLength) / chatCount);
+
+    struct Match
+    {
+        double score = 0;
+        int terms = 0;
+        QList<quint16> excerpts;
+    };
+    QHash<ChatId, Match> matches;
+
+    struct Best
+    {
+        double score = 0;
+        quint16 excerpt = kNoExcerpt;
+    };
+
+    for (const QString &word : words) {
+        // The word itself sorts first among the words it starts.
+        std::vector<const std::vector<Posting> *> lists;
+        for (auto it = m_postings.lowerBound(word);
+             it != m_postings.constEnd() && it.key().startsWith(word);
+             ++it) {
+            if (it.key().size() == word.size() || word.size() >= kMinPrefixLength)
+                lists.push_back(&it.value());
+            if (word.size() < kMinPrefixLength)
+                break;
+        }
+
+        // A chat matching the word through several terms counts its best one.
+        QHash<ChatId, Best> best;
+        for (const std::vector<Posting> *postings : lists) {
+            const auto frequency = std::count_if(
+                postings->cbegin(), postings->cend(), [this](const Posting &posting) {
+                    return m_chatEntries[posting.chat].live;
+                });
+            if (frequency == 0)
+                continue;
+            const double idf = std::log(
+                1.0 + (chatCount - double(frequency) + 0.5) / (double(frequency) + 0.5));
+
+            for (const Posting &posting : *postings) {
+                const ChatEntry &chat = m_chatEntries[posting.chat];
+                if (!chat.live)
+                    continue;
+                const double count = double(posting.count);
+                const double norm = kK1 * (1.0 - kB + kB * double(chat.length) / averageLength);
+                const double score = idf * count * (kK1 + 1.0) / (count + norm);
+                Best &current = best[posting.chat];
+                current.score = std::max(current.score, score);
+                if (current.excerpt == kNoExcerpt)
+                    current.excerpt = posting.excerpt;
+            }
+        }
+
+        for (auto it = best.cbegin(); it != best.cend(); ++it) {
+            Match &match = matches[it.key()];
+            match.score += it.value().score;
+            ++match.terms;
+            if (it.value().excerpt != kNoExcerpt && !match.excerpts.contains(it.value().excerpt))
+                match.excerpts.append(it.value().excerpt);
+        }
+    }
+
+    QList<Hit> hits;
+    hits.reserve(matches.size());
+    for (auto it = matches.cbegin(); it != matches.cend(); ++it) {
+        const ChatEntry &chat = m_chatEntries[it.key()];
+        Hit hit{
+            .filePath = chat.filePath,
+            .score = it.value().score,
+            .matchedTerms = it.value().terms};
+        for (const quint16 excerpt : it.value().excerpts)
+            hit.excerpts.append(chat.excerpts.value(excerpt));
+        hits.append(hit);
+    }
+
+    std::sort(hits.begin(), hits.end(), [](const Hit &left, const Hit &right) {
+        if (left.matchedTerms != right.matchedTerms)
+            return left.matchedTerms > right.matchedTerms;
+        if (left.score != right.score)
+            return left.score > right.score;
+        return left.filePath < right.filePath;
+    });
+    if (hits.size() > limit)
+        hits.resize(limit);
+    return hits;
+}
+
+void HistorySearchIndex::compact()
+{
+    if (m_deadChats == 0)
+        return;
+
+    std::vector<ChatId> remap(m_chatEntries.size(), ChatId(-1));
+    std::vector<ChatEntry> entries;
+    entries.reserve(m_chatIds.size());
+    for (size_t id = 0; id < m_chatEntries.size(); ++id) {
+        if (!m_chatEntries[id].live)
+            continue;
+        remap[id] = ChatId(entries.size());
+        entries.push_back(std::move(m_chatEntries[id]));
+    }
+
+    for (auto it = m_postings.begin(); it != m_postings.end();) {
+        std::vector<Posting> &postings = it.value();
+        std::vector<Posting> kept;
+        kept.reserve(postings.size());
+        for (const Posting &posting : postings) {
+            if (remap[posting.chat] != ChatId(-1))
+                kept.push_back({remap[posting.chat], posting.count, posting.excerpt});
+        }
+        if (kept.empty()) {
+            it = m_postings.erase(it);
+        } else {
+            postings = std::move(kept);
+            ++it;
+        }
+    }
+
+    m_chatEntries = std::move(entries);
+    for (auto it = m_chatIds.begin(); it != m_chatIds.end(); ++it)
+        it.value() = remap[it.value()];
+    m_deadChats = 0;
+}
+
+QByteArray HistorySearchIndex::serialize() const
+{
+    std::vector<ChatId> remap(m_chatEntries.size(), ChatId(-1));
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream << kMagic << kFormat;
+
+    stream << quint32(m_chatIds.size());
+    ChatId next = 0;
+    for (size_t id = 0; id < m_chatEntries.size(); ++id) {
+        const ChatEntry &chat = m_chatEntries[id];
+        if (!chat.live)
+            continue;
+        remap[id] = next++;
+        stream << QFileInfo(chat.filePath).fileName() << chat.stamp << chat.length
+               << quint32(chat.excerpts.size());
+        for (const QString &excerpt : chat.excerpts)
+            stream << excerpt;
+    }
+
+    std::vector<Posting> live;
+    quint32 termCount = 0;
+    for (const std::vector<Posting> &postings : m_postings) {
+        if (std::any_of(postings.cbegin(), postings.cend(), [&remap](const Posting &posting) {
+                return remap[posting.chat] != ChatId(-1);
+            })) {
+            ++termCount;
+        }
+    }
+    stream << termCount;
+
+    for (auto it = m_postings.cbegin(); it != m_postings.cend(); ++it) {
+        live.clear();
+        for (const Posting &posting : it.value()) {
+            if (remap[posting.chat] != ChatId(-1))
+                live.push_back({remap[posting.chat], posting.count, posting.excerpt});
+        }
+        if (live.empty())
+            continue;
+        stream << it.key() << quint32(live.size());
+        for (const Posting &posting : live)
+            stream << posting.chat << posting.count << posting.excerpt;
+    }
+    return data;
+}
+
+bool HistorySearchIndex::deserialize(const QByteArray &data, const QString &directory)
+{
+    clear();
+
+    QDataStream stream(data);
+    quint32 magic = 0;
+    quint32 format = 0;
+    stream >> magic >> format;
+    if (magic != kMagic || format != kFormat)
+        return false;
+
+    // Counts come from the file, so no more is reserved than the bytes left could hold.
+    const auto fitting = [&stream](quint32 count, qint64 minBytes) {
+        return qsizetype(std::min<qint64>(count, stream.device()->bytesAvailable() / minBytes));
+    };
+
+    const QDir dir(directory);
+    quint32 chatCount = 0;
+    stream >> chatCount;
+    m_chatEntries.reserve(fitting(chatCount, kMinChatBytes));
+    for (quint32 id = 0; id < chatCount && stream.status() == QDataStream::Ok; ++id) {
+        QString fileName;
+        ChatEntry chat;
+        quint32 excerptCount = 0;
+        stream >> fileName >> chat.stamp >> chat.length >> excerptCount;
+        for (quint32 i = 0; i < excerptCount && stream.status() == QDataStream::Ok; ++i) {
+            QString excerpt;
+            stream >> excerpt;
+            chat.excerpts.append(excerpt);
+        }
+        chat.filePath = dir.filePath(fileName);
+        chat.live = true;
+        m_chatIds.insert(chat.filePath, id);
+        m_totalLength += chat.length;
+        m_chatEntries.push_back(std::move(chat));
+    }
+
+    quint32 termCount = 0;
+    stream >> termCount;
+    for (quint32 i = 0; i < termCount && stream.status() == QDataStream::Ok; ++i) {
+        QString term;
+        quint32 postingCount = 0;
+        stream >> term >> postingCount;
+        std::vector<Posting> &postings = m_postings[term];
+        postings.reserve(fitting(postingCount, kMinPostingBytes));
+        for (quint32 j = 0; j < postingCount && stream.status() == QDataStream::Ok; ++j) {
+            Posting posting;
+            stream >> posting.chat >> posting.count >> posting.excerpt;
+            if (posting.chat >= m_chatEntries.size()
+                || (posting.excerpt != kNoExcerpt
+                    && posting.excerpt >= m_chatEntries[posting.chat].excerpts.size())) {
+                stream.setStatus(QDataStream::ReadCorruptData);
+                break;
+            }
+            postings.push_back(posting);
+        }
+    }
+
+    if (stream.status() != QDataStream::Ok || m_chatEntries.size() != chatCount) {
+        clear();
+        return false;
+    }
+    return true;
+}
+
+void HistorySearchIndex::markDead(ChatId id)
+{
+    ChatEntry &chat = m_chatEntries[id];
+    if (!chat.live)
+        return;
+    chat.live = false;
+    m_totalLength -= chat.length;
+    ++m_deadChats;
+}
+
+} // namespace QodeAssist::Session
@@ -0,0 +1,110 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+
+#include <vector>
+
+#include "session/ConversationHistory.hpp"
+
+namespace QodeAssist::Session {
+
+/**
+ * @brief Inverted word index over saved chats, ranked with BM25.
+ *
+ * A chat is indexed by the words of its messages, the names and arguments of its tool calls,
+ * the paths of its file edits and the names of its attachments; tool results are left out, as
+ * they mostly repeat file contents. Words are runs of letters and digits, lowercased. Query
+ * words of three or more characters also match words they start, so "crash" finds "crashed".
+ * Chats matching more of the query words rank first, then by score.
+ *
+ * Each chat also keeps a few short passages of its messages, cut when it is indexed, and every
+ * word points at the first one it occurs in; hits carry them, so showing where a chat matched
+ * does not read the chat again. Words are kept sorted, so a prefix is a range of them.
+ *
+ * Chat ids only grow, so a re-indexed chat is appended to every posting list it is in; the
+ * replaced chat leaves a dead id behind until compact() rewrites the lists, as in TrigramIndex.
+ * Not thread-safe.
+ */
+class HistorySearchIndex
+{
+public:
+    using TermCounts = QHash<QString, int>;
+
+    struct ChatTerms
+    {
+        TermCounts counts;
+        QStringList excerpts;
+        // Index into excerpts of the passage each word first occurs in, if one was kept.
+        QHash<QString, int> excerptOf;
+    };
+
+    struct Hit
+    {
+        QString filePath;
+        double score = 0;
+        int matchedTerms = 0;
+        // Passages the matched words occur in, in query order and without repeats.
+        QStringList excerpts;
+    };
+
+    static QStringList termsOf(const QString &text);
+    static TermCounts termCountsOf(const ConversationHistory &history);
+    static ChatTerms chatTermsOf(const ConversationHistory &history);
+
+    void setChat(const QString &filePath, qint64 stamp, const TermCounts &terms);
+    void setChat(const QString &filePath, qint64 stamp, const ChatTerms &terms);
+    void removeChat(const QString &filePath);
+    void clear();
+
+    bool contains(const QString &filePath) const;
+    qint64 stamp(const QString &filePath) const;
+    QStringList chats() const;
+    int chatCount() const;
+
+    QList<Hit> search(const QString &query, int limit) const;
+
+    void compact();
+
+    // Chats are stored by file name, so the index stays valid when its directory moves.
+    QByteArray serialize() const;
+    bool deserialize(const QByteArray &data, const QString &directory);
+
+private:
+    using ChatId = quint32;
+
+    static constexpr quint16 kNoExcerpt = 0xffff;
+
+    struct Posting
+    {
+        ChatId chat = 0;
+        quint32 count = 0;
+        quint16 excerpt = kNoExcerpt;
+    };
+
+    struct ChatEntry
+    {
+        QString filePath;
+        qint64 stamp = 0;
+        quint32 length = 0;
+        bool live = false;
+        QStringList excerpts;
+    };
+
+    void markDead(ChatId id);
+
+    QMap<QString, std::vector<Posting>> m_postings;
+    std::vector<ChatEntry> m_chatEntries;
+    QHash<QString, ChatId> m_chatIds;
+    quint64 m_totalLength = 0;
+    int m_deadChats = 0;
+};
+
+} // namespace QodeAssist::Session
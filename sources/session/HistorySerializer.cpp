@@ -5,6 +5,7 @@
 #include "session/HistorySerializer.hpp"
 
 #include <QJsonArray>
+#include <QJsonDocument>
 
 #include "session/HistoryProjection.hpp"
 
@@ -254,6 +255,97 @@ MessageRow legacyRowFromJson(const QJsonObject &json)
     return row;
 }
 
+constexpr int kJournalFormat = 1;
+
+QByteArray journalLine(const QJsonObject &record)
+{
+    return QJsonDocument(record).toJson(QJsonDocument::Compact) + '\n';
+}
+
+QByteArray messageRecord(qsizetype index, const Message &message)
+{
+    return journalLine(
+        {{"op", "message"}, {"index", qint64(index)}, {"message", messageToJson(message)}});
+}
+
+// Only the blocks from the first one that changed are written when the rest of the message is
+// the same, so a long agentic answer that keeps growing is not written out again every time.
+QByteArray messageChangeRecord(qsizetype index, const Message &written, const Message &message)
+{
+    if (written == message)
+        return {};
+    if (written.role != message.role || written.id != message.id
+        || written.usage != message.usage) {
+        return messageRecord(index, message);
+    }
+
+    qsizetype from = 0;
+    while (from < written.blocks.size() && from < message.blocks.size()
+           && written.blocks.at(from) == message.blocks.at(from)) {
+        ++from;
+    }
+    if (from == 0)
+        return messageRecord(index, message);
+
+    QJsonArray blocks;
+    for (qsizetype i = from; i < message.blocks.size(); ++i)
+        blocks.append(blockToJson(message.blocks.at(i)));
+    return journalLine(
+        {{"op", "blocks"}, {"index", qint64(index)}, {"from", qint64(from)}, {"blocks", blocks}});
+}
+
+bool applyJournalRecord(const QJsonObject &record, QJsonArray &messages, QJsonObject &meta)
+{
+    const QString op = record["op"].toString();
+    const qsizetype index = record["index"].toInteger(-1);
+
+    if (op == QLatin1String("message")) {
+        if (index < 0 || index > messages.size() || !record["message"].isObject())
+            return false;
+        if (index == messages.size())
+            messages.append(record["message"]);
+        else
+            messages.replace(index, record["message"]);
+        return true;
+    }
+
+    if (op == QLatin1String("blocks")) {
+        const qsizetype from = record["from"].toInteger(-1);
+        if (index < 0 || index >= messages.size() || !record["blocks"].isArray())
+            return false;
+
+        QJsonObject message = messages.at(index).toObject();
+        QJsonArray blocks = message["blocks"].toArray();
+        if (from < 0 || from > blocks.size())
+            return false;
+        while (blocks.size() > from)
+            blocks.removeLast();
+        for (const QJsonValue &block : record["blocks"].toArray())
+            blocks.append(block);
+        message["blocks"] = blocks;
+        messages.replace(index, message);
+        return true;
+    }
+
+    if (op == QLatin1String("truncate")) {
+        const qsizetype size = record["size"].toInteger(-1);
+        if (size < 0 || size > messages.size())
+            return false;
+        while (messages.size() > size)
+            messages.removeLast();
+        return true;
+    }
+
+    if (op == QLatin1String("meta")) {
+        if (!record["values"].isObject())
+            return false;
+        meta = record["values"].toObject();
+        return true;
+    }
+
+    return false;
+}
+
 ConversationHistory historyFromLegacyJson(const QJsonObject &root)
 {
     QList<MessageRow> rows;
@@ -316,4 +408,109 @@ std::optional<ConversationHistory> HistorySerializer::fromJson(
     return history;
 }
 
+bool HistorySerializer::isJournal(const QByteArray &data)
+{
+    const qsizetype headerEnd = data.indexOf('\n');
+    if (headerEnd < 0)
+        return false;
+
+    const QJsonDocument header = QJsonDocument::fromJson(data.left(headerEnd));
+    return header.isObject() && header.object().contains("journal");
+}
+
+QByteArray HistorySerializer::toJournal(const ConversationHistory &history, const QJsonObject &meta)
+{
+    QByteArray journal = journalLine({{"journal", kJournalFormat}, {"version", currentVersion()}});
+    if (!meta.isEmpty())
+        journal += journalMetaRecord(meta);
+    journal += journalRecords({}, history);
+    return journal;
+}
+
+QByteArray HistorySerializer::journalRecords(
+    const ConversationHistory &written, const ConversationHistory &history)
+{
+    const QList<Message> &before = written.messages();
+    const QList<Message> &after = history.messages();
+
+    qsizetype unchanged = 0;
+    while (unchanged < before.size() && unchanged < after.size()
+           && before.at(unchanged) == after.at(unchanged)) {
+        ++unchanged;
+    }
+
+    QByteArray records;
+    if (after.size() < before.size())
+        records += journalLine({{"op", "truncate"}, {"size", qint64(after.size())}});
+
+    for (qsizetype index = unchanged; index < after.size(); ++index) {
+        if (index < before.size())
+            records += messageChangeRecord(index, before.at(index), after.at(index));
+        else
+            records += messageRecord(index, after.at(index));
+    }
+    return records;
+}
+
+QByteArray HistorySerializer::journalMetaRecord(const QJsonObject &meta)
+{
+    return journalLine({{"op", "meta"}, {"values", meta}});
+}
+
+std::optional<HistorySerializer::JournalReplay> HistorySerializer::replayJournal(
+    const QByteArray &data)
+{
+    const qsizetype headerEnd = data.indexOf('\n');
+    if (headerEnd < 0)
+        return std::nullopt;
+
+    const QJsonObject header = QJsonDocument::fromJson(data.left(headerEnd)).object();
+    if (header["journal"].toInt() != kJournalFormat
+        || header["version"].toString() != currentVersion()) {
+        return std::nullopt;
+    }
+
+    JournalReplay replay;
+    QJsonArray messages;
+    QJsonObject meta;
+
+    qsizetype offset = headerEnd + 1;
+    replay.validLength = offset;
+    while (offset < data.size()) {
+        const qsizetype lineEnd = data.indexOf('\n', offset);
+        if (lineEnd < 0) {
+            replay.recoveredTail = true;
+            break;
+        }
+
+        QJsonParseError error;
+        const QJsonDocument record
+            = QJsonDocument::fromJson(data.sliced(offset, lineEnd - offset), &error);
+        if (error.error != QJsonParseError::NoError || !record.isObject()
+            || !applyJournalRecord(record.object(), messages, meta)) {
+            replay.recoveredTail = true;
+            break;
+        }
+
+        offset = lineEnd + 1;
+        replay.validLength = offset;
+    }
+
+    replay.root = meta;
+    replay.root["version"] = currentVersion();
+    replay.root["messages"] = messages;
+    return replay;
+}
+
+QJsonObject HistorySerializer::readRoot(const QByteArray &data)
+{
+    if (isJournal(data)) {
+        const auto replay = replayJournal(data);
+        return replay ? replay->root : QJsonObject{};
+    }
+
+    const QJsonDocument doc = QJsonDocument::fromJson(data);
+    return doc.isObject() ? doc.object() : QJsonObject{};
+}
+
 } // namespace QodeAssist::Session
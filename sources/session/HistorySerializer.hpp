@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <QByteArray>
 #include <QJsonObject>
 #include <QString>
 
@@ -22,6 +23,30 @@ public:
     static QJsonObject toJson(const ConversationHistory &history);
     static std::optional<ConversationHistory> fromJson(
         const QJsonObject &root, int *droppedBlocks = nullptr);
+
+    // A chat can also be kept as a journal: a header line, then one compact JSON record per line,
+    // each taking the history one change further. Records only ever get appended, so a crash can
+    // at worst leave the last one incomplete.
+    static bool isJournal(const QByteArray &data);
+    static QByteArray toJournal(const ConversationHistory &history, const QJsonObject &meta = {});
+    static QByteArray journalRecords(
+        const ConversationHistory &written, const ConversationHistory &history);
+    // Replaces the top-level keys stored next to the messages, such as the agent binding.
+    static QByteArray journalMetaRecord(const QJsonObject &meta);
+
+    struct JournalReplay
+    {
+        // The history as toJson() writes it, with the recorded meta keys alongside.
+        QJsonObject root;
+        // Bytes up to the end of the last complete record.
+        qsizetype validLength = 0;
+        // An incomplete or unreadable record at the end was left out.
+        bool recoveredTail = false;
+    };
+    static std::optional<JournalReplay> replayJournal(const QByteArray &data);
+
+    // The root object of a chat file in either format; empty when it cannot be read.
+    static QJsonObject readRoot(const QByteArray &data);
 };
 
 } // namespace QodeAssist::Session
@@ -52,6 +52,15 @@ Message truncateMessage(const Message &message, qsizetype rowsWanted)
     return truncated;
 }
 
+// Length of the text without its trailing whitespace.
+qsizetype visibleLength(const QString &text)
+{
+    qsizetype end = text.size();
+    while (end > 0 && text.at(end - 1).isSpace())
+        --end;
+    return end;
+}
+
 bool continuesThinking(const ThinkingBlock &block, const ThinkingReceived &event)
 {
     return !block.redacted && !event.redacted && event.text.startsWith(block.text)
@@ -387,10 +396,13 @@ void Session::applyToolCall(const ToolCallUpdated &update)
 
     m_textSegment.clear();
 
+    bool droppedText = false;
     if (update.dropPrecedingText && !assistant->blocks.isEmpty()
         && std::get_if<TextBlock>(&assistant->blocks.last())) {
         assistant->blocks.removeLast();
+        droppedText = true;
     }
+    const qsizetype blocksBefore = assistant->blocks.size();
 
     const ToolCallBlock appended{
         .id = update.toolId,
@@ -410,7 +422,10 @@ void Session::applyToolCall(const ToolCallUpdated &update)
         assistant->blocks.append(*edit);
     }
 
-    syncAssistantRows();
+    if (droppedText)
+        syncAssistantRows();
+    else
+        appendAssistantRows(blocksBefore);
 
     for (const RecordedAgentEdit &edit : recorded) {
         emit agentFileEditRecorded(
@@ -442,7 +457,7 @@ void Session::applyAgentPlan(const PlanUpdated &plan)
 
     m_textSegment.clear();
     assistant->blocks.append(PlanBlock{plan.entries});
-    syncAssistantRows();
+    appendAssistantRows(assistant->blocks.size() - 1);
 }
 
 void Session::applyPermissionRequest(const PermissionRequested &request)
@@ -613,29 +628,7 @@ void Session::handleEvent(const SessionEvent &event)
         return;
 
     if (const auto *delta = std::get_if<TextDelta>(&event)) {
-        m_textSegment += delta->text;
-
-        if (!m_textSegment.isEmpty() && m_textSegment.at(0).isSpace()) {
-            qsizetype content = 0;
-            while (content < m_textSegment.size() && m_textSegment.at(content).isSpace())
-                ++content;
-            m_textSegment.remove(0, content);
-        }
-
-        if (m_textSegment.isEmpty())
-            return;
-
-        const QString text = m_textSegment.trimmed();
-
-        mutateAssistantTail([&text](Message &message) {
-            if (!message.blocks.isEmpty()) {
-                if (auto *last = std::get_if<TextBlock>(&message.blocks.last())) {
-                    last->text = text;
-                    return;
-                }
-            }
-            message.blocks.append(TextBlock{text});
-        });
+        appendAssistantText(delta->text);
     } else if (const auto *thinking = std::get_if<ThinkingReceived>(&event)) {
         m_textSegment.clear();
         mutateAssistantTail([thinking](Message &message) {
@@ -672,6 +665,60 @@ void Session::handleEvent(const SessionEvent &event)
     }
 }
 
+void Session::appendAssistantText(const QString &delta)
+{
+    const qsizetype shownBefore = m_textSegment.isEmpty() ? -1 : visibleLength(m_textSegment);
+    m_textSegment += delta;
+
+    if (!m_textSegment.isEmpty() && m_textSegment.at(0).isSpace()) {
+        qsizetype content = 0;
+        while (content < m_textSegment.size() && m_textSegment.at(content).isSpace())
+            ++content;
+        m_textSegment.remove(0, content);
+    }
+
+    if (m_textSegment.isEmpty())
+        return;
+
+    ensureAssistantMessage();
+    Message *assistant = activeAssistantMessage();
+    if (!assistant)
+        return;
+
+    // Trailing whitespace is held back until text follows it, as the finished block is trimmed.
+    const qsizetype shown = visibleLength(m_textSegment);
+    auto *last = assistant->blocks.isEmpty() ? nullptr
+                                             : std::get_if<TextBlock>(&assistant->blocks.last());
+    if (!last) {
+        const qsizetype blocksBefore = assistant->blocks.size();
+        assistant->blocks.append(TextBlock{m_textSegment.left(shown)});
+        appendAssistantRows(blocksBefore);
+        return;
+    }
+
+    // A segment that was already streaming is shown in full by the last block and its row, so
+    // the new text is appended to both rather than projecting the block again.
+    const int index = static_cast<int>(m_rows.size()) - 1;
+    const bool rowFollows = shownBefore >= 0 && shownBefore == last->text.size()
+                            && index >= m_assistantRowStart
+                            && m_rows.at(index).kind == RowKind::Assistant
+                            && m_rows.at(index).id == assistant->id
+                            && m_rows.at(index).content.size() == shownBefore;
+    if (!rowFollows) {
+        last->text = m_textSegment.left(shown);
+        updateLastAssistantRow();
+        return;
+    }
+
+    if (shown == shownBefore)
+        return;
+
+    const QStringView added = QStringView(m_textSegment).mid(shownBefore, shown - shownBefore);
+    last->text.append(added);
+    m_rows[index].content.append(added);
+    emit rowUpdated(index, m_rows.at(index));
+}
+
 void Session::appendMessage(const Message &message)
 {
     m_history.append(message);
@@ -726,10 +773,42 @@ void Session::mutateAssistantTail(const std::function<void(Message &)> &mutate)
 
     if (assistant->blocks.size() == blocksBefore)
         updateLastAssistantRow();
+    else if (assistant->blocks.size() > blocksBefore)
+        appendAssistantRows(blocksBefore);
     else
         syncAssistantRows();
 }
 
+void Session::appendAssistantRows(qsizetype firstBlock)
+{
+    const Message *assistant = activeAssistantMessage();
+    if (!assistant)
+        return;
+
+    // Usage goes to the first row that can show it, which a row added now might be; attachments
+    // and images join an earlier text row instead of adding one.
+    if (!assistant->usage.isEmpty()) {
+        syncAssistantRows();
+        return;
+    }
+
+    QList<MessageRow> added;
+    for (qsizetype i = firstBlock; i < assistant->blocks.size(); ++i) {
+        auto row = projectBlockToRow(*assistant, assistant->blocks.at(i));
+        if (!row) {
+            syncAssistantRows();
+            return;
+        }
+        added.append(std::move(*row));
+    }
+
+    if (added.isEmpty())
+        return;
+
+    m_rows.append(added);
+    emit rowsAppended(added);
+}
+
 void Session::updateLastAssistantRow()
 {
     const Message *assistant = activeAssistantMessage();
@@ -77,6 +77,8 @@ private:
     std::optional<PermissionBlock> permissionBlock(const QString &requestId) const;
     QString autoAnswerOptionFor(const PermissionRequested &request) const;
     void appendMessage(const Message &message);
+    void appendAssistantText(const QString &delta);
+    void appendAssistantRows(qsizetype firstBlock);
     Message *activeAssistantMessage();
     void mutateAssistant(const std::function<void(Message &)> &mutate);
     void mutateAssistantTail(const std::function<void(Message &)> &mutate);
@@ -36,6 +36,21 @@ CodeCompletionSettings::CodeCompletionSettings()
     multiLineCompletion.setDefaultValue(true);
     multiLineCompletion.setLabelText(Tr::tr("Enable Multiline Completion"));
 
+    streamCompletion.setSettingsKey(Constants::CC_STREAM_COMPLETION);
+    streamCompletion.setDefaultValue(true);
+    streamCompletion.setLabelText(Tr::tr("Show suggestion while it is being generated"));
+    streamCompletion.setToolTip(
+        Tr::tr("Grow the suggestion as the model streams it instead of waiting for the complete "
+               "response. Responses wrapped in code blocks are still shown once complete."));
+
+    speculativeCompletion.setSettingsKey(Constants::CC_SPECULATIVE_COMPLETION);
+    speculativeCompletion.setDefaultValue(false);
+    speculativeCompletion.setLabelText(Tr::tr("Request the next suggestion once one is accepted"));
+    speculativeCompletion.setToolTip(
+        Tr::tr("Send a new completion request as soon as a suggestion has been fully accepted, "
+               "without waiting for more typing. The request is cancelled if the cursor moves "
+               "away. Not used in agentic modes."));
+
     modelOutputHandler.setLabelText(Tr::tr("Text output proccessing mode:"));
     modelOutputHandler.setSettingsKey(Constants::CC_MODEL_OUTPUT_HANDLER);
     modelOutputHandler.setDisplayStyle(Utils::SelectionAspect::DisplayStyle::ComboBox);
@@ -137,6 +152,23 @@ CodeCompletionSettings::CodeCompletionSettings()
     startSuggestionTimer.setRange(10, 10000);
     startSuggestionTimer.setDefaultValue(350);
 
+    adaptiveDebounce.setSettingsKey(Constants::CC_ADAPTIVE_DEBOUNCE);
+    adaptiveDebounce.setLabelText(Tr::tr("Adapt delay to typing speed and provider latency"));
+    adaptiveDebounce.setToolTip(
+        Tr::tr("Learn the usual pause between keystrokes and the recent response times of the "
+               "provider, and use them instead of the fixed delay. The fixed delay is used until "
+               "enough typing has been seen.\n"
+               "(Only for Automatic trigger mode)"));
+    adaptiveDebounce.setDefaultValue(false);
+
+    maxConcurrentRequests.setSettingsKey(Constants::CC_MAX_CONCURRENT_REQUESTS);
+    maxConcurrentRequests.setLabelText(Tr::tr("Max concurrent completion requests:"));
+    maxConcurrentRequests.setToolTip(
+        Tr::tr("Completion requests running at once across all editors. Further requests wait "
+               "until one finishes and are dropped if the cursor has moved by then."));
+    maxConcurrentRequests.setRange(1, 16);
+    maxConcurrentRequests.setDefaultValue(2);
+
     autoCompletionCharThreshold.setSettingsKey(Constants::СС_AUTO_COMPLETION_CHAR_THRESHOLD);
     autoCompletionCharThreshold.setLabelText(Tr::tr("AI suggestion triggers after typing"));
     autoCompletionCharThreshold.setToolTip(
@@ -229,6 +261,27 @@ CodeCompletionSettings::CodeCompletionSettings()
     readStringsAfterCursor.setRange(0, 10000);
     readStringsAfterCursor.setDefaultValue(30);
 
+    useContextTokenBudget.setSettingsKey(Constants::CC_USE_CONTEXT_TOKEN_BUDGET);
+    useContextTokenBudget.setLabelText(Tr::tr("Fit Context to Token Budget:"));
+    useContextTokenBudget.setDefaultValue(false);
+    useContextTokenBudget.setToolTip(
+        Tr::tr("Grow the context outward from the cursor line by line until the estimated "
+               "token budget is used, instead of reading a fixed number of lines"));
+
+    contextTokenBudget.setSettingsKey(Constants::CC_CONTEXT_TOKEN_BUDGET);
+    contextTokenBudget.setLabelText(Tr::tr("Tokens:"));
+    contextTokenBudget.setRange(64, 1000000);
+    contextTokenBudget.setDefaultValue(2048);
+
+    contextPrefixShare.setSettingsKey(Constants::CC_CONTEXT_PREFIX_SHARE);
+    contextPrefixShare.setLabelText(Tr::tr("Share Before Cursor (%):"));
+    contextPrefixShare.setToolTip(
+        Tr::tr("Part of the token budget spent on code before the cursor; the rest goes to code "
+               "after it. Budget left unused at the start or end of the file goes to the other "
+               "side."));
+    contextPrefixShare.setRange(0, 100);
+    contextPrefixShare.setDefaultValue(75);
+
     useSystemPrompt.setSettingsKey(Constants::CC_USE_SYSTEM_PROMPT);
     useSystemPrompt.setDefaultValue(true);
     useSystemPrompt.setLabelText(Tr::tr("Use System Prompt"));
@@ -341,7 +394,7 @@ CodeCompletionSettings::CodeCompletionSettings()
 
     migrateCompletionMode();
 
-    readFileParts.setValue(!readFullFile.value());
+    readFileParts.setValue(!readFullFile.value() && !useContextTokenBudget.value());
 
     setupConnections();
 
@@ -368,6 +421,7 @@ CodeCompletionSettings::CodeCompletionSettings()
         auto contextGrid = Grid{};
         contextGrid.addRow({Row{readFullFile}});
         contextGrid.addRow({Row{readFileParts, readStringsBeforeCursor, readStringsAfterCursor}});
+        contextGrid.addRow({Row{useContextTokenBudget, contextTokenBudget, contextPrefixShare}});
 
         auto contextItem = Column{
             Row{contextGrid, Stretch{1}},
@@ -385,10 +439,13 @@ CodeCompletionSettings::CodeCompletionSettings()
         auto generalSettings = Column{
             autoCompletion,
             multiLineCompletion,
+            streamCompletion,
+            speculativeCompletion,
             Row{modelOutputHandler, Stretch{1}},
             Row{triggerMode, Stretch{1}},
             Row{completionMode, Stretch{1}},
             Row{completionAgentId, Stretch{1}},
+            Row{maxConcurrentRequests, Stretch{1}},
             showProgressWidget,
             useOpenFilesContext,
             respectQtcPopup,
@@ -401,7 +458,8 @@ CodeCompletionSettings::CodeCompletionSettings()
             Row{autoCompletionCharThreshold,
                 autoCompletionTypingInterval,
                 startSuggestionTimer,
-                Stretch{1}}};
+                Stretch{1}},
+            adaptiveDebounce};
 
         return Column{Row{Stretch{1}, resetToDefaults},
                       Space{8},
@@ -438,6 +496,7 @@ void CodeCompletionSettings::setupConnections()
     connect(&readFullFile, &Utils::BoolAspect::volatileValueChanged, this, [this]() {
         if (readFullFile.volatileValue()) {
             readFileParts.setValue(false);
+            useContextTokenBudget.setValue(false);
             writeSettings();
         }
     });
@@ -445,6 +504,15 @@ void CodeCompletionSettings::setupConnections()
     connect(&readFileParts, &Utils::BoolAspect::volatileValueChanged, this, [this]() {
         if (readFileParts.volatileValue()) {
             readFullFile.setValue(false);
+            useContextTokenBudget.setValue(false);
+            writeSettings();
+        }
+    });
+
+    connect(&useContextTokenBudget, &Utils::BoolAspect::volatileValueChanged, this, [this]() {
+        if (useContextTokenBudget.volatileValue()) {
+            readFullFile.setValue(false);
+            readFileParts.setValue(false);
             writeSettings();
         }
     });
@@ -462,6 +530,8 @@ void CodeCompletionSettings::resetSettingsToDefaults()
     if (reply == QMessageBox::Yes) {
         resetAspect(autoCompletion);
         resetAspect(multiLineCompletion);
+        resetAspect(streamCompletion);
+        resetAspect(speculativeCompletion);
         resetAspect(temperature);
         resetAspect(maxTokens);
         resetAspect(useTopP);
@@ -476,6 +546,9 @@ void CodeCompletionSettings::resetSettingsToDefaults()
         resetAspect(readFileParts);
         resetAspect(readStringsBeforeCursor);
         resetAspect(readStringsAfterCursor);
+        resetAspect(useContextTokenBudget);
+        resetAspect(contextTokenBudget);
+        resetAspect(contextPrefixShare);
         resetAspect(useSystemPrompt);
         resetAspect(systemPrompt);
         resetAspect(ollamaLivetime);
@@ -497,6 +570,8 @@ void CodeCompletionSettings::resetSettingsToDefaults()
         resetAspect(cancelOnInput);
         resetAspect(ignoreWhitespaceInCharCount);
         resetAspect(abortAssistOnRequest);
+        resetAspect(adaptiveDebounce);
+        resetAspect(maxConcurrentRequests);
         writeSettings();
     }
 }
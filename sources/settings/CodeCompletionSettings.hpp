@@ -20,6 +20,8 @@ public:
     // Auto Completion Settings
     Utils::BoolAspect autoCompletion{this};
     Utils::BoolAspect multiLineCompletion{this};
+    Utils::BoolAspect streamCompletion{this};
+    Utils::BoolAspect speculativeCompletion{this};
     Utils::SelectionAspect modelOutputHandler{this};
     Utils::SelectionAspect completionTriggerMode{this};
     Utils::SelectionAspect triggerMode{this};
@@ -30,6 +32,8 @@ public:
     Utils::BoolAspect cancelOnInput{this};
 
     Utils::IntegerAspect startSuggestionTimer{this};
+    Utils::BoolAspect adaptiveDebounce{this};
+    Utils::IntegerAspect maxConcurrentRequests{this};
     Utils::IntegerAspect autoCompletionCharThreshold{this};
     Utils::IntegerAspect autoCompletionTypingInterval{this};
     Utils::BoolAspect ignoreWhitespaceInCharCount{this};
@@ -62,6 +66,9 @@ public:
     Utils::BoolAspect readFileParts{this};
     Utils::IntegerAspect readStringsBeforeCursor{this};
     Utils::IntegerAspect readStringsAfterCursor{this};
+    Utils::BoolAspect useContextTokenBudget{this};
+    Utils::IntegerAspect contextTokenBudget{this};
+    Utils::IntegerAspect contextPrefixShare{this};
     Utils::BoolAspect useSystemPrompt{this};
     Utils::StringAspect systemPrompt{this};
     Utils::BoolAspect useUserMessageTemplateForCC{this};
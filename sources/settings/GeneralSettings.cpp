@@ -48,6 +48,28 @@ void addDialogButtons(QBoxLayout *layout, QAbstractButton *okButton, QAbstractBu
 #endif
 }
 
+namespace {
+
+QString logFilePath()
+{
+    return QString("%1/qodeassist/logs/qodeassist.log")
+        .arg(Core::ICore::userResourcePath().toFSPathString());
+}
+
+void configureLogger(bool enabled, bool verbose, bool toFile)
+{
+    auto &logger = Logger::instance();
+    logger.setLoggingEnabled(enabled);
+    logger.setDebugCategories(
+        verbose ? LogCategories(
+                      LogCategory::General | LogCategory::Completion | LogCategory::Chat
+                      | LogCategory::Context | LogCategory::Tools)
+                : LogCategories());
+    logger.setLogFile(enabled && toFile ? logFilePath() : QString());
+}
+
+} // namespace
+
 GeneralSettings &generalSettings()
 {
     static GeneralSettings settings;
@@ -69,6 +91,20 @@ GeneralSettings::GeneralSettings()
     enableLogging.setToolTip(TrConstants::ENABLE_LOG_TOOLTIP);
     enableLogging.setDefaultValue(false);
 
+    verboseLogging.setSettingsKey(Constants::VERBOSE_LOGGING);
+    verboseLogging.setLabelText(Tr::tr("Verbose"));
+    verboseLogging.setToolTip(
+        Tr::tr("Also log detailed traces such as full completion text and every step of applying "
+               "file edits. Useful for bug reports; slows down busy code paths."));
+    verboseLogging.setDefaultValue(false);
+
+    logToFile.setSettingsKey(Constants::LOG_TO_FILE);
+    logToFile.setLabelText(Tr::tr("Write to file"));
+    logToFile.setToolTip(Tr::tr("Also write the log to %1. The file is rotated at 5 MB, keeping "
+                                "the three previous files.")
+                             .arg(logFilePath()));
+    logToFile.setDefaultValue(false);
+
     enableCheckUpdate.setSettingsKey(Constants::ENABLE_CHECK_UPDATE);
     enableCheckUpdate.setLabelText(TrConstants::ENABLE_CHECK_UPDATE_ON_START);
     enableCheckUpdate.setDefaultValue(true);
@@ -84,6 +120,19 @@ GeneralSettings::GeneralSettings()
     requestTimeout.setRange(0, 3600);
     requestTimeout.setDefaultValue(120);
 
+    tokenizersPath.setSettingsKey(Constants::TOKENIZERS_PATH);
+    tokenizersPath.setExpectedKind(Utils::PathChooser::ExistingDirectory);
+    tokenizersPath.setLabelText(Tr::tr("Tokenizer vocabularies:"));
+    tokenizersPath.setToolTip(Tr::tr(
+        "Directory with tokenizer vocabularies used to count tokens for context budgets and the "
+        "chat token counter. Files are looked up by model family: cl100k_base.tiktoken, "
+        "o200k_base.tiktoken, llama3.tiktoken, qwen.tiktoken, or <family>.json / "
+        "<family>/tokenizer.json exported by Hugging Face. default.tiktoken is used for models "
+        "without a matching file. Without any vocabulary tokens are estimated as 4 characters "
+        "each."));
+    tokenizersPath.setDefaultValue(
+        QString("%1/qodeassist/tokenizers").arg(Core::ICore::userResourcePath().toFSPathString()));
+
     resetToDefaults.m_buttonText = TrConstants::RESET_TO_DEFAULTS;
     checkUpdate.m_buttonText = TrConstants::CHECK_UPDATE;
     
@@ -284,7 +333,7 @@ GeneralSettings::GeneralSettings()
     migrateProviderAspect(qrProvider);
     writeSettings();
 
-    Logger::instance().setLoggingEnabled(enableLogging());
+    configureLogger(enableLogging(), verboseLogging(), logToFile());
 
     setupConnections();
 
@@ -348,6 +397,10 @@ GeneralSettings::GeneralSettings()
             title(Tr::tr("Network")),
             Column{Row{requestTimeout, Stretch{1}}}};
 
+        auto tokenCountingGroup = Group{
+            title(Tr::tr("Token Counting")),
+            Column{Row{tokenizersPath}}};
+
         auto *supportLabel = new QLabel(Tr::tr("Support the development of QodeAssist:"));
 
         auto *supportLinks = new QLabel(
@@ -366,11 +419,13 @@ GeneralSettings::GeneralSettings()
             Row{supportLabel, supportLinks, Stretch{1}, checkUpdate, resetToDefaults},
             Space{8},
             Row{enableQodeAssist, Stretch{1}},
-            Row{enableLogging, Stretch{1}},
+            Row{enableLogging, verboseLogging, logToFile, Stretch{1}},
             Row{enableCheckUpdate, Stretch{1}},
             Space{8},
             networkGroup,
             Space{8},
+            tokenCountingGroup,
+            Space{8},
             ccGroup,
             Space{8},
             caGroup,
@@ -591,9 +646,15 @@ void GeneralSettings::updatePreset1Visiblity(bool state)
 
 void GeneralSettings::setupConnections()
 {
-    connect(&enableLogging, &Utils::BoolAspect::volatileValueChanged, this, [this]() {
-        Logger::instance().setLoggingEnabled(enableLogging.volatileValue());
-    });
+    const auto updateLogger = [this]() {
+        configureLogger(
+            enableLogging.volatileValue(),
+            verboseLogging.volatileValue(),
+            logToFile.volatileValue());
+    };
+    connect(&enableLogging, &Utils::BoolAspect::volatileValueChanged, this, updateLogger);
+    connect(&verboseLogging, &Utils::BoolAspect::volatileValueChanged, this, updateLogger);
+    connect(&logToFile, &Utils::BoolAspect::volatileValueChanged, this, updateLogger);
     connect(&resetToDefaults, &ButtonAspect::clicked, this, &GeneralSettings::resetPageToDefaults);
     connect(&checkUpdate, &ButtonAspect::clicked, this, [this]() {
         QodeAssist::UpdateDialog::checkForUpdatesAndShow(Core::ICore::dialogParent());
@@ -696,7 +757,10 @@ void GeneralSettings::resetPageToDefaults()
     if (reply == QMessageBox::Yes) {
         resetAspect(enableQodeAssist);
         resetAspect(enableLogging);
+        resetAspect(verboseLogging);
+        resetAspect(logToFile);
         resetAspect(requestTimeout);
+        resetAspect(tokenizersPath);
         resetAspect(ccProvider);
         resetAspect(ccModel);
         resetAspect(ccTemplate);
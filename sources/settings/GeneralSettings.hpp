@@ -26,10 +26,14 @@ public:
 
     Utils::BoolAspect enableQodeAssist{this};
     Utils::BoolAspect enableLogging{this};
+    Utils::BoolAspect verboseLogging{this};
+    Utils::BoolAspect logToFile{this};
     Utils::BoolAspect enableCheckUpdate{this};
 
     Utils::IntegerAspect requestTimeout{this};
 
+    Utils::FilePathAspect tokenizersPath{this};
+
     ButtonAspect checkUpdate{this};
     ButtonAspect resetToDefaults{this};
 
@@ -59,8 +59,11 @@ const char CC_AUTO_COMPLETION[] = "QodeAssist.ccAutoCompletion";
 const char CC_SHOW_PROGRESS_WIDGET[] = "QodeAssist.ccShowProgressWidget";
 const char CC_USE_OPEN_FILES_CONTEXT[] = "QodeAssist.ccUseOpenFilesContext";
 const char ENABLE_LOGGING[] = "QodeAssist.enableLogging";
+const char VERBOSE_LOGGING[] = "QodeAssist.verboseLogging";
+const char LOG_TO_FILE[] = "QodeAssist.logToFile";
 const char ENABLE_CHECK_UPDATE[] = "QodeAssist.enableCheckUpdate";
 const char REQUEST_TIMEOUT[] = "QodeAssist.requestTimeout";
+const char TOKENIZERS_PATH[] = "QodeAssist.tokenizersPath";
 
 const char PROVIDER_PATHS[] = "QodeAssist.providerPaths";
 const char СС_START_SUGGESTION_TIMER[] = "QodeAssist.startSuggestionTimer";
@@ -81,6 +84,10 @@ const char CC_ABORT_ASSIST_ON_REQUEST[] = "QodeAssist.ccAbortAssistOnRequest";
 const char CC_IGNORE_WHITESPACE_IN_CHAR_COUNT[] = "QodeAssist.ccIgnoreWhitespaceInCharCount";
 const char MAX_FILE_THRESHOLD[] = "QodeAssist.maxFileThreshold";
 const char CC_MULTILINE_COMPLETION[] = "QodeAssist.ccMultilineCompletion";
+const char CC_STREAM_COMPLETION[] = "QodeAssist.ccStreamCompletion";
+const char CC_SPECULATIVE_COMPLETION[] = "QodeAssist.ccSpeculativeCompletion";
+const char CC_ADAPTIVE_DEBOUNCE[] = "QodeAssist.ccAdaptiveDebounce";
+const char CC_MAX_CONCURRENT_REQUESTS[] = "QodeAssist.ccMaxConcurrentRequests";
 const char CC_MODEL_OUTPUT_HANDLER[] = "QodeAssist.ccModelOutputHandler";
 const char CA_AUTO_APPLY_FILE_EDITS[] = "QodeAssist.caAutoApplyFileEdits";
 const char CA_AUTO_COMPRESS[] = "QodeAssist.caAutoCompress";
@@ -98,6 +105,7 @@ const char CA_ENABLE_LIST_PROJECT_FILES_TOOL[] = "QodeAssist.caEnableListProject
 const char CA_ENABLE_FIND_FILE_TOOL[] = "QodeAssist.caEnableFindFileTool";
 const char CA_ENABLE_READ_FILE_TOOL[] = "QodeAssist.caEnableReadFileTool";
 const char CA_ENABLE_PROJECT_SEARCH_TOOL[] = "QodeAssist.caEnableProjectSearchTool";
+const char CA_INDEX_PROJECT_SEARCH[] = "QodeAssist.caIndexProjectSearch";
 const char CA_ENABLE_CREATE_NEW_FILE_TOOL[] = "QodeAssist.caEnableCreateNewFileTool";
 const char CA_ENABLE_GET_ISSUES_LIST_TOOL[] = "QodeAssist.caEnableGetIssuesListTool";
 const char CA_ENABLE_EDIT_FILE_TOOL[] = "QodeAssist.caEnableEditFileToolV2";
@@ -106,6 +114,7 @@ const char CA_ENABLE_TERMINAL_COMMAND_TOOL[] = "QodeAssist.caEnableTerminalComma
 const char CA_ENABLE_TODO_TOOL[] = "QodeAssist.caEnableTodoToolV2";
 const char CA_ENABLE_READ_ORIGINAL_HISTORY_TOOL[]
     = "QodeAssist.caEnableReadOriginalHistoryTool";
+const char CA_ENABLE_SEARCH_CHAT_HISTORY_TOOL[] = "QodeAssist.caEnableSearchChatHistoryTool";
 const char CA_ENABLE_SKILL_TOOL[] = "QodeAssist.caEnableSkillTool";
 const char CA_ALLOWED_TERMINAL_COMMANDS[] = "QodeAssist.caAllowedTerminalCommands";
 const char CA_ALLOWED_TERMINAL_COMMANDS_LINUX[] = "QodeAssist.caAllowedTerminalCommandsLinux";
@@ -178,6 +187,9 @@ const char CLAUDE_USE_EXTENDED_CACHE_TTL[] = "QodeAssist.claudeUseExtendedCacheT
 const char CC_READ_FULL_FILE[] = "QodeAssist.ccReadFullFile";
 const char CC_READ_STRINGS_BEFORE_CURSOR[] = "QodeAssist.ccReadStringsBeforeCursor";
 const char CC_READ_STRINGS_AFTER_CURSOR[] = "QodeAssist.ccReadStringsAfterCursor";
+const char CC_USE_CONTEXT_TOKEN_BUDGET[] = "QodeAssist.ccUseContextTokenBudget";
+const char CC_CONTEXT_TOKEN_BUDGET[] = "QodeAssist.ccContextTokenBudget";
+const char CC_CONTEXT_PREFIX_SHARE[] = "QodeAssist.ccContextPrefixShare";
 const char CC_USE_SYSTEM_PROMPT[] = "QodeAssist.ccUseSystemPrompt";
 const char CC_SYSTEM_PROMPT[] = "QodeAssist.ccSystemPrompt";
 const char CC_SYSTEM_PROMPT_FOR_NON_FIM[] = "QodeAssist.ccSystemPromptForNonFim";
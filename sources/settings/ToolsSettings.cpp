@@ -50,6 +50,15 @@ ToolsSettings::ToolsSettings()
     maxToolContinuations.setRange(1, 100);
     maxToolContinuations.setDefaultValue(30);
 
+    indexProjectSearch.setSettingsKey(Constants::CA_INDEX_PROJECT_SEARCH);
+    indexProjectSearch.setLabelText(Tr::tr("Index project files and symbols for search"));
+    indexProjectSearch.setToolTip(
+        Tr::tr("Keeps a trigram index of open project files and a C++ symbol name index in "
+               "memory so \"Search in Project\" only scans files that can contain the query and "
+               "looks symbols up without walking the code model. Indexing runs in the background; "
+               "files that are not indexed yet are still searched."));
+    indexProjectSearch.setDefaultValue(true);
+
     enableListProjectFilesTool.setSettingsKey(Constants::CA_ENABLE_LIST_PROJECT_FILES_TOOL);
     enableListProjectFilesTool.setLabelText(Tr::tr("List Project Files"));
     enableListProjectFilesTool.setToolTip(
@@ -120,6 +129,13 @@ ToolsSettings::ToolsSettings()
                "summary currently in context. Has no effect if the chat was never compressed."));
     enableReadOriginalHistoryTool.setDefaultValue(true);
 
+    enableSearchChatHistoryTool.setSettingsKey(Constants::CA_ENABLE_SEARCH_CHAT_HISTORY_TOOL);
+    enableSearchChatHistoryTool.setLabelText(Tr::tr("Search Chat History"));
+    enableSearchChatHistoryTool.setToolTip(
+        Tr::tr("Lets the AI search the chats saved in the chat history folder, to find earlier "
+               "discussions, decisions and edited files."));
+    enableSearchChatHistoryTool.setDefaultValue(true);
+
     enableSkillTool.setSettingsKey(Constants::CA_ENABLE_SKILL_TOOL);
     enableSkillTool.setLabelText(Tr::tr("Load Skill"));
     enableSkillTool.setToolTip(
@@ -201,6 +217,7 @@ ToolsSettings::ToolsSettings()
                     enableTerminalCommandTool,
                     enableTodoTool,
                     enableReadOriginalHistoryTool,
+                    enableSearchChatHistoryTool,
                     enableSkillTool}},
             Space{8},
             Group{
@@ -208,6 +225,7 @@ ToolsSettings::ToolsSettings()
                 Column{
                     allowAccessOutsideProject,
                     Row{maxToolContinuations, Stretch{1}},
+                    indexProjectSearch,
                     Space{4},
                     Group{
                         title(Tr::tr("Edit File")),
@@ -241,6 +259,7 @@ void ToolsSettings::resetSettingsToDefaults()
         resetAspect(allowAccessOutsideProject);
         resetAspect(autoApplyFileEdits);
         resetAspect(maxToolContinuations);
+        resetAspect(indexProjectSearch);
         resetAspect(enableListProjectFilesTool);
         resetAspect(enableFindFileTool);
         resetAspect(enableReadFileTool);
@@ -252,6 +271,7 @@ void ToolsSettings::resetSettingsToDefaults()
         resetAspect(enableTerminalCommandTool);
         resetAspect(enableTodoTool);
         resetAspect(enableReadOriginalHistoryTool);
+        resetAspect(enableSearchChatHistoryTool);
         resetAspect(enableSkillTool);
         resetAspect(allowedTerminalCommandsLinux);
         resetAspect(allowedTerminalCommandsMacOS);
@@ -20,6 +20,7 @@ public:
     Utils::BoolAspect allowAccessOutsideProject{this};
     Utils::BoolAspect autoApplyFileEdits{this};
     Utils::IntegerAspect maxToolContinuations{this};
+    Utils::BoolAspect indexProjectSearch{this};
 
     Utils::BoolAspect enableListProjectFilesTool{this};
     Utils::BoolAspect enableFindFileTool{this};
@@ -32,6 +33,7 @@ public:
     Utils::BoolAspect enableTerminalCommandTool{this};
     Utils::BoolAspect enableTodoTool{this};
     Utils::BoolAspect enableReadOriginalHistoryTool{this};
+    Utils::BoolAspect enableSearchChatHistoryTool{this};
     Utils::BoolAspect enableSkillTool{this};
 
     Utils::StringAspect allowedTerminalCommandsLinux{this};
@@ -0,0 +1,304 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#include "ChatHistorySearch.hpp"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QSet>
+
+#include <logger/Logger.hpp>
+
+#include <algorithm>
+#include <optional>
+
+#include "HistoryIndexCache.hpp"
+#include "session/HistorySerializer.hpp"
+
+namespace QodeAssist::Tools {
+
+namespace {
+
+// Edits made in place by another instance leave the directory itself unchanged.
+constexpr qint64 kRefreshIntervalMs = 30 * 1000;
+
+qint64 fileStamp(const QFileInfo &info)
+{
+    return info.lastModified().toMSecsSinceEpoch() * 31 + info.size();
+}
+
+QString directoryKey(const QString &directory)
+{
+    return QDir::cleanPath(QFileInfo(directory).absoluteFilePath());
+}
+
+std::optional<Session::ConversationHistory> readHistory(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return std::nullopt;
+
+    const QJsonObject root = Session::HistorySerializer::readRoot(file.readAll());
+    if (root.isEmpty())
+        return std::nullopt;
+    return Session::HistorySerializer::fromJson(root);
+}
+
+} // namespace
+
+ChatHistorySearch &ChatHistorySearch::instance()
+{
+    static ChatHistorySearch search;
+    return search;
+}
+
+ChatHistorySearch::ChatHistorySearch()
+{
+    m_pool.setMaxThreadCount(1);
+}
+
+ChatHistorySearch::~ChatHistorySearch()
+{
+    m_stopping = true;
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+QString ChatHistorySearch::indexFilePath(const QString &directory)
+{
+    return QDir(directory).filePath(".qodeassist_search_index");
+}
+
+void ChatHistorySearch::chatSaved(
+    const QString &filePath, const Session::ConversationHistory &history)
+{
+    if (m_stopping)
+        return;
+
+    // Stamped now, so an edit made before the chat is indexed still shows as a change.
+    const qint64 stamp = fileStamp(QFileInfo(filePath));
+    QMutexLocker locker(&m_queueMutex);
+    const auto pending = std::find_if(
+        m_queue.begin(), m_queue.end(), [&filePath](const PendingChat &chat) {
+            return chat.filePath == filePath;
+        });
+    if (pending != m_queue.end()) {
+        pending->history = history;
+        pending->stamp = stamp;
+    } else {
+        m_queue.append({filePath, history, stamp});
+    }
+
+    if (!m_workerActive) {
+        m_workerActive = true;
+        m_pool.start([this] { processQueue(); });
+    }
+}
+
+QList<ChatHistorySearch::Result> ChatHistorySearch::search(
+    const QString &directory, const QString &query, int limit, int snippetsPerChat)
+{
+    if (Session::HistorySearchIndex::termsOf(query).isEmpty() || limit <= 0)
+        return {};
+
+    const QString key = directoryKey(directory);
+    QList<StaleChat> stale;
+    bool caughtUp = false;
+    {
+        QMutexLocker locker(&m_indexMutex);
+        caughtUp = refresh(key, directoryFor(key), stale);
+    }
+    // Chats are read without the lock, so other searches and saves go on meanwhile.
+    caughtUp |= indexChats(key, stale);
+
+    QMutexLocker locker(&m_indexMutex);
+    QList<Session::HistorySearchIndex::Hit> hits = directoryFor(key).index.search(query, limit);
+    stale.clear();
+    if (verifyHits(hits, directoryFor(key), stale)) {
+        locker.unlock();
+        indexChats(key, stale);
+        locker.relock();
+        hits = directoryFor(key).index.search(query, limit);
+        caughtUp = true;
+    }
+    if (caughtUp)
+        saveDirectory(key, directoryFor(key));
+    locker.unlock();
+
+    QList<Result> results;
+    results.reserve(hits.size());
+    for (const Session::HistorySearchIndex::Hit &hit : std::as_const(hits)) {
+        Result result{
+            .filePath = hit.filePath, .score = hit.score, .matchedTerms = hit.matchedTerms};
+        if (const auto summary = HistoryIndexCache::instance().entry(hit.filePath)) {
+            result.title = summary->title;
+            result.preview = summary->preview;
+            result.messageCount = summary->messageCount;
+            result.modified = summary->modified;
+        }
+        result.snippets = hit.excerpts.mid(0, snippetsPerChat);
+        results.append(result);
+    }
+    return results;
+}
+
+void ChatHistorySearch::shutdown()
+{
+    m_pool.waitForDone();
+    m_stopping = true;
+    m_pool.waitForDone();
+
+    QMutexLocker locker(&m_indexMutex);
+    for (auto it = m_directories.begin(); it != m_directories.end(); ++it)
+        saveDirectory(it.key(), it.value());
+}
+
+ChatHistorySearch::Directory &ChatHistorySearch::directoryFor(const QString &directory)
+{
+    const auto it = m_directories.find(directory);
+    if (it != m_directories.end())
+        return it.value();
+
+    Directory &entry = m_directories[directory];
+    QFile file(indexFilePath(directory));
+    if (file.open(QIODevice::ReadOnly) && !entry.index.deserialize(file.readAll(), directory))
+        LOG_MESSAGE(QString("Chat search index in %1 is unreadable, rebuilding it").arg(directory));
+    return entry;
+}
+
+bool ChatHistorySearch::refresh(const QString &directory, Directory &entry, QList<StaleChat> &stale)
+{
+    // Adding, removing or replacing a chat changes the directory; saves go through a rename.
+    const qint64 directoryStamp = fileStamp(QFileInfo(directory));
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    if (entry.refreshedAt != 0 && directoryStamp == entry.directoryStamp
+        && now - entry.refreshedAt < kRefreshIntervalMs)
+        return false;
+    entry.directoryStamp = directoryStamp;
+    entry.refreshedAt = now;
+
+    const QDir dir(directory);
+    const QFileInfoList files = dir.entryInfoList({"*.json"}, QDir::Files);
+
+    QSet<QString> present;
+    for (const QFileInfo &file : files) {
+        const QString filePath = dir.filePath(file.fileName());
+        present.insert(filePath);
+
+        const qint64 stamp = fileStamp(file);
+        const qint64 indexed = entry.index.stamp(filePath);
+        if (stamp != indexed)
+            stale.append({filePath, stamp, indexed});
+    }
+
+    bool changed = false;
+    for (const QString &filePath : entry.index.chats()) {
+        if (!present.contains(filePath)) {
+            entry.index.removeChat(filePath);
+            changed = true;
+        }
+    }
+
+    if (changed)
+        entry.dirty = true;
+    return changed;
+}
+
+bool ChatHistorySearch::verifyHits(
+    const QList<Session::HistorySearchIndex::Hit> &hits, Directory &entry, QList<StaleChat> &stale)
+{
+    bool changed = false;
+    for (const Session::HistorySearchIndex::Hit &hit : hits) {
+        const QFileInfo info(hit.filePath);
+        const qint64 indexed = entry.index.stamp(hit.filePath);
+        if (!info.isFile()) {
+            entry.index.removeChat(hit.filePath);
+            entry.dirty = true;
+            changed = true;
+        } else if (const qint64 stamp = fileStamp(info); stamp != indexed) {
+            stale.append({hit.filePath, stamp, indexed});
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+bool ChatHistorySearch::indexChats(const QString &directory, const QList<StaleChat> &stale)
+{
+    if (stale.isEmpty())
+        return false;
+
+    // Files that are not chats stay in the index with no words, so they are read only once.
+    QList<Session::HistorySearchIndex::ChatTerms> terms;
+    terms.reserve(stale.size());
+    for (const StaleChat &chat : stale) {
+        const std::optional<Session::ConversationHistory> history = readHistory(chat.filePath);
+        terms.append(
+            history ? Session::HistorySearchIndex::chatTermsOf(*history)
+                    : Session::HistorySearchIndex::ChatTerms{});
+    }
+
+    QMutexLocker locker(&m_indexMutex);
+    Directory &entry = directoryFor(directory);
+    bool changed = false;
+    for (qsizetype i = 0; i < stale.size(); ++i) {
+        // Indexed by a save or another search while this one was reading.
+        if (entry.index.stamp(stale[i].filePath) != stale[i].indexedStamp)
+            continue;
+        entry.index.setChat(stale[i].filePath, stale[i].stamp, terms[i]);
+        changed = true;
+    }
+
+    if (changed)
+        entry.dirty = true;
+    return changed;
+}
+
+void ChatHistorySearch::saveDirectory(const QString &directory, Directory &entry)
+{
+    // Chats saved to a directory that is gone since have nothing left to index.
+    if (!entry.dirty || !QFileInfo(directory).isDir())
+        return;
+
+    QSaveFile file(indexFilePath(directory));
+    if (!file.open(QIODevice::WriteOnly) || file.write(entry.index.serialize()) == -1
+        || !file.commit()) {
+        LOG_MESSAGE(QString("Failed to write the chat search index in %1").arg(directory));
+        return;
+    }
+    entry.dirty = false;
+}
+
+void ChatHistorySearch::processQueue()
+{
+    while (true) {
+        PendingChat chat;
+        {
+            QMutexLocker locker(&m_queueMutex);
+            if (m_stopping || m_queue.isEmpty()) {
+                m_workerActive = false;
+                break;
+            }
+            chat = m_queue.takeFirst();
+        }
+
+        const Session::HistorySearchIndex::ChatTerms terms
+            = Session::HistorySearchIndex::chatTermsOf(chat.history);
+        const QFileInfo info(chat.filePath);
+        if (!info.isFile())
+            continue;
+
+        const QString directory = directoryKey(info.absolutePath());
+        QMutexLocker locker(&m_indexMutex);
+        Directory &entry = directoryFor(directory);
+        entry.index.setChat(QDir(directory).filePath(info.fileName()), chat.stamp, terms);
+        entry.dirty = true;
+    }
+}
+
+} // namespace QodeAssist::Tools
@@ -0,0 +1,120 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+
+#include <atomic>
+
+#include "session/ConversationHistory.hpp"
+#include "session/HistorySearchIndex.hpp"
+
+namespace QodeAssist::Tools {
+
+/**
+ * @brief Full-text search over the chats saved in each history directory.
+ *
+ * Saved chats are indexed on a background thread as they are written. A search brings the index
+ * of its directory up to date with the files on disk when the directory changed or the last
+ * check is older than a while, so chats written by another Qt Creator instance, or before the
+ * index existed, are found too; the chats it is about to return are checked every time. Changed
+ * chats are read without holding the indexes, so saves and other searches go on meanwhile.
+ * Excerpts are cut when a chat is indexed, so a search does not read the chats it finds. Each
+ * directory keeps its index in a file next to the chats, written on shutdown and after a search
+ * had to catch up.
+ */
+class ChatHistorySearch
+{
+public:
+    struct Result
+    {
+        QString filePath;
+        QString title;
+        QString preview;
+        int messageCount = 0;
+        qint64 modified = 0;
+        double score = 0;
+        int matchedTerms = 0;
+        QStringList snippets;
+    };
+
+    static ChatHistorySearch &instance();
+
+    static QString indexFilePath(const QString &directory);
+
+    // Thread-safe. Indexes a chat that has just been written to filePath.
+    void chatSaved(const QString &filePath, const Session::ConversationHistory &history);
+
+    // Thread-safe. The best matching chats in directory, with up to snippetsPerChat excerpts of
+    // the messages that matched.
+    QList<Result> search(
+        const QString &directory, const QString &query, int limit, int snippetsPerChat = 0);
+
+    // Waits for pending indexing and writes out every index that changed.
+    void shutdown();
+
+private:
+    ChatHistorySearch();
+    ~ChatHistorySearch();
+    ChatHistorySearch(const ChatHistorySearch &) = delete;
+    ChatHistorySearch &operator=(const ChatHistorySearch &) = delete;
+
+    struct Directory
+    {
+        Session::HistorySearchIndex index;
+        bool dirty = false;
+        // Stamp of the directory and time of the last full look at its files.
+        qint64 directoryStamp = 0;
+        qint64 refreshedAt = 0;
+    };
+
+    // A chat whose file no longer matches the index, and its stamp in the index when seen.
+    struct StaleChat
+    {
+        QString filePath;
+        qint64 stamp = 0;
+        qint64 indexedStamp = 0;
+    };
+
+    struct PendingChat
+    {
+        QString filePath;
+        Session::ConversationHistory history;
+        qint64 stamp = 0;
+    };
+
+    // Require m_indexMutex. refresh() and verifyHits() drop chats whose files are gone and
+    // collect those that changed, to be read by indexChats() without the lock.
+    Directory &directoryFor(const QString &directory);
+    bool refresh(const QString &directory, Directory &entry, QList<StaleChat> &stale);
+    bool verifyHits(
+        const QList<Session::HistorySearchIndex::Hit> &hits,
+        Directory &entry,
+        QList<StaleChat> &stale);
+    void saveDirectory(const QString &directory, Directory &entry);
+
+    // Takes m_indexMutex itself, only after reading the chats.
+    bool indexChats(const QString &directory, const QList<StaleChat> &stale);
+
+    void processQueue();
+
+    QMutex m_indexMutex;
+    // By absolute directory path.
+    QHash<QString, Directory> m_directories;
+
+    QMutex m_queueMutex;
+    QList<PendingChat> m_queue;
+    bool m_workerActive = false;
+
+    QThreadPool m_pool;
+    std::atomic<bool> m_stopping = false;
+};
+
+} // namespace QodeAssist::Tools
@@ -0,0 +1,123 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#include "HistoryIndexCache.hpp"
+
+#include <QDeadlineTimer>
+#include <QDir>
+#include <QFileInfo>
+#include <QMutexLocker>
+
+#include <logger/Logger.hpp>
+
+namespace QodeAssist::Tools {
+
+namespace {
+
+// Saves come in bursts while a chat streams, so the index is written once they settle.
+constexpr int kWriteDelayMs = 3000;
+
+QString directoryOf(const QString &chatFilePath)
+{
+    return QDir::cleanPath(QFileInfo(chatFilePath).absolutePath());
+}
+
+} // namespace
+
+HistoryIndexCache &HistoryIndexCache::instance()
+{
+    static HistoryIndexCache cache;
+    return cache;
+}
+
+HistoryIndexCache::HistoryIndexCache()
+{
+    m_pool.setMaxThreadCount(1);
+}
+
+HistoryIndexCache::~HistoryIndexCache()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stopping = true;
+        m_wake.wakeAll();
+    }
+    m_pool.waitForDone();
+}
+
+void HistoryIndexCache::chatSaved(
+    const QString &chatFilePath,
+    const Session::ConversationHistory &history,
+    const QJsonObject &meta)
+{
+    QMutexLocker locker(&m_mutex);
+    indexFor(directoryOf(chatFilePath)).update(chatFilePath, history, meta);
+    scheduleWrite();
+}
+
+std::optional<Session::HistoryIndex::Entry> HistoryIndexCache::entry(const QString &chatFilePath)
+{
+    QMutexLocker locker(&m_mutex);
+    Session::HistoryIndex &index = indexFor(directoryOf(chatFilePath));
+    const std::optional<Session::HistoryIndex::Entry> found = index.entry(chatFilePath);
+    // Summarizing a stale entry changes the index as well.
+    if (index.isDirty())
+        scheduleWrite();
+    return found;
+}
+
+void HistoryIndexCache::flush()
+{
+    QMutexLocker locker(&m_mutex);
+    writeAll();
+}
+
+void HistoryIndexCache::shutdown()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stopping = true;
+        m_wake.wakeAll();
+    }
+    m_pool.waitForDone();
+    flush();
+}
+
+Session::HistoryIndex &HistoryIndexCache::indexFor(const QString &directory)
+{
+    auto it = m_indexes.find(directory);
+    if (it == m_indexes.end())
+        it = m_indexes.insert(directory, Session::HistoryIndex(directory));
+    return it.value();
+}
+
+void HistoryIndexCache::scheduleWrite()
+{
+    if (m_writeScheduled || m_stopping)
+        return;
+    m_writeScheduled = true;
+    m_pool.start([this] { writeWhenIdle(); });
+}
+
+void HistoryIndexCache::writeAll()
+{
+    for (auto it = m_indexes.begin(); it != m_indexes.end(); ++it) {
+        // Chats saved to a directory that is gone since have nothing left to index.
+        if (QFileInfo(it.key()).isDir() && !it.value().save())
+            LOG_MESSAGE(QString("Failed to write the chat history index in %1").arg(it.key()));
+    }
+}
+
+void HistoryIndexCache::writeWhenIdle()
+{
+    QMutexLocker locker(&m_mutex);
+    QDeadlineTimer deadline(kWriteDelayMs);
+    while (!m_stopping && !deadline.hasExpired())
+        m_wake.wait(&m_mutex, deadline);
+
+    m_writeScheduled = false;
+    writeAll();
+}
+
+} // namespace QodeAssist::Tools
@@ -0,0 +1,73 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#pragma once
+
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QThreadPool>
+#include <QWaitCondition>
+
+#include <atomic>
+#include <optional>
+
+#include "session/ConversationHistory.hpp"
+#include "session/HistoryIndex.hpp"
+
+namespace QodeAssist::Tools {
+
+/**
+ * @brief One in-memory HistoryIndex per history directory, shared by everyone who reads it.
+ *
+ * The index file of a directory is read once. Saving a chat only updates its entry in memory;
+ * changed indexes are written out on a background thread a few seconds later, so a burst of
+ * saves costs one write, and on shutdown.
+ */
+class HistoryIndexCache
+{
+public:
+    static HistoryIndexCache &instance();
+
+    // Thread-safe. Records a chat that has just been written to chatFilePath.
+    void chatSaved(
+        const QString &chatFilePath,
+        const Session::ConversationHistory &history,
+        const QJsonObject &meta);
+
+    // Thread-safe. Summarizes the chat from its file when the stored entry is stale.
+    std::optional<Session::HistoryIndex::Entry> entry(const QString &chatFilePath);
+
+    // Thread-safe. Writes out every index that changed.
+    void flush();
+
+    // Stops the delayed write and writes out every index that changed.
+    void shutdown();
+
+private:
+    HistoryIndexCache();
+    ~HistoryIndexCache();
+    HistoryIndexCache(const HistoryIndexCache &) = delete;
+    HistoryIndexCache &operator=(const HistoryIndexCache &) = delete;
+
+    // Require m_mutex.
+    Session::HistoryIndex &indexFor(const QString &directory);
+    void scheduleWrite();
+    void writeAll();
+
+    void writeWhenIdle();
+
+    QMutex m_mutex;
+    QWaitCondition m_wake;
+    // By absolute directory path.
+    QHash<QString, Session::HistoryIndex> m_indexes;
+    bool m_writeScheduled = false;
+
+    QThreadPool m_pool;
+    std::atomic<bool> m_stopping = false;
+};
+
+} // namespace QodeAssist::Tools
@@ -6,28 +6,37 @@
 
 #include <LLMQore/ToolExceptions.hpp>
 
-#include <cplusplus/Overview.h>
-#include <cplusplus/Scope.h>
-#include <cplusplus/Symbols.h>
 #include <cppeditor/cppmodelmanager.h>
 #include <logger/Logger.hpp>
 #include <projectexplorer/project.h>
 #include <projectexplorer/projectmanager.h>
 #include <QDir>
-#include <QFile>
 #include <QFileInfo>
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QRegularExpression>
-#include <QTextStream>
 #include <QtConcurrent>
 
+#include "ProjectTextIndex.hpp"
+#include "SymbolIndex.hpp"
+#include "TextScanner.hpp"
+
 namespace QodeAssist::Tools {
 
+namespace {
+
+constexpr int kMaxResults = 100;
+
+} // namespace
+
 ProjectSearchTool::ProjectSearchTool(QObject *parent)
     : BaseTool(parent)
     , m_ignoreManager(new Context::IgnoreManager(this))
-{}
+{
+    connect(m_ignoreManager, &Context::IgnoreManager::rulesChanged, this, [] {
+        ProjectTextIndex::instance().invalidateExclusions();
+    });
+}
 
 QString ProjectSearchTool::id() const
 {
@@ -109,6 +118,7 @@ QFuture<LLMQore::ToolResult> ProjectSearchTool::executeAsync(const QJsonObject &
 
         SearchType searchType = (searchTypeStr == "symbol") ? SearchType::Symbol : SearchType::Text;
         QList<SearchResult> results;
+        bool truncated = false;
 
         if (searchType == SearchType::Text) {
             bool caseSensitive = input["case_sensitive"].toBool(false);
@@ -116,7 +126,8 @@ QFuture<LLMQore::ToolResult> ProjectSearchTool::executeAsync(const QJsonObject &
             bool wholeWords = input["whole_words"].toBool(false);
             QString filePattern = input["file_pattern"].toString();
 
-            results = searchText(query, caseSensitive, useRegex, wholeWords, filePattern);
+            results = searchText(
+                query, caseSensitive, useRegex, wholeWords, filePattern, &truncated);
         } else {
             SymbolType symbolType = parseSymbolType(input["symbol_type"].toString());
             bool caseSensitive = input["case_sensitive"].toBool(false);
@@ -129,7 +140,7 @@ QFuture<LLMQore::ToolResult> ProjectSearchTool::executeAsync(const QJsonObject &
             return LLMQore::ToolResult::text(QString("No matches found for '%1'").arg(query));
         }
 
-        return LLMQore::ToolResult::text(formatResults(results, query));
+        return LLMQore::ToolResult::text(formatResults(results, query, truncated));
     });
 }
 
@@ -138,29 +149,34 @@ QList<ProjectSearchTool::SearchResult> ProjectSearchTool::searchText(
     bool caseSensitive,
     bool useRegex,
     bool wholeWords,
-    const QString &filePattern)
+    const QString &filePattern,
+    bool *truncated)
 {
     QList<SearchResult> results;
+    *truncated = false;
     auto projects = ProjectExplorer::ProjectManager::projects();
     if (projects.isEmpty())
         return results;
 
-    QRegularExpression searchRegex;
-    if (useRegex) {
-        QRegularExpression::PatternOptions options = QRegularExpression::MultilineOption;
-        if (!caseSensitive)
-            options |= QRegularExpression::CaseInsensitiveOption;
-        searchRegex.setPattern(query);
-        searchRegex.setPatternOptions(options);
-        if (!searchRegex.isValid())
-            return results;
-    }
+    TextScanner::Options scanOptions;
+    scanOptions.query = query;
+    scanOptions.caseSensitive = caseSensitive;
+    scanOptions.useRegex = useRegex;
+    scanOptions.wholeWords = wholeWords;
+    const TextScanner scanner(scanOptions);
+    if (!scanner.isValid())
+        return results;
 
     QRegularExpression fileFilter;
     if (!filePattern.isEmpty()) {
         fileFilter.setPattern(QRegularExpression::wildcardToRegularExpression(filePattern));
     }
 
+    const TrigramQuery indexQuery = useRegex ? TrigramQuery::forRegex(query, caseSensitive)
+                                             : TrigramQuery::forLiteral(query, caseSensitive);
+
+    QStringList searchedFiles;
+    QStringList searchedProjectDirs;
     for (auto project : projects) {
         if (!project)
             continue;
@@ -168,6 +184,7 @@ QList<ProjectSearchTool::SearchResult> ProjectSearchTool::searchText(
         auto projectFiles = project->files(ProjectExplorer::Project::SourceFiles);
         QString projectDir = project->projectDirectory().path();
 
+        QStringList projectSearchedFiles;
         for (const auto &filePath : projectFiles) {
             QString absolutePath = filePath.path();
 
@@ -180,43 +197,30 @@ QList<ProjectSearchTool::SearchResult> ProjectSearchTool::searchText(
                     continue;
             }
 
-            QFile file(absolutePath);
-            if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
-                continue;
+            projectSearchedFiles.append(absolutePath);
+        }
 
-            QTextStream stream(&file);
-            int lineNumber = 0;
-            while (!stream.atEnd()) {
-                lineNumber++;
-                QString line = stream.readLine();
-                bool matched = false;
-
-                if (useRegex) {
-                    matched = searchRegex.match(line).hasMatch();
-                } else {
-                    auto cs = caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive;
-                    if (wholeWords) {
-                        QRegularExpression wordRegex(
-                            QString("\\b%1\\b").arg(QRegularExpression::escape(query)),
-                            caseSensitive ? QRegularExpression::NoPatternOption
-                                          : QRegularExpression::CaseInsensitiveOption);
-                        matched = wordRegex.match(line).hasMatch();
-                    } else {
-                        matched = line.contains(query, cs);
-                    }
-                }
-
-                if (matched) {
-                    SearchResult result;
-                    result.filePath = absolutePath;
-                    result.relativePath = QDir(projectDir).relativeFilePath(absolutePath);
-                    result.content = line.trimmed();
-                    result.lineNumber = lineNumber;
-                    results.append(result);
-                }
-            }
+        projectSearchedFiles
+            = ProjectTextIndex::instance().candidateFiles(projectSearchedFiles, indexQuery);
+        for (const QString &absolutePath : std::as_const(projectSearchedFiles)) {
+            searchedFiles.append(absolutePath);
+            searchedProjectDirs.append(projectDir);
         }
     }
+
+    const QList<TextScanner::Match> matches = scanner.scan(searchedFiles, kMaxResults);
+    *truncated = matches.size() > kMaxResults;
+
+    for (const TextScanner::Match &match : matches) {
+        const QString &absolutePath = searchedFiles.at(match.fileIndex);
+        SearchResult result;
+        result.filePath = absolutePath;
+        result.relativePath = QDir(searchedProjectDirs.at(match.fileIndex))
+                                  .relativeFilePath(absolutePath);
+        result.content = match.line.trimmed();
+        result.lineNumber = match.lineNumber;
+        results.append(result);
+    }
     return results;
 }
 
@@ -239,70 +243,68 @@ QList<ProjectSearchTool::SearchResult> ProjectSearchTool::searchSymbols(
             return results;
     }
 
-    CPlusPlus::Overview overview;
-    auto snapshot = modelManager->snapshot();
+    QString projectDir;
+    auto projects = ProjectExplorer::ProjectManager::projects();
+    if (!projects.isEmpty())
+        projectDir = projects.first()->projectDirectory().path();
+
+    const auto typeMatches = [symbolType](quint8 kinds) {
+        switch (symbolType) {
+        case SymbolType::All:
+            return true;
+        case SymbolType::Class:
+            return (kinds & SymbolTable::Class) != 0;
+        case SymbolType::Function:
+            return (kinds & SymbolTable::Function) != 0;
+        case SymbolType::Enum:
+            return (kinds & SymbolTable::Enum) != 0;
+        case SymbolType::Variable:
+            return (kinds & SymbolTable::Declaration) != 0;
+        case SymbolType::Namespace:
+            return (kinds & SymbolTable::Namespace) != 0;
+        }
+        return false;
+    };
+
+    const auto appendResult = [&](const SymbolTable::Symbol &symbol) {
+        if (!typeMatches(symbol.kinds) || m_ignoreManager->shouldIgnore(symbol.filePath, nullptr))
+            return;
+
+        SearchResult result;
+        result.filePath = symbol.filePath;
+        result.relativePath = projectDir.isEmpty()
+                                  ? QFileInfo(symbol.filePath).fileName()
+                                  : QDir(projectDir).relativeFilePath(symbol.filePath);
+        result.content = symbol.name;
+        result.lineNumber = symbol.line;
+        results.append(result);
+    };
+
+    const Qt::CaseSensitivity cs = caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive;
+
+    const SymbolIndex &index = SymbolIndex::instance();
+    if (index.isReady()) {
+        const QList<SymbolTable::Symbol> symbols
+            = useRegex ? index.find(searchRegex)
+                       : index.find(query, SymbolTable::Match::Exact, cs);
+        for (const SymbolTable::Symbol &symbol : symbols)
+            appendResult(symbol);
+        return results;
+    }
 
+    // The index is disabled or still being built: walk the code model directly.
+    auto snapshot = modelManager->snapshot();
     for (auto it = snapshot.begin(); it != snapshot.end(); ++it) {
-        auto document = it.value();
-        if (!document || !document->globalNamespace())
+        const QString filePath = it.value() ? it.value()->filePath().path() : QString();
+        if (filePath.isEmpty() || m_ignoreManager->shouldIgnore(filePath, nullptr))
             continue;
 
-        QString filePath = document->filePath().path();
-        if (m_ignoreManager->shouldIgnore(filePath, nullptr))
-            continue;
-
-        auto searchInScope = [&](auto self, CPlusPlus::Scope *scope) -> void {
-            if (!scope)
-                return;
-
-            for (unsigned i = 0; i < scope->memberCount(); ++i) {
-                auto symbol = scope->memberAt(i);
-                if (!symbol || !symbol->name())
-                    continue;
-
-                QString symbolName = overview.prettyName(symbol->name());
-                bool nameMatches = false;
-
-                if (useRegex) {
-                    nameMatches = searchRegex.match(symbolName).hasMatch();
-                } else {
-                    nameMatches = caseSensitive
-                                      ? symbolName == query
-                                      : symbolName.compare(query, Qt::CaseInsensitive) == 0;
-                }
-
-                bool typeMatches = (symbolType == SymbolType::All)
-                                   || (symbolType == SymbolType::Class && symbol->asClass())
-                                   || (symbolType == SymbolType::Function && symbol->asFunction())
-                                   || (symbolType == SymbolType::Enum && symbol->asEnum())
-                                   || (symbolType == SymbolType::Variable && symbol->asDeclaration())
-                                   || (symbolType == SymbolType::Namespace && symbol->asNamespace());
-
-                if (nameMatches && typeMatches) {
-                    SearchResult result;
-                    result.filePath = filePath;
-
-                    auto projects = ProjectExplorer::ProjectManager::projects();
-                    if (!projects.isEmpty()) {
-                        QString projectDir = projects.first()->projectDirectory().path();
-                        result.relativePath = QDir(projectDir).relativeFilePath(filePath);
-                    } else {
-                        result.relativePath = QFileInfo(filePath).fileName();
-                    }
-
-                    result.content = symbolName;
-                    result.lineNumber = symbol->line();
-                    result.context = overview.prettyType(symbol->type());
-                    results.append(result);
-                }
-
-                if (auto nestedScope = symbol->asScope()) {
-                    self(self, nestedScope);
-                }
-            }
-        };
-
-        searchInScope(searchInScope, document->globalNamespace());
+        for (const SymbolTable::Symbol &symbol : SymbolIndex::symbolsOf(it.value())) {
+            const bool nameMatches = useRegex ? searchRegex.match(symbol.name).hasMatch()
+                                              : symbol.name.compare(query, cs) == 0;
+            if (nameMatches)
+                appendResult(symbol);
+        }
     }
 
     return results;
@@ -323,13 +325,19 @@ ProjectSearchTool::SymbolType ProjectSearchTool::parseSymbolType(const QString &
     return SymbolType::All;
 }
 
-QString ProjectSearchTool::formatResults(const QList<SearchResult> &results, const QString &query)
+QString ProjectSearchTool::formatResults(
+    const QList<SearchResult> &results, const QString &query, bool truncated)
 {
-    QString output = QString("Query: %1\n Found %2 matches:\n\n").arg(query).arg(results.size());
+    const QString found = truncated ? QString("more than %1").arg(kMaxResults)
+                                    : QString::number(results.size());
+    QString output = QString("Query: %1\n Found %2 matches:\n\n").arg(query, found);
     int count = 0;
     for (const auto &r : results) {
-        if (++count > 100) {
-            output += QString("... and %1 more matches").arg(results.size() - 20);
+        if (++count > kMaxResults) {
+            if (truncated)
+                output += QString("... and more matches");
+            else
+                output += QString("... and %1 more matches").arg(results.size() - kMaxResults);
             break;
         }
         output += QString("%1:%2: %3\n").arg(r.relativePath).arg(r.lineNumber).arg(r.content);
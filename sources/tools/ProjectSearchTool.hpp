@@ -36,7 +36,6 @@ private:
         QString relativePath;
         QString content;
         int lineNumber = 0;
-        QString context;
     };
 
     QList<SearchResult> searchText(
@@ -44,13 +43,15 @@ private:
         bool caseSensitive,
         bool useRegex,
         bool wholeWords,
-        const QString &filePattern);
+        const QString &filePattern,
+        bool *truncated);
 
     QList<SearchResult> searchSymbols(
         const QString &query, SymbolType symbolType, bool caseSensitive, bool useRegex);
 
     SymbolType parseSymbolType(const QString &typeStr);
-    QString formatResults(const QList<SearchResult> &results, const QString &query);
+    QString formatResults(
+        const QList<SearchResult> &results, const QString &query, bool truncated);
 
     Context::IgnoreManager *m_ignoreManager;
 };
@@ -0,0 +1,446 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#include "ProjectTextIndex.hpp"
+
+#include <coreplugin/documentmanager.h>
+#include <projectexplorer/project.h>
+#include <projectexplorer/projectmanager.h>
+#include <utils/aspects.h>
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QReadLocker>
+#include <QWriteLocker>
+
+#include <logger/Logger.hpp>
+#include <settings/ToolsSettings.hpp>
+
+#include <algorithm>
+
+namespace QodeAssist::Tools {
+
+namespace {
+
+constexpr qint64 kMaxIndexedFileSize = 4 * 1024 * 1024;
+constexpr qint64 kStaleCheckIntervalMs = 30 * 1000;
+
+qint64 fileStamp(const QFileInfo &info)
+{
+    return info.lastModified().toMSecsSinceEpoch() * 31 + info.size();
+}
+
+QSet<QString> projectSourceFiles(ProjectExplorer::Project *project)
+{
+    QSet<QString> files;
+    for (const auto &filePath : project->files(ProjectExplorer::Project::SourceFiles))
+        files.insert(filePath.path());
+    return files;
+}
+
+} // namespace
+
+ProjectTextIndex &ProjectTextIndex::instance()
+{
+    static ProjectTextIndex index;
+    return index;
+}
+
+ProjectTextIndex::ProjectTextIndex(QObject *parent)
+    : QObject(parent)
+{
+    m_pool.setMaxThreadCount(1);
+}
+
+ProjectTextIndex::~ProjectTextIndex()
+{
+    m_stopping = true;
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+void ProjectTextIndex::init()
+{
+    if (m_initialized)
+        return;
+    m_initialized = true;
+
+    auto &settings = Settings::toolsSettings();
+    connect(&settings.enableProjectSearchTool, &Utils::BaseAspect::changed, this, [this] {
+        updateEnabled();
+    });
+    connect(&settings.indexProjectSearch, &Utils::BaseAspect::changed, this, [this] {
+        updateEnabled();
+    });
+
+    auto *projectManager = ProjectExplorer::ProjectManager::instance();
+    connect(
+        projectManager,
+        &ProjectExplorer::ProjectManager::projectAdded,
+        this,
+        [this](ProjectExplorer::Project *project) {
+            if (m_enabled)
+                watchProject(project);
+        });
+    connect(
+        projectManager,
+        &ProjectExplorer::ProjectManager::projectRemoved,
+        this,
+        &ProjectTextIndex::unwatchProject);
+
+    auto *documentManager = Core::DocumentManager::instance();
+    connect(
+        documentManager,
+        &Core::DocumentManager::filesChangedInternally,
+        this,
+        [this](const Utils::FilePaths &filePaths) {
+            QStringList paths;
+            for (const auto &filePath : filePaths)
+                paths.append(filePath.path());
+            onFilesChanged(paths);
+        });
+    connect(
+        documentManager,
+        &Core::DocumentManager::filesChangedExternally,
+        this,
+        [this](const QSet<Utils::FilePath> &filePaths) {
+            QStringList paths;
+            for (const auto &filePath : filePaths)
+                paths.append(filePath.path());
+            onFilesChanged(paths);
+        });
+
+    updateEnabled();
+}
+
+void ProjectTextIndex::shutdown()
+{
+    stop();
+}
+
+bool ProjectTextIndex::isEnabled() const
+{
+    return m_enabled;
+}
+
+QStringList ProjectTextIndex::candidateFiles(
+    const QStringList &files, const TrigramQuery &query) const
+{
+    if (!m_enabled || query.matchesAll())
+        return files;
+
+    scheduleStaleCheck();
+
+    // Indexed files the query rules out, with the stamp their trigrams were taken at.
+    QHash<QString, qint64> excluded;
+    {
+        QReadLocker locker(&m_indexLock);
+        const QSet<QString> matches = m_index.candidates(query);
+        for (const QString &file : files) {
+            if (m_index.contains(file) && !matches.contains(file))
+                excluded.insert(file, m_index.stamp(file));
+        }
+    }
+
+    // Exclusions checked against the disk recently enough are trusted as they are; edits made
+    // since then are left to the stale sweep.
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QSet<QString> verified;
+    {
+        QMutexLocker locker(&m_exclusionMutex);
+        for (auto it = excluded.constBegin(); it != excluded.constEnd(); ++it) {
+            const auto check = m_exclusionChecks.constFind(it.key());
+            if (check != m_exclusionChecks.constEnd() && check->stamp == it.value()
+                && now - check->checkedAt < kStaleCheckIntervalMs) {
+                verified.insert(it.key());
+            }
+        }
+    }
+
+    // A file changed since it was indexed is judged by its old contents, so it is scanned like
+    // an unindexed one and queued for re-indexing.
+    QStringList result;
+    QStringList stale;
+    QHash<QString, ExclusionCheck> checked;
+    for (const QString &file : files) {
+        const auto it = excluded.constFind(file);
+        if (it == excluded.constEnd()) {
+            result.append(file);
+            continue;
+        }
+        if (verified.contains(file))
+            continue;
+        const QFileInfo info(file);
+        if (!info.exists() || fileStamp(info) != it.value()) {
+            result.append(file);
+            stale.append(file);
+        } else {
+            checked.insert(file, {.stamp = it.value(), .checkedAt = now});
+        }
+    }
+
+    if (!checked.isEmpty()) {
+        QMutexLocker locker(&m_exclusionMutex);
+        m_exclusionChecks.insert(checked);
+    }
+    if (!stale.isEmpty())
+        const_cast<ProjectTextIndex *>(this)->enqueue(stale);
+    return result;
+}
+
+void ProjectTextIndex::invalidateExclusions()
+{
+    QMutexLocker locker(&m_exclusionMutex);
+    m_exclusionChecks.clear();
+}
+
+void ProjectTextIndex::forgetExclusions(const QStringList &paths) const
+{
+    if (paths.isEmpty())
+        return;
+
+    QMutexLocker locker(&m_exclusionMutex);
+    for (const QString &path : paths)
+        m_exclusionChecks.remove(path);
+}
+
+void ProjectTextIndex::updateEnabled()
+{
+    const auto &settings = Settings::toolsSettings();
+    const bool wanted = settings.enableProjectSearchTool() && settings.indexProjectSearch();
+    if (wanted == m_enabled)
+        return;
+
+    if (wanted)
+        start();
+    else
+        stop();
+}
+
+void ProjectTextIndex::start()
+{
+    m_stopping = false;
+    m_enabled = true;
+    for (ProjectExplorer::Project *project : ProjectExplorer::ProjectManager::projects())
+        watchProject(project);
+}
+
+void ProjectTextIndex::stop()
+{
+    m_enabled = false;
+    m_stopping = true;
+    m_pool.clear();
+    m_pool.waitForDone();
+
+    for (const QMetaObject::Connection &connection : std::as_const(m_projectConnections))
+        disconnect(connection);
+    m_projectConnections.clear();
+    m_projectFiles.clear();
+
+    {
+        QMutexLocker locker(&m_queueMutex);
+        m_queue.clear();
+        m_queued.clear();
+        m_workerActive = false;
+    }
+
+    invalidateExclusions();
+
+    QWriteLocker locker(&m_indexLock);
+    m_index.clear();
+    m_trackedFiles.clear();
+}
+
+void ProjectTextIndex::watchProject(ProjectExplorer::Project *project)
+{
+    if (!project || m_projectConnections.contains(project))
+        return;
+
+    m_projectConnections.insert(
+        project,
+        connect(project, &ProjectExplorer::Project::fileListChanged, this, [this, project] {
+            syncProjectFiles(project, projectSourceFiles(project));
+        }));
+
+    syncProjectFiles(project, projectSourceFiles(project));
+}
+
+void ProjectTextIndex::unwatchProject(ProjectExplorer::Project *project)
+{
+    if (!m_projectConnections.contains(project))
+        return;
+
+    disconnect(m_projectConnections.take(project));
+    syncProjectFiles(project, {});
+    m_projectFiles.remove(project);
+}
+
+void ProjectTextIndex::syncProjectFiles(
+    ProjectExplorer::Project *project, const QSet<QString> &files)
+{
+    const QSet<QString> previous = m_projectFiles.value(project);
+    m_projectFiles.insert(project, files);
+
+    QStringList added;
+    for (const QString &file : files) {
+        if (!previous.contains(file))
+            added.append(file);
+    }
+
+    QStringList removed;
+    for (const QString &file : previous) {
+        if (files.contains(file))
+            continue;
+        // Another open project may still list the file.
+        const bool stillListed = std::any_of(
+            m_projectFiles.cbegin(), m_projectFiles.cend(), [&file](const QSet<QString> &other) {
+                return other.contains(file);
+            });
+        if (!stillListed)
+            removed.append(file);
+    }
+
+    if (added.isEmpty() && removed.isEmpty())
+        return;
+
+    {
+        QWriteLocker locker(&m_indexLock);
+        for (const QString &file : std::as_const(added))
+            m_trackedFiles.insert(file);
+        for (const QString &file : std::as_const(removed)) {
+            m_trackedFiles.remove(file);
+            m_index.removeFile(file);
+        }
+    }
+
+    forgetExclusions(removed);
+    enqueue(added);
+}
+
+void ProjectTextIndex::onFilesChanged(const QStringList &paths)
+{
+    if (!m_enabled)
+        return;
+
+    QStringList tracked;
+    {
+        QReadLocker locker(&m_indexLock);
+        for (const QString &path : paths) {
+            if (m_trackedFiles.contains(path))
+                tracked.append(path);
+        }
+    }
+    forgetExclusions(tracked);
+    enqueue(tracked);
+}
+
+void ProjectTextIndex::enqueue(const QStringList &paths)
+{
+    if (paths.isEmpty())
+        return;
+
+    QMutexLocker locker(&m_queueMutex);
+    for (const QString &path : paths) {
+        if (!m_queued.contains(path)) {
+            m_queued.insert(path);
+            m_queue.append(path);
+        }
+    }
+
+    if (!m_workerActive && !m_queue.isEmpty() && !m_stopping) {
+        m_workerActive = true;
+        m_pool.start([this] { processQueue(); });
+    }
+}
+
+void ProjectTextIndex::processQueue()
+{
+    QElapsedTimer timer;
+    timer.start();
+    int indexed = 0;
+
+    while (true) {
+        QString path;
+        {
+            QMutexLocker locker(&m_queueMutex);
+            if (m_stopping || m_queue.isEmpty()) {
+                m_workerActive = false;
+                break;
+            }
+            path = m_queue.takeFirst();
+            m_queued.remove(path);
+        }
+
+        indexFile(path);
+        ++indexed;
+    }
+
+    if (indexed > 100 && !m_stopping) {
+        LOG_MESSAGE(QString("Project search index: indexed %1 files in %2 ms")
+                        .arg(indexed)
+                        .arg(timer.elapsed()));
+    }
+}
+
+void ProjectTextIndex::indexFile(const QString &path)
+{
+    const QFileInfo info(path);
+    std::vector<quint32> trigrams;
+    bool indexable = info.isFile() && info.size() <= kMaxIndexedFileSize;
+    if (indexable) {
+        QFile file(path);
+        indexable = file.open(QIODevice::ReadOnly);
+        if (indexable)
+            trigrams = TrigramIndex::trigramsOf(file.readAll());
+    }
+
+    QWriteLocker locker(&m_indexLock);
+    // Unindexed files are always scanned, so dropping the entry is the safe fallback.
+    if (!indexable || !m_trackedFiles.contains(path))
+        m_index.removeFile(path);
+    else
+        m_index.setFile(path, trigrams, fileStamp(info));
+}
+
+void ProjectTextIndex::scheduleStaleCheck() const
+{
+    // Edits that bypass Qt Creator (git checkout, external tools) are not reported to us, so
+    // queries periodically trigger a modification time sweep in the background.
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    qint64 last = m_lastStaleCheck;
+    if (now - last < kStaleCheckIntervalMs
+        || !m_lastStaleCheck.compare_exchange_strong(last, now)) {
+        return;
+    }
+
+    auto *self = const_cast<ProjectTextIndex *>(this);
+    m_pool.start([self] { self->checkStaleFiles(); });
+}
+
+void ProjectTextIndex::checkStaleFiles()
+{
+    QHash<QString, qint64> stamps;
+    {
+        QReadLocker locker(&m_indexLock);
+        for (const QString &path : m_index.files())
+            stamps.insert(path, m_index.stamp(path));
+    }
+
+    QStringList changed;
+    for (auto it = stamps.constBegin(); it != stamps.constEnd(); ++it) {
+        if (m_stopping)
+            return;
+        const QFileInfo info(it.key());
+        if (!info.exists() || fileStamp(info) != it.value())
+            changed.append(it.key());
+    }
+
+    forgetExclusions(changed);
+    enqueue(changed);
+}
+
+} // namespace QodeAssist::Tools
@@ -0,0 +1,104 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QReadWriteLock>
+#include <QSet>
+#include <QStringList>
+#include <QThreadPool>
+
+#include <atomic>
+
+#include "TrigramIndex.hpp"
+
+namespace ProjectExplorer {
+class Project;
+}
+
+namespace QodeAssist::Tools {
+
+/**
+ * @brief Trigram index over the source files of all open projects, used by search_project.
+ *
+ * Files are indexed on a background thread when a project opens, when its file list changes
+ * and when Qt Creator reports them changed. Queries come from tool worker threads and only
+ * narrow the list of files to scan; files that are not indexed yet, are too large to index, or
+ * changed on disk since they were indexed are always kept, so results never depend on indexing
+ * having caught up.
+ */
+class ProjectTextIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    static ProjectTextIndex &instance();
+
+    void init();
+    void shutdown();
+
+    bool isEnabled() const;
+
+    // Thread-safe. Returns the subset of files that may contain a match, in the given order.
+    QStringList candidateFiles(const QStringList &files, const TrigramQuery &query) const;
+
+    // Thread-safe. Forgets which excluded files were checked on disk, e.g. when the ignore rules
+    // that select the searched files change.
+    void invalidateExclusions();
+
+private:
+    explicit ProjectTextIndex(QObject *parent = nullptr);
+    ~ProjectTextIndex() override;
+    ProjectTextIndex(const ProjectTextIndex &) = delete;
+    ProjectTextIndex &operator=(const ProjectTextIndex &) = delete;
+
+    void updateEnabled();
+    void start();
+    void stop();
+
+    void watchProject(ProjectExplorer::Project *project);
+    void unwatchProject(ProjectExplorer::Project *project);
+    void syncProjectFiles(ProjectExplorer::Project *project, const QSet<QString> &files);
+    void onFilesChanged(const QStringList &paths);
+
+    void enqueue(const QStringList &paths);
+    void processQueue();
+    void indexFile(const QString &path);
+    void scheduleStaleCheck() const;
+    void checkStaleFiles();
+    void forgetExclusions(const QStringList &paths) const;
+
+    mutable QReadWriteLock m_indexLock;
+    TrigramIndex m_index;
+    QSet<QString> m_trackedFiles;
+
+    QMutex m_queueMutex;
+    QStringList m_queue;
+    QSet<QString> m_queued;
+    bool m_workerActive = false;
+
+    // Excluded files found unchanged on disk: the index stamp they matched and when.
+    struct ExclusionCheck
+    {
+        qint64 stamp = 0;
+        qint64 checkedAt = 0;
+    };
+    mutable QMutex m_exclusionMutex;
+    mutable QHash<QString, ExclusionCheck> m_exclusionChecks;
+
+    mutable QThreadPool m_pool;
+    std::atomic<bool> m_enabled = false;
+    std::atomic<bool> m_stopping = false;
+    mutable std::atomic<qint64> m_lastStaleCheck = 0;
+
+    // GUI thread only.
+    QHash<ProjectExplorer::Project *, QSet<QString>> m_projectFiles;
+    QHash<ProjectExplorer::Project *, QMetaObject::Connection> m_projectConnections;
+    bool m_initialized = false;
+};
+
+} // namespace QodeAssist::Tools
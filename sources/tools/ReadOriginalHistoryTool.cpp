@@ -7,11 +7,12 @@
 #include <LLMQore/ToolExceptions.hpp>
 
 #include <QFile>
+#include <QFileInfo>
 #include <QJsonArray>
-#include <QJsonDocument>
 #include <QJsonObject>
 #include <QtConcurrent>
 
+#include "HistoryIndexCache.hpp"
 #include "session/HistoryProjection.hpp"
 #include "session/HistorySerializer.hpp"
 
@@ -50,8 +51,7 @@ QJsonObject readJsonObject(const QString &path)
     if (!file.open(QIODevice::ReadOnly))
         return {};
 
-    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
-    return doc.isObject() ? doc.object() : QJsonObject{};
+    return Session::HistorySerializer::readRoot(file.readAll());
 }
 
 QString resolveRootHistoryPath(const QString &sessionPath)
@@ -59,9 +59,11 @@ QString resolveRootHistoryPath(const QString &sessionPath)
     QString current = sessionPath;
     QString rootPath;
 
+    // Links are read from the history index of each directory the chain passes through.
     for (int depth = 0; depth < 32; ++depth) {
-        const QJsonObject obj = readJsonObject(current);
-        const QString parent = obj.value("compressedFrom").toString();
+        const std::optional<Session::HistoryIndex::Entry> entry
+            = HistoryIndexCache::instance().entry(current);
+        const QString parent = entry ? entry->compressedFrom : QString();
         if (parent.isEmpty() || parent == current)
             break;
         if (!QFile::exists(parent))
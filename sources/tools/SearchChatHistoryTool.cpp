@@ -0,0 +1,125 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#include "SearchChatHistoryTool.hpp"
+
+#include <LLMQore/ToolExceptions.hpp>
+
+#include <QDateTime>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QtConcurrent>
+
+#include "ChatHistorySearch.hpp"
+
+namespace QodeAssist::Tools {
+
+namespace {
+
+constexpr int kSnippetsPerChat = 3;
+
+} // namespace
+
+SearchChatHistoryTool::SearchChatHistoryTool(QObject *parent)
+    : BaseTool(parent)
+{}
+
+QString SearchChatHistoryTool::id() const
+{
+    return "search_chat_history";
+}
+
+QString SearchChatHistoryTool::displayName() const
+{
+    return "Searching chat history";
+}
+
+QString SearchChatHistoryTool::description() const
+{
+    return "Search the earlier chats saved for this project by their messages, tool calls and "
+           "the paths of files they edited. Use this to recall past discussions, decisions or "
+           "fixes. Words are matched case-insensitively, and words of three or more letters "
+           "also match longer words they start. Returns the best matching chats, each with its "
+           "file path and excerpts of the matching messages; the current chat is left out.";
+}
+
+QJsonObject SearchChatHistoryTool::parametersSchema() const
+{
+    QJsonObject properties;
+
+    properties["query"] = QJsonObject{
+        {"type", "string"},
+        {"description", "Words to search for. Chats containing more of them rank first."}};
+
+    properties["limit"] = QJsonObject{
+        {"type", "integer"},
+        {"description", "Maximum number of chats to return (default 5)."}};
+
+    QJsonObject definition;
+    definition["type"] = "object";
+    definition["properties"] = properties;
+    definition["required"] = QJsonArray{"query"};
+
+    return definition;
+}
+
+QFuture<LLMQore::ToolResult> SearchChatHistoryTool::executeAsync(const QJsonObject &input)
+{
+    QString sessionPath;
+    {
+        QMutexLocker locker(&m_mutex);
+        sessionPath = m_currentSessionId;
+    }
+
+    return QtConcurrent::run([input, sessionPath]() -> LLMQore::ToolResult {
+        if (sessionPath.isEmpty())
+            throw LLMQore::ToolRuntimeError("No active chat session, cannot locate chat history.");
+
+        const QString query = input.value("query").toString().trimmed();
+        if (query.isEmpty())
+            throw LLMQore::ToolInvalidArgument("'query' must not be empty.");
+        const int limit = qBound(1, input.value("limit").toInt(5), 20);
+
+        const QFileInfo session(sessionPath);
+        // One more than asked for, in case the current chat is among them.
+        QList<ChatHistorySearch::Result> results = ChatHistorySearch::instance().search(
+            session.absolutePath(), query, limit + 1, kSnippetsPerChat);
+        results.removeIf([&session](const ChatHistorySearch::Result &result) {
+            return QFileInfo(result.filePath) == session;
+        });
+        if (results.size() > limit)
+            results.resize(limit);
+
+        if (results.isEmpty())
+            return LLMQore::ToolResult::text(QString("No saved chats match \"%1\".").arg(query));
+
+        QStringList entries;
+        for (const ChatHistorySearch::Result &result : std::as_const(results)) {
+            QString entry = QString("%1\nFile: %2\nSaved: %3, %4 message(s)")
+                                .arg(
+                                    result.title.isEmpty() ? QString("(untitled)") : result.title,
+                                    result.filePath,
+                                    QDateTime::fromMSecsSinceEpoch(result.modified)
+                                        .toString(Qt::ISODate))
+                                .arg(result.messageCount);
+            for (const QString &snippet : result.snippets)
+                entry += QString("\n> %1").arg(snippet);
+            entries.append(entry);
+        }
+
+        return LLMQore::ToolResult::text(
+            QString("%1 saved chat(s) matching \"%2\":\n\n%3")
+                .arg(results.size())
+                .arg(query, entries.join("\n\n---\n\n")));
+    });
+}
+
+void SearchChatHistoryTool::setCurrentSessionId(const QString &sessionId)
+{
+    QMutexLocker locker(&m_mutex);
+    m_currentSessionId = sessionId;
+}
+
+} // namespace QodeAssist::Tools
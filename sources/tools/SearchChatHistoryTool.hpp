@@ -0,0 +1,37 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#pragma once
+
+#include <LLMQore/BaseTool.hpp>
+
+#include <QMutex>
+#include <QString>
+
+namespace QodeAssist::Tools {
+
+class SearchChatHistoryTool : public ::LLMQore::BaseTool
+{
+    Q_OBJECT
+
+public:
+    explicit SearchChatHistoryTool(QObject *parent = nullptr);
+
+    QString id() const override;
+    QString displayName() const override;
+    QString description() const override;
+    QJsonObject parametersSchema() const override;
+
+    ::LLMQore::ToolSafety safety() const override { return ::LLMQore::ToolSafety::ReadOnly; }
+    QFuture<LLMQore::ToolResult> executeAsync(const QJsonObject &input = QJsonObject()) override;
+
+    // The chats searched are the ones saved next to this session's file.
+    void setCurrentSessionId(const QString &sessionId);
+
+private:
+    mutable QMutex m_mutex;
+    QString m_currentSessionId;
+};
+
+} // namespace QodeAssist::Tools
@@ -0,0 +1,291 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#include "SymbolIndex.hpp"
+
+#include <cplusplus/Overview.h>
+#include <cplusplus/Scope.h>
+#include <cplusplus/Symbols.h>
+#include <cppeditor/cppmodelmanager.h>
+#include <utils/aspects.h>
+
+#include <QElapsedTimer>
+#include <QMutexLocker>
+#include <QReadLocker>
+#include <QWriteLocker>
+
+#include <logger/Logger.hpp>
+#include <settings/ToolsSettings.hpp>
+
+namespace QodeAssist::Tools {
+
+namespace {
+
+quint8 kindsOf(CPlusPlus::Symbol *symbol)
+{
+    quint8 kinds = 0;
+    if (symbol->asClass())
+        kinds |= SymbolTable::Class;
+    if (symbol->asFunction())
+        kinds |= SymbolTable::Function;
+    if (symbol->asEnum())
+        kinds |= SymbolTable::Enum;
+    if (symbol->asDeclaration())
+        kinds |= SymbolTable::Declaration;
+    if (symbol->asNamespace())
+        kinds |= SymbolTable::Namespace;
+    return kinds;
+}
+
+} // namespace
+
+SymbolIndex &SymbolIndex::instance()
+{
+    static SymbolIndex index;
+    return index;
+}
+
+SymbolIndex::SymbolIndex(QObject *parent)
+    : QObject(parent)
+{
+    m_pool.setMaxThreadCount(1);
+}
+
+SymbolIndex::~SymbolIndex()
+{
+    m_stopping = true;
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+void SymbolIndex::init()
+{
+    if (m_initialized)
+        return;
+    m_initialized = true;
+
+    auto &settings = Settings::toolsSettings();
+    connect(&settings.enableProjectSearchTool, &Utils::BaseAspect::changed, this, [this] {
+        updateEnabled();
+    });
+    connect(&settings.indexProjectSearch, &Utils::BaseAspect::changed, this, [this] {
+        updateEnabled();
+    });
+
+    updateEnabled();
+}
+
+void SymbolIndex::shutdown()
+{
+    stop();
+}
+
+bool SymbolIndex::isReady() const
+{
+    return m_enabled && m_ready;
+}
+
+QList<SymbolTable::Symbol> SymbolIndex::find(
+    const QString &name, SymbolTable::Match match, Qt::CaseSensitivity caseSensitivity) const
+{
+    QReadLocker locker(&m_tableLock);
+    return m_table.find(name, match, caseSensitivity);
+}
+
+QList<SymbolTable::Symbol> SymbolIndex::find(const QRegularExpression &regex) const
+{
+    QReadLocker locker(&m_tableLock);
+    return m_table.find(regex);
+}
+
+QList<SymbolTable::Symbol> SymbolIndex::symbolsOf(const CPlusPlus::Document::Ptr &document)
+{
+    QList<SymbolTable::Symbol> symbols;
+    if (!document || !document->globalNamespace())
+        return symbols;
+
+    const QString filePath = document->filePath().path();
+    CPlusPlus::Overview overview;
+
+    const auto collect = [&](const auto &self, CPlusPlus::Scope *scope) -> void {
+        for (unsigned i = 0; i < scope->memberCount(); ++i) {
+            CPlusPlus::Symbol *symbol = scope->memberAt(i);
+            if (!symbol || !symbol->name())
+                continue;
+
+            SymbolTable::Symbol entry;
+            entry.name = overview.prettyName(symbol->name());
+            entry.filePath = filePath;
+            entry.line = symbol->line();
+            entry.kinds = kindsOf(symbol);
+            symbols.append(entry);
+
+            if (CPlusPlus::Scope *nestedScope = symbol->asScope())
+                self(self, nestedScope);
+        }
+    };
+
+    collect(collect, document->globalNamespace());
+    return symbols;
+}
+
+void SymbolIndex::updateEnabled()
+{
+    const auto &settings = Settings::toolsSettings();
+    const bool wanted = settings.enableProjectSearchTool() && settings.indexProjectSearch();
+    if (wanted == m_enabled)
+        return;
+
+    if (wanted)
+        start();
+    else
+        stop();
+}
+
+void SymbolIndex::start()
+{
+    auto *modelManager = CppEditor::CppModelManager::instance();
+    if (!modelManager)
+        return;
+
+    m_stopping = false;
+    m_enabled = true;
+
+    // Documents are published from the parser threads; only the queue is touched there.
+    m_modelConnections.append(connect(
+        modelManager,
+        &CppEditor::CppModelManager::documentUpdated,
+        this,
+        [this](const CPlusPlus::Document::Ptr &document) {
+            if (document)
+                enqueue(document->filePath().path(), document);
+        },
+        Qt::DirectConnection));
+    m_modelConnections.append(connect(
+        modelManager,
+        &CppEditor::CppModelManager::aboutToRemoveFiles,
+        this,
+        &SymbolIndex::removeFiles));
+
+    {
+        QMutexLocker locker(&m_queueMutex);
+        m_workerActive = true;
+    }
+    m_pool.start([this] {
+        indexSnapshot();
+        processQueue();
+    });
+}
+
+void SymbolIndex::stop()
+{
+    m_enabled = false;
+    m_ready = false;
+    m_stopping = true;
+
+    for (const QMetaObject::Connection &connection : std::as_const(m_modelConnections))
+        disconnect(connection);
+    m_modelConnections.clear();
+
+    m_pool.clear();
+    m_pool.waitForDone();
+
+    {
+        QMutexLocker locker(&m_queueMutex);
+        m_queue.clear();
+        m_pending.clear();
+        m_workerActive = false;
+    }
+
+    QWriteLocker locker(&m_tableLock);
+    m_table.clear();
+}
+
+void SymbolIndex::enqueue(const QString &filePath, const CPlusPlus::Document::Ptr &document)
+{
+    QMutexLocker locker(&m_queueMutex);
+    if (m_stopping)
+        return;
+
+    if (!m_pending.contains(filePath))
+        m_queue.append(filePath);
+    m_pending.insert(filePath, document);
+
+    if (!m_workerActive) {
+        m_workerActive = true;
+        m_pool.start([this] { processQueue(); });
+    }
+}
+
+void SymbolIndex::removeFiles(const QStringList &filePaths)
+{
+    // Queued rather than applied here so a walk already in flight cannot bring the file back.
+    for (const QString &filePath : filePaths)
+        enqueue(filePath, {});
+}
+
+void SymbolIndex::indexSnapshot()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    const CPlusPlus::Snapshot snapshot = CppEditor::CppModelManager::instance()->snapshot();
+    for (auto it = snapshot.begin(); it != snapshot.end(); ++it) {
+        if (m_stopping)
+            return;
+
+        const CPlusPlus::Document::Ptr document = it.value();
+        if (!document)
+            continue;
+
+        const QString filePath = document->filePath().path();
+        {
+            // A newer version of the document is already queued.
+            QMutexLocker locker(&m_queueMutex);
+            if (m_pending.contains(filePath))
+                continue;
+        }
+
+        const QList<SymbolTable::Symbol> symbols = symbolsOf(document);
+        QWriteLocker locker(&m_tableLock);
+        m_table.setFile(filePath, symbols);
+    }
+
+    m_ready = true;
+
+    QReadLocker locker(&m_tableLock);
+    LOG_MESSAGE(QString("Symbol index: indexed %1 symbols in %2 files in %3 ms")
+                    .arg(m_table.symbolCount())
+                    .arg(m_table.fileCount())
+                    .arg(timer.elapsed()));
+}
+
+void SymbolIndex::processQueue()
+{
+    while (true) {
+        QString filePath;
+        CPlusPlus::Document::Ptr document;
+        {
+            QMutexLocker locker(&m_queueMutex);
+            if (m_stopping || m_queue.isEmpty()) {
+                m_workerActive = false;
+                break;
+            }
+            filePath = m_queue.takeFirst();
+            document = m_pending.take(filePath);
+        }
+
+        if (!document) {
+            QWriteLocker locker(&m_tableLock);
+            m_table.removeFile(filePath);
+            continue;
+        }
+
+        const QList<SymbolTable::Symbol> symbols = symbolsOf(document);
+        QWriteLocker locker(&m_tableLock);
+        m_table.setFile(filePath, symbols);
+    }
+}
+
+} // namespace QodeAssist::Tools
@@ -0,0 +1,83 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#pragma once
+
+#include <cplusplus/CppDocument.h>
+
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QReadWriteLock>
+#include <QStringList>
+#include <QThreadPool>
+
+#include <atomic>
+
+#include "SymbolTable.hpp"
+
+namespace QodeAssist::Tools {
+
+/**
+ * @brief Name index over the symbols of every document in the C++ code model snapshot.
+ *
+ * Built from the snapshot once on start, then kept current from the documents the code model
+ * publishes as it reparses. Documents are walked on a background thread; bursts of updates
+ * to one file collapse into a single walk of its latest document.
+ */
+class SymbolIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    static SymbolIndex &instance();
+
+    void init();
+    void shutdown();
+
+    // False until the initial snapshot has been indexed; callers walk the code model meanwhile.
+    bool isReady() const;
+
+    // Thread-safe.
+    QList<SymbolTable::Symbol> find(
+        const QString &name, SymbolTable::Match match, Qt::CaseSensitivity caseSensitivity) const;
+    QList<SymbolTable::Symbol> find(const QRegularExpression &regex) const;
+
+    static QList<SymbolTable::Symbol> symbolsOf(const CPlusPlus::Document::Ptr &document);
+
+private:
+    explicit SymbolIndex(QObject *parent = nullptr);
+    ~SymbolIndex() override;
+    SymbolIndex(const SymbolIndex &) = delete;
+    SymbolIndex &operator=(const SymbolIndex &) = delete;
+
+    void updateEnabled();
+    void start();
+    void stop();
+
+    // A null document removes the file.
+    void enqueue(const QString &filePath, const CPlusPlus::Document::Ptr &document);
+    void removeFiles(const QStringList &filePaths);
+    void indexSnapshot();
+    void processQueue();
+
+    mutable QReadWriteLock m_tableLock;
+    SymbolTable m_table;
+
+    QMutex m_queueMutex;
+    QStringList m_queue;
+    QHash<QString, CPlusPlus::Document::Ptr> m_pending;
+    bool m_workerActive = false;
+
+    QThreadPool m_pool;
+    std::atomic<bool> m_enabled = false;
+    std::atomic<bool> m_ready = false;
+    std::atomic<bool> m_stopping = false;
+
+    // GUI thread only.
+    QList<QMetaObject::Connection> m_modelConnections;
+    bool m_initialized = false;
+};
+
+} // namespace QodeAssist::Tools
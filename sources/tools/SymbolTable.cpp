@@ -0,0 +1,125 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#include "SymbolTable.hpp"
+
+#include <QSet>
+
+namespace QodeAssist::Tools {
+
+void SymbolTable::setFile(const QString &filePath, const QList<Symbol> &symbols)
+{
+    removeFile(filePath);
+    if (symbols.isEmpty())
+        return;
+
+    QSet<QString> keys;
+    for (const Symbol &symbol : symbols) {
+        const QString key = symbol.name.toCaseFolded();
+        m_symbols[key].append(symbol);
+        keys.insert(key);
+    }
+    m_fileKeys.insert(filePath, QStringList(keys.cbegin(), keys.cend()));
+    m_symbolCount += int(symbols.size());
+}
+
+void SymbolTable::removeFile(const QString &filePath)
+{
+    const auto fileKeys = m_fileKeys.constFind(filePath);
+    if (fileKeys == m_fileKeys.constEnd())
+        return;
+
+    for (const QString &key : fileKeys.value()) {
+        const auto it = m_symbols.find(key);
+        if (it == m_symbols.end())
+            continue;
+        m_symbolCount -= int(it->removeIf(
+            [&filePath](const Symbol &symbol) { return symbol.filePath == filePath; }));
+        if (it->isEmpty())
+            m_symbols.erase(it);
+    }
+    m_fileKeys.erase(fileKeys);
+}
+
+void SymbolTable::clear()
+{
+    m_symbols.clear();
+    m_fileKeys.clear();
+    m_symbolCount = 0;
+}
+
+bool SymbolTable::containsFile(const QString &filePath) const
+{
+    return m_fileKeys.contains(filePath);
+}
+
+int SymbolTable::fileCount() const
+{
+    return int(m_fileKeys.size());
+}
+
+int SymbolTable::symbolCount() const
+{
+    return m_symbolCount;
+}
+
+QList<SymbolTable::Symbol> SymbolTable::find(
+    const QString &name, Match match, Qt::CaseSensitivity caseSensitivity) const
+{
+    QList<Symbol> result;
+    if (name.isEmpty())
+        return result;
+
+    const QString key = name.toCaseFolded();
+    const auto accept = [&](const Symbol &symbol) {
+        if (caseSensitivity == Qt::CaseInsensitive)
+            return true;
+        return match == Match::Exact ? symbol.name == name : symbol.name.startsWith(name);
+    };
+
+    if (match == Match::Exact) {
+        const auto it = m_symbols.constFind(key);
+        if (it == m_symbols.constEnd())
+            return result;
+        for (const Symbol &symbol : it.value()) {
+            if (accept(symbol))
+                result.append(symbol);
+        }
+        return result;
+    }
+
+    for (auto it = m_symbols.lowerBound(key);
+         it != m_symbols.constEnd() && it.key().startsWith(key);
+         ++it) {
+        for (const Symbol &symbol : it.value()) {
+            if (accept(symbol))
+                result.append(symbol);
+        }
+    }
+    return result;
+}
+
+QList<SymbolTable::Symbol> SymbolTable::find(const QRegularExpression &regex) const
+{
+    QList<Symbol> result;
+    if (!regex.isValid())
+        return result;
+
+    for (auto it = m_symbols.constBegin(); it != m_symbols.constEnd(); ++it) {
+        // Symbols under one key usually share the exact spelling; match each spelling once.
+        QString lastName;
+        bool lastMatched = false;
+        for (const Symbol &symbol : it.value()) {
+            if (symbol.name != lastName || lastName.isEmpty()) {
+                lastName = symbol.name;
+                lastMatched = regex.match(symbol.name).hasMatch();
+            }
+            if (lastMatched)
+                result.append(symbol);
+        }
+    }
+    return result;
+}
+
+} // namespace QodeAssist::Tools
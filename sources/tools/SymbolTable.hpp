@@ -0,0 +1,62 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QRegularExpression>
+#include <QString>
+#include <QStringList>
+
+namespace QodeAssist::Tools {
+
+/**
+ * @brief Symbol name to location lookup table, filled per file.
+ *
+ * Names are keyed by their case-folded form in a sorted map, so exact, prefix and
+ * case-insensitive lookups are a map search plus a scan of the matching keys. Not thread-safe;
+ * SymbolIndex guards it with a read-write lock.
+ */
+class SymbolTable
+{
+public:
+    enum Kind : quint8 {
+        Class = 0x01,
+        Function = 0x02,
+        Enum = 0x04,
+        Declaration = 0x08,
+        Namespace = 0x10,
+    };
+
+    enum class Match { Exact, Prefix };
+
+    struct Symbol
+    {
+        QString name;
+        QString filePath;
+        int line = 0;
+        quint8 kinds = 0;
+    };
+
+    void setFile(const QString &filePath, const QList<Symbol> &symbols);
+    void removeFile(const QString &filePath);
+    void clear();
+
+    bool containsFile(const QString &filePath) const;
+    int fileCount() const;
+    int symbolCount() const;
+
+    QList<Symbol> find(
+        const QString &name, Match match, Qt::CaseSensitivity caseSensitivity) const;
+    QList<Symbol> find(const QRegularExpression &regex) const;
+
+private:
+    QMap<QString, QList<Symbol>> m_symbols;
+    QHash<QString, QStringList> m_fileKeys;
+    int m_symbolCount = 0;
+};
+
+} // namespace QodeAssist::Tools
@@ -0,0 +1,302 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#include "TextScanner.hpp"
+
+#include <QFile>
+#include <QFuture>
+#include <QThread>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#include "TrigramIndex.hpp"
+
+namespace QodeAssist::Tools {
+
+namespace {
+
+constexpr qint64 kReadChunkSize = 1024 * 1024;
+
+inline bool isAsciiLetter(uchar byte)
+{
+    return (byte >= 'a' && byte <= 'z') || (byte >= 'A' && byte <= 'Z');
+}
+
+inline uchar foldByte(uchar byte)
+{
+    return (byte >= 'A' && byte <= 'Z') ? uchar(byte + ('a' - 'A')) : byte;
+}
+
+QByteArray longestAsciiRun(const QByteArray &bytes)
+{
+    qsizetype bestStart = 0;
+    qsizetype bestLength = 0;
+    qsizetype start = 0;
+    for (qsizetype i = 0; i <= bytes.size(); ++i) {
+        if (i < bytes.size() && uchar(bytes.at(i)) < 0x80)
+            continue;
+        if (i - start > bestLength) {
+            bestStart = start;
+            bestLength = i - start;
+        }
+        start = i + 1;
+    }
+    return bytes.mid(bestStart, bestLength);
+}
+
+// Only ASCII is folded on the byte level, so a folded needle keeps just its longest ASCII run.
+QByteArray searchableBytes(const QString &text, bool fold)
+{
+    const QByteArray bytes = text.toUtf8();
+    return fold ? longestAsciiRun(bytes).toLower() : bytes;
+}
+
+const char *findByte(const char *begin, const char *end, uchar byte)
+{
+    return static_cast<const char *>(std::memchr(begin, byte, size_t(end - begin)));
+}
+
+} // namespace
+
+TextScanner::TextScanner(const Options &options)
+    : m_options(options)
+{
+    if (options.useRegex) {
+        QRegularExpression::PatternOptions patternOptions = QRegularExpression::MultilineOption;
+        if (!options.caseSensitive)
+            patternOptions |= QRegularExpression::CaseInsensitiveOption;
+        m_regex = QRegularExpression(options.query, patternOptions);
+        m_verify = Verify::Regex;
+
+        // Inline options such as (?i) may turn case folding on for the whole pattern.
+        m_foldNeedle = !options.caseSensitive || options.query.contains(QLatin1String("(?"));
+        for (const QString &literal : requiredRegexLiterals(options.query)) {
+            const QByteArray bytes = searchableBytes(literal, m_foldNeedle);
+            if (bytes.size() > m_needle.size())
+                m_needle = bytes;
+        }
+    } else {
+        m_foldNeedle = !options.caseSensitive;
+        m_needle = searchableBytes(options.query, m_foldNeedle);
+
+        if (options.wholeWords) {
+            m_regex = QRegularExpression(
+                QString("\\b%1\\b").arg(QRegularExpression::escape(options.query)),
+                options.caseSensitive ? QRegularExpression::NoPatternOption
+                                      : QRegularExpression::CaseInsensitiveOption);
+            m_verify = Verify::Regex;
+        } else if (
+            m_needle.size() != options.query.toUtf8().size() || m_needle.contains('\n')
+            || m_needle.contains('\r')) {
+            // Either only part of the query could be searched for, or it can never match a line.
+            m_verify = Verify::Contains;
+        }
+    }
+
+    // A case-insensitive letter has to be searched for twice, so anchor on anything else.
+    if (m_foldNeedle) {
+        for (qsizetype i = 0; i < m_needle.size(); ++i) {
+            if (!isAsciiLetter(uchar(m_needle.at(i)))) {
+                m_anchor = i;
+                break;
+            }
+        }
+    }
+}
+
+bool TextScanner::isValid() const
+{
+    return m_verify != Verify::Regex || m_regex.isValid();
+}
+
+QList<TextScanner::Match> TextScanner::scan(const QStringList &files, int maxMatches) const
+{
+    QList<Match> result;
+    if (!isValid() || files.isEmpty())
+        return result;
+
+    const int limit = maxMatches + 1;
+    std::vector<QList<Match>> fileMatches(size_t(files.size()));
+    std::atomic<int> nextFile = 0;
+    std::atomic<int> found = 0;
+
+    // Files are claimed in order and every claimed file is scanned to the end (or to the limit),
+    // so the matches collected always form an exact prefix of the full, ordered result.
+    const auto work = [&] {
+        while (found.load(std::memory_order_relaxed) < limit) {
+            const int index = nextFile.fetch_add(1);
+            if (index >= files.size())
+                return;
+            QList<Match> &matches = fileMatches[size_t(index)];
+            scanFile(index, files.at(index), limit, matches);
+            found.fetch_add(int(matches.size()), std::memory_order_relaxed);
+        }
+    };
+
+    // The calling thread scans as well; waiting on a worker that has not started yet runs it
+    // inline, so this cannot starve when the pool is busy with other tool calls.
+    const int workerCount = int(std::min<qsizetype>(QThread::idealThreadCount(), files.size()));
+    QList<QFuture<void>> workers;
+    for (int i = 1; i < workerCount; ++i)
+        workers.append(QtConcurrent::run(work));
+    work();
+    for (QFuture<void> &worker : workers)
+        worker.waitForFinished();
+
+    for (const QList<Match> &matches : fileMatches) {
+        for (const Match &match : matches) {
+            if (result.size() == limit)
+                return result;
+            result.append(match);
+        }
+    }
+    return result;
+}
+
+void TextScanner::scanFile(
+    int fileIndex, const QString &path, int limit, QList<Match> &matches) const
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    // Read rather than mapped: a file truncated by another process while mapped raises SIGBUS.
+    // Whole lines are scanned chunk by chunk; a line cut by a chunk boundary waits for the next.
+    QByteArray buffer;
+    int lineNumber = 1;
+    bool first = true;
+    while (matches.size() < limit) {
+        const QByteArray chunk = file.read(kReadChunkSize);
+        const bool atEnd = chunk.isEmpty();
+        buffer.append(chunk);
+
+        if (first) {
+            if (buffer.startsWith("\xEF\xBB\xBF"))
+                buffer.remove(0, 3);
+            first = false;
+        }
+
+        const qsizetype end = atEnd ? buffer.size() : buffer.lastIndexOf('\n') + 1;
+        if (end > 0) {
+            const char *data = buffer.constData();
+            scanBytes(fileIndex, data, end, lineNumber, limit, matches);
+            lineNumber += int(std::count(data, data + end, '\n'));
+            buffer.remove(0, end);
+        }
+        if (atEnd)
+            return;
+    }
+}
+
+void TextScanner::scanBytes(
+    int fileIndex,
+    const char *data,
+    qsizetype size,
+    int firstLineNumber,
+    int limit,
+    QList<Match> &matches) const
+{
+    qsizetype pos = 0;
+    int lineNumber = firstLineNumber;
+    qsizetype countedUpTo = pos;
+
+    while (pos < size && matches.size() < limit) {
+        qsizetype lineStart = pos;
+        if (!m_needle.isEmpty()) {
+            const qsizetype hit = findNeedle(data, size, pos);
+            if (hit < 0)
+                return;
+            lineStart = hit;
+            while (lineStart > pos && data[lineStart - 1] != '\n')
+                --lineStart;
+        }
+
+        const char *newline = findByte(data + lineStart, data + size, '\n');
+        const qsizetype lineEnd = newline ? newline - data : size;
+
+        lineNumber += int(std::count(data + countedUpTo, data + lineStart, '\n'));
+        countedUpTo = lineStart;
+
+        qsizetype contentEnd = lineEnd;
+        if (contentEnd > lineStart && data[contentEnd - 1] == '\r')
+            --contentEnd;
+
+        const QString line = QString::fromUtf8(data + lineStart, contentEnd - lineStart);
+        if (lineMatches(line))
+            matches.append({fileIndex, lineNumber, line});
+
+        pos = lineEnd + 1;
+    }
+}
+
+qsizetype TextScanner::findNeedle(const char *data, qsizetype size, qsizetype from) const
+{
+    const qsizetype needleSize = m_needle.size();
+    if (size - from < needleSize)
+        return -1;
+
+    const char *needle = m_needle.constData();
+    const uchar anchor = uchar(needle[m_anchor]);
+    const bool foldAnchor = m_foldNeedle && isAsciiLetter(anchor);
+    const char *end = data + size - needleSize + m_anchor + 1;
+
+    // Next occurrences of the lowercase and uppercase anchor, kept between candidates.
+    const char *lowerHit = nullptr;
+    const char *upperHit = nullptr;
+
+    for (const char *begin = data + from + m_anchor; begin < end;) {
+        const char *hit = nullptr;
+        if (!foldAnchor) {
+            hit = findByte(begin, end, anchor);
+        } else {
+            if (!lowerHit || lowerHit < begin) {
+                lowerHit = findByte(begin, end, anchor);
+                lowerHit = lowerHit ? lowerHit : end;
+            }
+            if (!upperHit || upperHit < begin) {
+                upperHit = findByte(begin, end, uchar(anchor - ('a' - 'A')));
+                upperHit = upperHit ? upperHit : end;
+            }
+            hit = std::min(lowerHit, upperHit);
+            if (hit == end)
+                hit = nullptr;
+        }
+        if (!hit)
+            return -1;
+
+        const char *candidate = hit - m_anchor;
+        bool equal = true;
+        if (!m_foldNeedle) {
+            equal = std::memcmp(candidate, needle, size_t(needleSize)) == 0;
+        } else {
+            for (qsizetype i = 0; i < needleSize && equal; ++i)
+                equal = foldByte(uchar(candidate[i])) == uchar(needle[i]);
+        }
+        if (equal)
+            return candidate - data;
+
+        begin = hit + 1;
+    }
+    return -1;
+}
+
+bool TextScanner::lineMatches(const QString &line) const
+{
+    switch (m_verify) {
+    case Verify::None:
+        return true;
+    case Verify::Contains:
+        return line.contains(
+            m_options.query, m_options.caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive);
+    case Verify::Regex:
+        return m_regex.match(line).hasMatch();
+    }
+    return false;
+}
+
+} // namespace QodeAssist::Tools
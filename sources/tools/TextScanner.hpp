@@ -0,0 +1,73 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include <QRegularExpression>
+#include <QString>
+#include <QStringList>
+
+namespace QodeAssist::Tools {
+
+/**
+ * @brief Line-oriented text search over files, used by search_project in text mode.
+ *
+ * Files are read in large chunks and searched as raw UTF-8 bytes for a literal every matching
+ * line must contain; only lines around a hit are decoded and, when the literal alone does not
+ * decide the match, checked against the query. Files are spread over the global thread pool
+ * and the scan stops picking up new files once enough matches are found.
+ */
+class TextScanner
+{
+public:
+    struct Options
+    {
+        QString query;
+        bool caseSensitive = false;
+        bool useRegex = false;
+        bool wholeWords = false;
+    };
+
+    struct Match
+    {
+        int fileIndex = 0;
+        int lineNumber = 0;
+        QString line;
+    };
+
+    explicit TextScanner(const Options &options);
+
+    bool isValid() const;
+
+    // Matches in file and line order. When more than maxMatches lines match, exactly
+    // maxMatches + 1 are returned so callers can tell the output was cut short.
+    QList<Match> scan(const QStringList &files, int maxMatches) const;
+
+private:
+    enum class Verify { None, Contains, Regex };
+
+    void scanFile(int fileIndex, const QString &path, int limit, QList<Match> &matches) const;
+    // data holds whole lines, the first of which is firstLineNumber.
+    void scanBytes(
+        int fileIndex,
+        const char *data,
+        qsizetype size,
+        int firstLineNumber,
+        int limit,
+        QList<Match> &matches) const;
+    qsizetype findNeedle(const char *data, qsizetype size, qsizetype from) const;
+    bool lineMatches(const QString &line) const;
+
+    Options m_options;
+    QRegularExpression m_regex;
+    // Bytes every matching line contains; lowercase when m_foldNeedle is set.
+    QByteArray m_needle;
+    bool m_foldNeedle = false;
+    qsizetype m_anchor = 0;
+    Verify m_verify = Verify::None;
+};
+
+} // namespace QodeAssist::Tools
@@ -19,6 +19,7 @@
 #include "ProjectSearchTool.hpp"
 #include "ReadFileTool.hpp"
 #include "ReadOriginalHistoryTool.hpp"
+#include "SearchChatHistoryTool.hpp"
 #include "SkillTool.hpp"
 #include "TodoTool.hpp"
 
@@ -66,6 +67,8 @@ void registerQodeAssistTools(::LLMQore::ToolsManager *manager)
     wireTool<TodoTool>(manager, s.enableTodoTool, "todo_tool");
     wireTool<ReadOriginalHistoryTool>(
         manager, s.enableReadOriginalHistoryTool, "read_original_history");
+    wireTool<SearchChatHistoryTool>(
+        manager, s.enableSearchChatHistoryTool, "search_chat_history");
 }
 
 void registerSkillTool(
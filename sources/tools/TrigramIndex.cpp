@@ -0,0 +1,515 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#include "TrigramIndex.hpp"
+
+#include <QStringList>
+
+#include <algorithm>
+#include <iterator>
+
+namespace QodeAssist::Tools {
+
+namespace {
+
+constexpr int kCompactDeadThreshold = 1024;
+
+inline uchar foldByte(uchar byte)
+{
+    return (byte >= 'A' && byte <= 'Z') ? uchar(byte + ('a' - 'A')) : byte;
+}
+
+inline bool isLineBreak(uchar byte)
+{
+    return byte == '\n' || byte == '\r';
+}
+
+inline quint32 makeTrigram(uchar first, uchar second, uchar third)
+{
+    return (quint32(foldByte(first)) << 16) | (quint32(foldByte(second)) << 8)
+           | quint32(foldByte(third));
+}
+
+void sortUnique(std::vector<quint32> &values)
+{
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+}
+
+void appendLiteralTrigrams(const QString &literal, bool caseSensitive, std::vector<quint32> &out)
+{
+    const QByteArray bytes = literal.toUtf8();
+    const auto *data = reinterpret_cast<const uchar *>(bytes.constData());
+    for (qsizetype i = 0; i + 2 < bytes.size(); ++i) {
+        const uchar first = data[i];
+        const uchar second = data[i + 1];
+        const uchar third = data[i + 2];
+        if (isLineBreak(first) || isLineBreak(second) || isLineBreak(third))
+            continue;
+        // Only ASCII is folded, so non-ASCII bytes cannot be required when case is ignored.
+        if (!caseSensitive && (first >= 0x80 || second >= 0x80 || third >= 0x80))
+            continue;
+        out.push_back(makeTrigram(first, second, third));
+    }
+}
+
+// Returns the index just past the closing ']' of the class starting at start, or -1.
+qsizetype skipCharacterClass(const QString &pattern, qsizetype start)
+{
+    qsizetype i = start + 1;
+    if (i < pattern.size() && pattern.at(i) == '^')
+        ++i;
+    if (i < pattern.size() && pattern.at(i) == ']')
+        ++i;
+    while (i < pattern.size()) {
+        const QChar ch = pattern.at(i);
+        if (ch == '\\')
+            i += 2;
+        else if (ch == ']')
+            return i + 1;
+        else
+            ++i;
+    }
+    return -1;
+}
+
+// Returns the index of the ')' matching the '(' at openIndex, or -1.
+qsizetype findGroupEnd(const QString &pattern, qsizetype openIndex)
+{
+    int depth = 0;
+    qsizetype i = openIndex;
+    while (i < pattern.size()) {
+        const QChar ch = pattern.at(i);
+        if (ch == '\\') {
+            i += 2;
+            continue;
+        }
+        if (ch == '[') {
+            i = skipCharacterClass(pattern, i);
+            if (i < 0)
+                return -1;
+            continue;
+        }
+        if (ch == '(') {
+            ++depth;
+        } else if (ch == ')') {
+            if (--depth == 0)
+                return i;
+        }
+        ++i;
+    }
+    return -1;
+}
+
+QStringList splitTopLevelAlternatives(const QString &pattern, bool *ok)
+{
+    QStringList branches;
+    qsizetype branchStart = 0;
+    qsizetype i = 0;
+    *ok = true;
+
+    while (i < pattern.size()) {
+        const QChar ch = pattern.at(i);
+        if (ch == '\\') {
+            i += 2;
+        } else if (ch == '[') {
+            i = skipCharacterClass(pattern, i);
+        } else if (ch == '(') {
+            const qsizetype end = findGroupEnd(pattern, i);
+            i = end < 0 ? -1 : end + 1;
+        } else if (ch == '|') {
+            branches.append(pattern.mid(branchStart, i - branchStart));
+            branchStart = ++i;
+        } else {
+            ++i;
+        }
+
+        if (i < 0) {
+            *ok = false;
+            return {};
+        }
+    }
+
+    branches.append(pattern.mid(branchStart));
+    return branches;
+}
+
+// Parses a quantifier at position i. Returns false if there is none; otherwise sets minimum
+// to the least number of repetitions and end past the quantifier and its lazy/possessive mark.
+bool parseQuantifier(const QString &pattern, qsizetype i, int *minimum, qsizetype *end)
+{
+    if (i >= pattern.size())
+        return false;
+
+    const QChar ch = pattern.at(i);
+    qsizetype next = i + 1;
+    if (ch == '*' || ch == '?') {
+        *minimum = 0;
+    } else if (ch == '+') {
+        *minimum = 1;
+    } else if (ch == '{') {
+        qsizetype j = i + 1;
+        const qsizetype digitsStart = j;
+        while (j < pattern.size() && pattern.at(j).isDigit())
+            ++j;
+        if (j == digitsStart)
+            return false;
+        const int value = pattern.mid(digitsStart, j - digitsStart).toInt();
+        if (j < pattern.size() && pattern.at(j) == ',') {
+            ++j;
+            while (j < pattern.size() && pattern.at(j).isDigit())
+                ++j;
+        }
+        if (j >= pattern.size() || pattern.at(j) != '}')
+            return false;
+        *minimum = value;
+        next = j + 1;
+    } else {
+        return false;
+    }
+
+    if (next < pattern.size() && (pattern.at(next) == '?' || pattern.at(next) == '+'))
+        ++next;
+    *end = next;
+    return true;
+}
+
+// Collects literal runs every match of a branch without top-level alternation must contain.
+bool collectRequiredLiterals(const QString &branch, QStringList &runs)
+{
+    static const QString nonLiteralEscapes = QStringLiteral("dDwWsSbBAzZGhHvVRNX");
+
+    QString run;
+    const auto closeRun = [&] {
+        if (!run.isEmpty())
+            runs.append(run);
+        run.clear();
+    };
+
+    qsizetype i = 0;
+    while (i < branch.size()) {
+        const QChar ch = branch.at(i);
+        QString literal;
+        QString groupContent;
+        bool isGroup = false;
+        qsizetype atomEnd = i + 1;
+
+        if (ch == '\\') {
+            if (i + 1 >= branch.size())
+                return false;
+            const QChar escaped = branch.at(i + 1);
+            atomEnd = i + 2;
+            if (escaped == 't')
+                literal = QStringLiteral("\t");
+            else if (!escaped.isLetterOrNumber())
+                literal = escaped;
+            else if (!nonLiteralEscapes.contains(escaped))
+                return false;
+        } else if (ch == '[') {
+            atomEnd = skipCharacterClass(branch, i);
+            if (atomEnd < 0)
+                return false;
+        } else if (ch == '(') {
+            const qsizetype end = findGroupEnd(branch, i);
+            if (end < 0)
+                return false;
+            groupContent = branch.mid(i + 1, end - i - 1);
+            isGroup = true;
+            atomEnd = end + 1;
+        } else if (ch == '.' || ch == '^' || ch == '$') {
+            // Matches something, but nothing known.
+        } else if (ch == '*' || ch == '+' || ch == '?' || ch == ')') {
+            return false;
+        } else if (ch.isHighSurrogate() && i + 1 < branch.size()
+                   && branch.at(i + 1).isLowSurrogate()) {
+            literal = branch.mid(i, 2);
+            atomEnd = i + 2;
+        } else {
+            // Includes '{' that does not start a valid quantifier, which PCRE treats literally.
+            literal = ch;
+        }
+
+        int minimum = 1;
+        qsizetype quantifierEnd = atomEnd;
+        const bool quantified = parseQuantifier(branch, atomEnd, &minimum, &quantifierEnd);
+
+        if (!literal.isEmpty()) {
+            if (quantified && minimum == 0) {
+                closeRun();
+            } else {
+                run += literal;
+                if (quantified)
+                    closeRun();
+            }
+        } else if (isGroup && !(quantified && minimum == 0)) {
+            closeRun();
+            QString inner = groupContent;
+            if (inner.startsWith(QLatin1String("?:")))
+                inner = inner.mid(2);
+            else if (inner.startsWith('?'))
+                inner.clear(); // Lookaround, inline flags or named groups: skip.
+
+            bool ok = false;
+            const QStringList alternatives = splitTopLevelAlternatives(inner, &ok);
+            if (!ok)
+                return false;
+            if (alternatives.size() == 1 && !collectRequiredLiterals(inner, runs))
+                return false;
+        } else {
+            closeRun();
+        }
+
+        i = quantifierEnd;
+    }
+
+    closeRun();
+    return true;
+}
+
+} // namespace
+
+QStringList requiredRegexLiterals(const QString &pattern)
+{
+    bool ok = false;
+    const QStringList branches = splitTopLevelAlternatives(pattern, &ok);
+    QStringList runs;
+    if (!ok || branches.size() != 1 || !collectRequiredLiterals(pattern, runs))
+        return {};
+    return runs;
+}
+
+TrigramQuery TrigramQuery::forLiteral(const QString &text, bool caseSensitive)
+{
+    TrigramQuery query;
+    std::vector<quint32> trigrams;
+    appendLiteralTrigrams(text, caseSensitive, trigrams);
+    sortUnique(trigrams);
+    if (!trigrams.empty())
+        query.m_alternatives.append(std::move(trigrams));
+    return query;
+}
+
+TrigramQuery TrigramQuery::forRegex(const QString &pattern, bool caseSensitive)
+{
+    // Inline options such as (?i) may turn case folding on for the whole pattern.
+    if (pattern.contains(QLatin1String("(?")))
+        caseSensitive = false;
+
+    bool ok = false;
+    const QStringList branches = splitTopLevelAlternatives(pattern, &ok);
+    if (!ok)
+        return {};
+
+    TrigramQuery query;
+    for (const QString &branch : branches) {
+        QStringList runs;
+        if (!collectRequiredLiterals(branch, runs))
+            return {};
+
+        std::vector<quint32> trigrams;
+        for (const QString &run : std::as_const(runs))
+            appendLiteralTrigrams(run, caseSensitive, trigrams);
+        sortUnique(trigrams);
+
+        // One branch that can match anything makes the whole query unselective.
+        if (trigrams.empty())
+            return {};
+        query.m_alternatives.append(std::move(trigrams));
+    }
+    return query;
+}
+
+bool TrigramQuery::matchesAll() const
+{
+    return m_alternatives.isEmpty();
+}
+
+const QList<std::vector<quint32>> &TrigramQuery::alternatives() const
+{
+    return m_alternatives;
+}
+
+std::vector<quint32> TrigramIndex::trigramsOf(const QByteArray &content)
+{
+    std::vector<quint32> trigrams;
+    const auto *data = reinterpret_cast<const uchar *>(content.constData());
+    const qsizetype size = content.size();
+    if (size < 3)
+        return trigrams;
+
+    trigrams.reserve(size_t(size));
+    for (qsizetype i = 0; i + 2 < size; ++i) {
+        const uchar third = data[i + 2];
+        if (isLineBreak(third)) {
+            i += 2;
+            continue;
+        }
+        const uchar first = data[i];
+        const uchar second = data[i + 1];
+        if (isLineBreak(first) || isLineBreak(second))
+            continue;
+        trigrams.push_back(makeTrigram(first, second, third));
+    }
+
+    sortUnique(trigrams);
+    trigrams.shrink_to_fit();
+    return trigrams;
+}
+
+void TrigramIndex::setFile(const QString &path, const std::vector<quint32> &trigrams, qint64 stamp)
+{
+    const auto existing = m_ids.constFind(path);
+    if (existing != m_ids.constEnd())
+        markDead(existing.value());
+
+    const auto id = FileId(m_entries.size());
+    m_entries.push_back({path, stamp, true});
+    m_ids.insert(path, id);
+
+    for (const quint32 trigram : trigrams)
+        m_postings[trigram].push_back(id);
+
+    if (m_deadCount > kCompactDeadThreshold && m_deadCount > m_ids.size())
+        compact();
+}
+
+void TrigramIndex::removeFile(const QString &path)
+{
+    const auto it = m_ids.constFind(path);
+    if (it == m_ids.constEnd())
+        return;
+
+    markDead(it.value());
+    m_ids.erase(it);
+}
+
+void TrigramIndex::clear()
+{
+    m_ids.clear();
+    m_entries.clear();
+    m_postings.clear();
+    m_deadCount = 0;
+}
+
+bool TrigramIndex::contains(const QString &path) const
+{
+    return m_ids.contains(path);
+}
+
+qint64 TrigramIndex::stamp(const QString &path) const
+{
+    const auto it = m_ids.constFind(path);
+    return it != m_ids.constEnd() ? m_entries[it.value()].stamp : 0;
+}
+
+QStringList TrigramIndex::files() const
+{
+    return m_ids.keys();
+}
+
+int TrigramIndex::fileCount() const
+{
+    return int(m_ids.size());
+}
+
+QSet<QString> TrigramIndex::candidates(const TrigramQuery &query) const
+{
+    QSet<QString> result;
+    if (query.matchesAll()) {
+        for (auto it = m_ids.constBegin(); it != m_ids.constEnd(); ++it)
+            result.insert(it.key());
+        return result;
+    }
+
+    for (const std::vector<quint32> &required : query.alternatives()) {
+        std::vector<const std::vector<FileId> *> lists;
+        lists.reserve(required.size());
+        bool missing = false;
+        for (const quint32 trigram : required) {
+            const auto it = m_postings.constFind(trigram);
+            if (it == m_postings.constEnd()) {
+                missing = true;
+                break;
+            }
+            lists.push_back(&it.value());
+        }
+        if (missing || lists.empty())
+            continue;
+
+        std::sort(lists.begin(), lists.end(), [](const auto *left, const auto *right) {
+            return left->size() < right->size();
+        });
+
+        std::vector<FileId> current = *lists.front();
+        for (size_t k = 1; k < lists.size() && !current.empty(); ++k) {
+            std::vector<FileId> next;
+            next.reserve(current.size());
+            std::set_intersection(
+                current.begin(),
+                current.end(),
+                lists[k]->begin(),
+                lists[k]->end(),
+                std::back_inserter(next));
+            current.swap(next);
+        }
+
+        for (const FileId id : current) {
+            const FileEntry &entry = m_entries[id];
+            if (entry.live)
+                result.insert(entry.path);
+        }
+    }
+
+    return result;
+}
+
+void TrigramIndex::compact()
+{
+    if (m_deadCount == 0)
+        return;
+
+    std::vector<FileId> remap(m_entries.size(), FileId(-1));
+    std::vector<FileEntry> entries;
+    entries.reserve(m_ids.size());
+    for (size_t id = 0; id < m_entries.size(); ++id) {
+        if (!m_entries[id].live)
+            continue;
+        remap[id] = FileId(entries.size());
+        entries.push_back(std::move(m_entries[id]));
+    }
+
+    for (auto it = m_postings.begin(); it != m_postings.end();) {
+        std::vector<FileId> &ids = it.value();
+        auto out = ids.begin();
+        for (const FileId id : ids) {
+            if (remap[id] != FileId(-1))
+                *out++ = remap[id];
+        }
+        ids.erase(out, ids.end());
+        if (ids.empty()) {
+            it = m_postings.erase(it);
+        } else {
+            ids.shrink_to_fit();
+            ++it;
+        }
+    }
+
+    for (auto it = m_ids.begin(); it != m_ids.end(); ++it)
+        it.value() = remap[it.value()];
+
+    m_entries = std::move(entries);
+    m_deadCount = 0;
+}
+
+void TrigramIndex::markDead(FileId id)
+{
+    FileEntry &entry = m_entries[id];
+    if (!entry.live)
+        return;
+    entry.live = false;
+    entry.path.clear();
+    ++m_deadCount;
+}
+
+} // namespace QodeAssist::Tools
@@ -0,0 +1,92 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+#include <vector>
+
+namespace QodeAssist::Tools {
+
+/**
+ * @brief Trigrams a text query needs to be present in a file for the file to possibly match.
+ *
+ * Trigrams are three UTF-8 bytes with ASCII letters lowercased, the same folding TrigramIndex
+ * uses, so one index serves case-sensitive and case-insensitive searches. A file is a candidate
+ * when it contains every trigram of at least one alternative. An empty alternatives() list
+ * means the query could not be narrowed and every file is a candidate.
+ */
+class TrigramQuery
+{
+public:
+    static TrigramQuery forLiteral(const QString &text, bool caseSensitive);
+
+    // Conservative: only literal runs every match must contain are used. Anything that is
+    // not understood (back-references, \Q...\E, nested alternation) widens the query.
+    static TrigramQuery forRegex(const QString &pattern, bool caseSensitive);
+
+    bool matchesAll() const;
+    const QList<std::vector<quint32>> &alternatives() const;
+
+private:
+    QList<std::vector<quint32>> m_alternatives;
+};
+
+// Literal runs every match of pattern must contain. Empty when the pattern has top-level
+// alternation or uses constructs TrigramQuery::forRegex() does not understand.
+QStringList requiredRegexLiterals(const QString &pattern);
+
+/**
+ * @brief In-memory trigram posting lists over file contents.
+ *
+ * File ids only grow, so appending a re-indexed file keeps every posting list sorted. Replaced
+ * and removed files leave dead ids behind until compact() rewrites the lists. Not thread-safe;
+ * ProjectTextIndex guards it with a read-write lock.
+ */
+class TrigramIndex
+{
+public:
+    // Sorted, unique, case-folded trigrams of content. Trigrams spanning a line break are
+    // skipped because text search matches single lines.
+    static std::vector<quint32> trigramsOf(const QByteArray &content);
+
+    void setFile(const QString &path, const std::vector<quint32> &trigrams, qint64 stamp = 0);
+    void removeFile(const QString &path);
+    void clear();
+
+    bool contains(const QString &path) const;
+    qint64 stamp(const QString &path) const;
+    QStringList files() const;
+    int fileCount() const;
+
+    // Indexed files that may match; files that are not indexed are never returned.
+    QSet<QString> candidates(const TrigramQuery &query) const;
+
+    void compact();
+
+private:
+    using FileId = quint32;
+
+    struct FileEntry
+    {
+        QString path;
+        qint64 stamp = 0;
+        bool live = false;
+    };
+
+    void markDead(FileId id);
+
+    QHash<QString, FileId> m_ids;
+    std::vector<FileEntry> m_entries;
+    QHash<quint32, std::vector<FileId>> m_postings;
+    int m_deadCount = 0;
+};
+
+} // namespace QodeAssist::Tools
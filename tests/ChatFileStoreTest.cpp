@@ -7,11 +7,15 @@
 #include <QDir>
 #include <QFile>
 #include <QJsonArray>
+#include <QJsonDocument>
 #include <QJsonObject>
 #include <QTemporaryDir>
 #include <QTest>
 
 #include "ChatView/ChatFileStore.hpp"
+#include "ChatView/SessionFileRegistry.hpp"
+#include "ChatView/StoredContentCache.hpp"
+#include "SessionTestSupport.hpp"
 #include "acp/AgentBinding.hpp"
 #include "session/HistorySerializer.hpp"
 #include "session/Session.hpp"
@@ -73,4 +77,177 @@ void ChatFileStoreTest::testLegacyChatFileLoadsThroughTheFileStore()
     QCOMPARE(history.at(1).role, Session::MessageRole::Assistant);
 }
 
+void ChatFileStoreTest::testStoredContentCacheRereadsChangedFiles()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QString chatFilePath = dir.filePath("chat.json");
+    QString storedPath;
+    const QString firstBase64 = QString::fromLatin1(QByteArray("first").toBase64());
+    QVERIFY(Chat::ChatFileStore::saveContentToStorage(
+        chatFilePath, "notes.txt", firstBase64, storedPath));
+    const QString fullPath
+        = QDir(Chat::ChatFileStore::getChatContentFolder(chatFilePath)).filePath(storedPath);
+
+    Chat::StoredContentCache cache(1024);
+    QCOMPARE(cache.text(chatFilePath, storedPath), QString("first"));
+    QCOMPARE(cache.base64(chatFilePath, storedPath), firstBase64);
+    QVERIFY(cache.cachedBytes() > 0);
+
+    const auto rewrite = [&fullPath](const QByteArray &content, const QDateTime &modified) {
+        QFile file(fullPath);
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write(content);
+        QVERIFY(file.setFileTime(modified, QFileDevice::FileModificationTime));
+    };
+
+    // Same size and time: the stored file is taken to be unchanged and is not read again.
+    const QDateTime modified = QFileInfo(fullPath).lastModified();
+    rewrite("other", modified);
+    QCOMPARE(cache.text(chatFilePath, storedPath), QString("first"));
+
+    rewrite("changed", modified.addSecs(10));
+    QCOMPARE(cache.text(chatFilePath, storedPath), QString("changed"));
+
+    // Payloads that do not fit are returned without being kept.
+    rewrite(QByteArray(2048, 'x'), modified.addSecs(20));
+    QCOMPARE(cache.text(chatFilePath, storedPath).size(), 2048);
+    QVERIFY(cache.cachedBytes() <= 1024);
+
+    QVERIFY(QFile::remove(fullPath));
+    QVERIFY(cache.text(chatFilePath, storedPath).isEmpty());
+
+    cache.clear();
+    QCOMPARE(cache.cachedBytes(), 0);
+}
+
+void ChatFileStoreTest::testSavingAgainAppendsToTheJournal()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString filePath = dir.filePath("journal.json");
+
+    const auto readAll = [&filePath] {
+        QFile file(filePath);
+        return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+    };
+
+    Session::Session session;
+    Chat::ChatFileStore store(&session);
+
+    session.setHistory(sampleHistory());
+    QVERIFY(store.save(filePath).success);
+    const QByteArray first = readAll();
+    QVERIFY(Session::HistorySerializer::isJournal(first));
+
+    Session::ConversationHistory history = sampleHistory();
+    history.lastMessage()->blocks.append(Session::TextBlock{"and one more thing"});
+    session.setHistory(history);
+    QVERIFY(store.save(filePath).success);
+    const QByteArray second = readAll();
+    QVERIFY(second.size() > first.size());
+    QVERIFY(second.startsWith(first));
+
+    // A store that loaded the journal keeps appending to it.
+    Session::Session reopened;
+    Chat::ChatFileStore reopenedStore(&reopened);
+    QVERIFY(reopenedStore.load(filePath).success);
+    QCOMPARE(reopened.history(), history);
+
+    history.lastMessage()->blocks.append(Session::TextBlock{"and another"});
+    reopened.setHistory(history);
+    QVERIFY(reopenedStore.save(filePath).success);
+    QVERIFY(readAll().startsWith(second));
+
+    // A crash mid-write leaves part of a record behind; it is skipped on load and the next save
+    // rewrites the file without it.
+    {
+        QFile file(filePath);
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Append));
+        file.write("{\"op\":\"message\",\"ind");
+    }
+
+    Session::Session recovered;
+    Chat::ChatFileStore recoveredStore(&recovered);
+    const Chat::SerializationResult result = recoveredStore.load(filePath);
+    QVERIFY(result.success);
+    QVERIFY(!result.warningMessage.isEmpty());
+    QCOMPARE(recovered.history(), history);
+
+    QVERIFY(recoveredStore.save(filePath).success);
+    const auto replay = Session::HistorySerializer::replayJournal(readAll());
+    QVERIFY(replay.has_value());
+    QVERIFY(!replay->recoveredTail);
+    QCOMPARE(Session::HistorySerializer::fromJson(replay->root), history);
+}
+
+void ChatFileStoreTest::testRequestedSavesAreWrittenInTheBackground()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString filePath = dir.filePath("autosave.json");
+
+    Session::Session session;
+    Chat::ChatFileStore store(&session);
+
+    Session::ConversationHistory history = sampleHistory();
+    for (int i = 0; i < 50; ++i) {
+        history.lastMessage()->blocks.append(Session::TextBlock{QString("part %1").arg(i)});
+        session.setHistory(history);
+        store.requestSave(filePath);
+    }
+
+    // The snapshot is taken when the save is requested.
+    session.setHistory(sampleHistory());
+    store.flush();
+
+    Session::Session reopened;
+    Chat::ChatFileStore reopenedStore(&reopened);
+    QVERIFY(reopenedStore.load(filePath).success);
+    QCOMPARE(reopened.history(), history);
+
+    // A synchronous save waits for the requested ones, so it is never overwritten by them.
+    history.lastMessage()->blocks.append(Session::TextBlock{"saved last"});
+    session.setHistory(sampleHistory());
+    store.requestSave(filePath);
+    session.setHistory(history);
+    QVERIFY(store.save(filePath).success);
+    store.flush();
+
+    QVERIFY(reopenedStore.load(filePath).success);
+    QCOMPARE(reopened.history(), history);
+}
+
+void ChatFileStoreTest::testSwitchingChatsWritesPendingSavesFirst()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString firstPath = dir.filePath("first.json");
+    const QString secondPath = dir.filePath("second.json");
+
+    Chat::SessionFileRegistry registry;
+    Session::Session session;
+    Chat::ChatFileStore store(&session);
+
+    Session::ConversationHistory history = sampleHistory();
+    for (int i = 0; i < 200; ++i)
+        history.lastMessage()->blocks.append(Session::TextBlock{QString("part %1").arg(i)});
+    session.setHistory(history);
+    QVERIFY(registry.lock(firstPath));
+    store.requestSave(firstPath);
+
+    // Switching to another chat releases the first while its save may still be waiting.
+    store.releaseFile(&registry, firstPath);
+    QVERIFY(registry.lock(secondPath));
+    QVERIFY(!registry.isLocked(firstPath));
+
+    // Whoever takes the released file next finds it complete.
+    QVERIFY(registry.lock(firstPath));
+    Session::Session reopened;
+    Chat::ChatFileStore reopenedStore(&reopened);
+    QVERIFY(reopenedStore.load(firstPath).success);
+    QCOMPARE(reopened.history(), history);
+}
+
 } // namespace QodeAssist
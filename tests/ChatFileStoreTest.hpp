@@ -15,6 +15,10 @@ class ChatFileStoreTest final : public QObject
 private slots:
     void testChatFileStoreRoundTripsStoredContent();
     void testLegacyChatFileLoadsThroughTheFileStore();
+    void testStoredContentCacheRereadsChangedFiles();
+    void testSavingAgainAppendsToTheJournal();
+    void testRequestedSavesAreWrittenInTheBackground();
+    void testSwitchingChatsWritesPendingSavesFirst();
 };
 
 } // namespace QodeAssist
@@ -5,6 +5,7 @@
 #include "ChatHistorySerializerTest.hpp"
 
 #include <QJsonArray>
+#include <QJsonDocument>
 #include <QJsonObject>
 #include <QTest>
 
@@ -260,4 +261,84 @@ void ChatHistorySerializerTest::testAdjacentThinkingBlocksSurviveReload()
     QCOMPARE(Session::buildFromRows(rows), history);
 }
 
+void ChatHistorySerializerTest::testJournalReplaysEachChange()
+{
+    using Session::HistorySerializer;
+
+    const auto replayed = [](const QByteArray &journal) -> Session::ConversationHistory {
+        const auto replay = HistorySerializer::replayJournal(journal);
+        if (!replay || replay->recoveredTail || replay->validLength != journal.size())
+            return {};
+        return HistorySerializer::fromJson(replay->root)
+            .value_or(Session::ConversationHistory{});
+    };
+
+    Session::ConversationHistory history = sampleHistory();
+    QByteArray journal = HistorySerializer::toJournal(history, {{"agent", "meta"}});
+    QVERIFY(HistorySerializer::isJournal(journal));
+    QCOMPARE(replayed(journal), history);
+    QCOMPARE(HistorySerializer::replayJournal(journal)->root.value("agent").toString(), QString("meta"));
+
+    Session::ConversationHistory written = history;
+    const auto append = [&] {
+        journal += HistorySerializer::journalRecords(written, history);
+        written = history;
+    };
+
+    // A growing message only gets its new blocks written.
+    history.lastMessage()->blocks.append(Session::TextBlock{"one more thing"});
+    const QByteArray grown = HistorySerializer::journalRecords(written, history);
+    QVERIFY(grown.contains("\"op\":\"blocks\""));
+    QVERIFY(!grown.contains("here is the answer"));
+    append();
+    QCOMPARE(replayed(journal), history);
+
+    Session::Message followUp;
+    followUp.role = Session::MessageRole::User;
+    followUp.id = "u2";
+    followUp.blocks = {Session::TextBlock{"and then?"}};
+    history.append(followUp);
+    append();
+    QCOMPARE(replayed(journal), history);
+
+    QVERIFY(HistorySerializer::journalRecords(written, history).isEmpty());
+
+    // Editing an earlier message drops the ones after it.
+    Session::Message edited = history.at(0);
+    edited.blocks = {Session::TextBlock{"a different question"}};
+    history = {};
+    history.append(edited);
+    append();
+    QCOMPARE(replayed(journal), history);
+
+    journal += HistorySerializer::journalMetaRecord({});
+    QVERIFY(!HistorySerializer::replayJournal(journal)->root.contains("agent"));
+
+    QVERIFY(!HistorySerializer::isJournal(
+        QJsonDocument(HistorySerializer::toJson(history)).toJson(QJsonDocument::Indented)));
+}
+
+void ChatHistorySerializerTest::testJournalRecoversFromAnIncompleteTail()
+{
+    using Session::HistorySerializer;
+
+    const Session::ConversationHistory history = sampleHistory();
+    const QByteArray complete = HistorySerializer::toJournal(history);
+
+    Session::ConversationHistory extended = history;
+    extended.lastMessage()->blocks.append(Session::TextBlock{"cut off"});
+    const QByteArray nextRecord = HistorySerializer::journalRecords(history, extended);
+
+    for (const QByteArray &tail :
+         {nextRecord.left(nextRecord.size() / 2), QByteArray("not json\n"), QByteArray("{}\n")}) {
+        const auto replay = HistorySerializer::replayJournal(complete + tail);
+        QVERIFY(replay.has_value());
+        QVERIFY(replay->recoveredTail);
+        QCOMPARE(replay->validLength, complete.size());
+        QCOMPARE(HistorySerializer::fromJson(replay->root), history);
+    }
+
+    QVERIFY(!HistorySerializer::replayJournal("{\"journal\":99}\n").has_value());
+}
+
 } // namespace QodeAssist
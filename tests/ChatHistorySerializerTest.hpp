@@ -23,6 +23,8 @@ private slots:
     void testCompressedChatShapeReloadsAsOneAssistantRow();
     void testHistoryAppliesToChatModel();
     void testAdjacentThinkingBlocksSurviveReload();
+    void testJournalReplaysEachChange();
+    void testJournalRecoversFromAnIncompleteTail();
 };
 
 } // namespace QodeAssist
@@ -4,6 +4,7 @@
 
 #include "ChatViewTest.hpp"
 
+#include <QSignalSpy>
 #include <QTest>
 
 #include "ChatView/ChatModel.hpp"
@@ -74,4 +75,57 @@ void ChatViewTest::testChatModelExposesSessionRowsDirectly()
     QCOMPARE(model.data(model.index(0), Chat::ChatModel::ToolStatus).toString(), QString("failed"));
 }
 
+void ChatViewTest::testChatModelCoalescesStreamedContent()
+{
+    Chat::ChatModel model;
+
+    Session::MessageRow assistant;
+    assistant.kind = Session::RowKind::Assistant;
+    assistant.id = "a1";
+    Session::MessageRow tool;
+    tool.kind = Session::RowKind::AgentTool;
+    tool.id = "t1";
+    tool.toolStatus = "running";
+    model.resetMessages({tool, assistant});
+
+    QSignalSpy changes(&model, &Chat::ChatModel::dataChanged);
+    const auto rolesOf = [&changes](int signal) {
+        return changes.at(signal).at(2).value<QList<int>>();
+    };
+
+    for (const QString token : {"one", " two", " three"}) {
+        assistant.content += token;
+        model.updateMessage(1, assistant);
+    }
+    QCOMPARE(
+        model.data(model.index(1), Chat::ChatModel::Content).toString(), QString("one two three"));
+    QCOMPARE(changes.count(), 0);
+
+    QTRY_COMPARE(changes.count(), 1);
+    QCOMPARE(changes.at(0).at(0).value<QModelIndex>().row(), 1);
+    QCOMPARE(rolesOf(0), (QList<int>{Chat::ChatModel::Content, Chat::ChatModel::Parts}));
+
+    // Anything other than streamed text reaches the view at once, with only its roles.
+    tool.toolStatus = "completed";
+    model.updateMessage(0, tool);
+    QCOMPARE(changes.count(), 2);
+    QCOMPARE(rolesOf(1), QList<int>{Chat::ChatModel::ToolStatus});
+
+    // Pending text is delivered along with a later change to the same row.
+    assistant.content += " four";
+    model.updateMessage(1, assistant);
+    assistant.usage = Session::Usage{10, 5, 0, 0};
+    model.updateMessage(1, assistant);
+    QCOMPARE(changes.count(), 3);
+    QVERIFY(rolesOf(2).contains(Chat::ChatModel::Content));
+    QVERIFY(rolesOf(2).contains(Chat::ChatModel::TotalTokens));
+    QVERIFY(!rolesOf(2).contains(Chat::ChatModel::Images));
+
+    // Updates that change nothing the view shows are not announced.
+    assistant.signature = "sig";
+    model.updateMessage(1, assistant);
+    QTest::qWait(50);
+    QCOMPARE(changes.count(), 3);
+}
+
 } // namespace QodeAssist
@@ -15,6 +15,7 @@ class ChatViewTest final : public QObject
 private slots:
     void testFileMentionSelectionFollowsChatToolsSetting();
     void testChatModelExposesSessionRowsDirectly();
+    void testChatModelCoalescesStreamedContent();
 };
 
 } // namespace QodeAssist
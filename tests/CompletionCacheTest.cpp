@@ -0,0 +1,167 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#include "CompletionCacheTest.hpp"
+
+#include <QTest>
+
+#include "completion/CompletionCache.hpp"
+
+namespace QodeAssist {
+
+namespace {
+
+const QString kFile = QStringLiteral("/p/main.cpp");
+const QString kPrefix = QStringLiteral("int main() {\n    ");
+const QString kSuffix = QStringLiteral("\n}\n");
+
+// The document is prefix + suffix with the cursor in between, and the whole of it is sent.
+CompletionCache::Key keyAt(const QString &prefix, const QString &suffix)
+{
+    return CompletionCache::keyFor(int(prefix.size()), prefix, suffix);
+}
+
+std::optional<QString> findAt(
+    CompletionCache &cache,
+    const QString &prefix,
+    const QString &suffix,
+    const QString &file = kFile)
+{
+    return cache.find(file, int(prefix.size()), prefix, suffix);
+}
+
+QString lookup(CompletionCache &cache, const QString &prefix, const QString &suffix = kSuffix)
+{
+    return findAt(cache, prefix, suffix).value_or(QString());
+}
+
+} // namespace
+
+void CompletionCacheTest::testSameSpotHits()
+{
+    CompletionCache cache;
+    QVERIFY(!findAt(cache, kPrefix, kSuffix));
+
+    cache.insert(kFile, keyAt(kPrefix, kSuffix), QStringLiteral("return 0;"));
+    QCOMPARE(lookup(cache, kPrefix), QStringLiteral("return 0;"));
+    QVERIFY(!findAt(cache, kPrefix, kSuffix, QStringLiteral("/p/other.cpp")));
+
+    cache.insert(kFile, keyAt(kPrefix, kSuffix), QStringLiteral("  \n"));
+    QCOMPARE(cache.entryCount(kFile), 1);
+}
+
+void CompletionCacheTest::testTypingIntoSuggestion()
+{
+    CompletionCache cache;
+    cache.insert(kFile, keyAt(kPrefix, kSuffix), QStringLiteral("return 0;\n    }"));
+
+    QCOMPARE(lookup(cache, kPrefix + "ret"), QStringLiteral("urn 0;\n    }"));
+    QCOMPARE(lookup(cache, kPrefix + "return "), QStringLiteral("0;\n    }"));
+    QCOMPARE(lookup(cache, kPrefix + "return 0;\n  "), QStringLiteral("  }"));
+    QVERIFY(!findAt(cache, kPrefix + "rex", kSuffix));
+    // Nothing is left to suggest once the whole suggestion has been typed.
+    QVERIFY(!findAt(cache, kPrefix + "return 0;\n    }", kSuffix));
+    // Typed the start of the suggestion somewhere else.
+    QVERIFY(!findAt(cache, "long " + kPrefix + "ret", kSuffix));
+}
+
+void CompletionCacheTest::testChangedTextMisses()
+{
+    CompletionCache cache;
+    cache.insert(kFile, keyAt(kPrefix, kSuffix), QStringLiteral("return 0;"));
+
+    QVERIFY(!findAt(cache, kPrefix, "\n};\n"));
+    QVERIFY(!findAt(cache, "#include <cstdio>\n" + kPrefix, kSuffix));
+    QVERIFY(!findAt(cache, kPrefix.left(kPrefix.size() - 1), kSuffix));
+    QVERIFY(!findAt(cache, "INT" + kPrefix.mid(3), kSuffix));
+}
+
+void CompletionCacheTest::testOnlySentWindowCounts()
+{
+    const QString head = QStringLiteral("// header\n");
+    const QString tail = QStringLiteral("// footer\n");
+    CompletionCache cache;
+    // Only kPrefix and kSuffix went out with the request; the document continues both ways.
+    cache.insert(
+        kFile,
+        CompletionCache::keyFor(int(head.size() + kPrefix.size()), kPrefix, kSuffix),
+        QStringLiteral("return 0;"));
+
+    const auto findIn = [&cache](const QString &before, const QString &after) {
+        return cache.find(kFile, int(before.size()), before, after);
+    };
+    QCOMPARE(
+        findIn("// HEADER\n" + kPrefix, kSuffix + "// FOOTER\n").value_or(QString()),
+        QStringLiteral("return 0;"));
+    QCOMPARE(
+        findIn(head + kPrefix + "re", kSuffix + tail).value_or(QString()),
+        QStringLiteral("turn 0;"));
+    // Too little text passed in to compare the window with.
+    QVERIFY(!cache.find(kFile, int(head.size() + kPrefix.size()), kPrefix.mid(1), kSuffix));
+    QVERIFY(!findIn(head + kPrefix, kSuffix.left(1)));
+}
+
+void CompletionCacheTest::testLeastRecentlyUsedIsEvicted()
+{
+    CompletionCache cache(2);
+    const auto spot = [](int n) { return QString("int value%1 = ").arg(n); };
+
+    cache.insert(kFile, keyAt(spot(1), kSuffix), QStringLiteral("1;"));
+    cache.insert(kFile, keyAt(spot(2), kSuffix), QStringLiteral("2;"));
+    QVERIFY(findAt(cache, spot(1), kSuffix));
+
+    cache.insert(kFile, keyAt(spot(3), kSuffix), QStringLiteral("3;"));
+    QCOMPARE(cache.entryCount(kFile), 2);
+    QCOMPARE(lookup(cache, spot(1)), QStringLiteral("1;"));
+    QVERIFY(!findAt(cache, spot(2), kSuffix));
+    QCOMPARE(lookup(cache, spot(3)), QStringLiteral("3;"));
+}
+
+void CompletionCacheTest::testRemoveDocument()
+{
+    CompletionCache cache;
+    const QString otherFile = QStringLiteral("/p/other.cpp");
+    cache.insert(kFile, keyAt(kPrefix, kSuffix), QStringLiteral("return 0;"));
+    cache.insert(otherFile, keyAt(kPrefix, kSuffix), QStringLiteral("return 1;"));
+
+    cache.removeDocument(kFile);
+    QCOMPARE(cache.entryCount(kFile), 0);
+    QVERIFY(!findAt(cache, kPrefix, kSuffix));
+    QCOMPARE(
+        findAt(cache, kPrefix, kSuffix, otherFile).value_or(QString()),
+        QStringLiteral("return 1;"));
+}
+
+void CompletionCacheTest::testLookupInLargeDocument()
+{
+    // The controller passes bounded windows, so a lookup costs the same however large the
+    // document is.
+    constexpr qsizetype kWindow = 8 * 1024;
+    QString before;
+    for (int line = 0; line < 5000; ++line)
+        before += QString("    int value%1 = compute(%1);\n").arg(line);
+    before += QStringLiteral("    ");
+    const int position = int(before.size());
+    const QString after = before.left(kWindow);
+
+    CompletionCache cache;
+    for (int n = 1; n <= 16; ++n) {
+        const QStringView prefix = QStringView(before).first(position - n).last(kWindow);
+        cache.insert(
+            kFile, CompletionCache::keyFor(position - n, prefix, after), QStringLiteral("next();"));
+    }
+    cache.insert(
+        kFile,
+        CompletionCache::keyFor(position, QStringView(before).last(kWindow), after),
+        QStringLiteral("return total;"));
+
+    const QString typed = (before + "retu").right(kWindow + 1024);
+    std::optional<QString> found;
+    QBENCHMARK {
+        found = cache.find(kFile, position + 4, typed, after);
+    }
+    QCOMPARE(found.value_or(QString()), QStringLiteral("rn total;"));
+}
+
+} // namespace QodeAssist
@@ -0,0 +1,25 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#pragma once
+
+#include <QObject>
+
+namespace QodeAssist {
+
+class CompletionCacheTest final : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testSameSpotHits();
+    void testTypingIntoSuggestion();
+    void testChangedTextMisses();
+    void testOnlySentWindowCounts();
+    void testLeastRecentlyUsedIsEvicted();
+    void testRemoveDocument();
+    void testLookupInLargeDocument();
+};
+
+} // namespace QodeAssist
@@ -0,0 +1,106 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#include "CompletionSchedulerTest.hpp"
+
+#include <QTest>
+
+#include "completion/CompletionScheduler.hpp"
+
+namespace QodeAssist {
+
+namespace {
+
+constexpr int kFallbackMs = 350;
+
+void type(CompletionScheduler &scheduler, int keystrokes, qint64 gapMs, qint64 &clock)
+{
+    for (int i = 0; i < keystrokes; ++i) {
+        clock += gapMs;
+        scheduler.recordKeystroke(clock);
+    }
+}
+
+} // namespace
+
+void CompletionSchedulerTest::testFallsBackUntilRhythmIsKnown()
+{
+    CompletionScheduler scheduler;
+    QCOMPARE(scheduler.typicalKeystrokeGap(), qint64(-1));
+    QCOMPARE(scheduler.debounceDelay(kFallbackMs, 800, 1500), kFallbackMs);
+
+    qint64 clock = 0;
+    type(scheduler, 4, 100, clock);
+    QCOMPARE(scheduler.debounceDelay(kFallbackMs, -1, -1), kFallbackMs);
+
+    type(scheduler, 8, 100, clock);
+    QCOMPARE(scheduler.typicalKeystrokeGap(), qint64(100));
+
+    scheduler.reset();
+    QCOMPARE(scheduler.debounceDelay(kFallbackMs, -1, -1), kFallbackMs);
+}
+
+void CompletionSchedulerTest::testFollowsTypingSpeed()
+{
+    qint64 clock = 0;
+    CompletionScheduler fast;
+    type(fast, 20, 80, clock);
+    CompletionScheduler slow;
+    type(slow, 20, 250, clock);
+
+    const int fastDelay = fast.debounceDelay(kFallbackMs, -1, -1);
+    const int slowDelay = slow.debounceDelay(kFallbackMs, -1, -1);
+    QVERIFY(fastDelay > 80);
+    QVERIFY(slowDelay > 250);
+    QVERIFY(fastDelay < slowDelay);
+
+    // The rhythm follows the most recent typing.
+    type(slow, 40, 80, clock);
+    QCOMPARE(slow.debounceDelay(kFallbackMs, -1, -1), fastDelay);
+}
+
+void CompletionSchedulerTest::testPausesAreNotTypingRhythm()
+{
+    CompletionScheduler scheduler;
+    qint64 clock = 0;
+    for (int burst = 0; burst < 5; ++burst) {
+        type(scheduler, 6, 100, clock);
+        clock += 5000;
+    }
+    QCOMPARE(scheduler.typicalKeystrokeGap(), qint64(100));
+
+    // A few hesitations inside the typing window do not move the median.
+    type(scheduler, 3, 900, clock);
+    QCOMPARE(scheduler.typicalKeystrokeGap(), qint64(100));
+}
+
+void CompletionSchedulerTest::testSlowProviderWaitsLonger()
+{
+    CompletionScheduler scheduler;
+    qint64 clock = 0;
+    type(scheduler, 20, 120, clock);
+
+    const int unknown = scheduler.debounceDelay(kFallbackMs, -1, -1);
+    const int fastServer = scheduler.debounceDelay(kFallbackMs, 200, 250);
+    const int slowServer = scheduler.debounceDelay(kFallbackMs, 1500, 1800);
+    const int erraticServer = scheduler.debounceDelay(kFallbackMs, 1500, 4000);
+
+    QVERIFY(unknown <= fastServer);
+    QVERIFY(fastServer < slowServer);
+    QVERIFY(slowServer < erraticServer);
+}
+
+void CompletionSchedulerTest::testDelayIsBounded()
+{
+    qint64 clock = 0;
+    CompletionScheduler burst;
+    type(burst, 20, 5, clock);
+    QCOMPARE(burst.debounceDelay(kFallbackMs, -1, -1), 50);
+
+    CompletionScheduler hesitant;
+    type(hesitant, 20, 950, clock);
+    QCOMPARE(hesitant.debounceDelay(kFallbackMs, 30000, 60000), 1500);
+}
+
+} // namespace QodeAssist
@@ -55,7 +55,13 @@ class FakePerformanceLogger : public IRequestPerformanceLogger
 public:
     void startTimeMeasurement(const QString &) override {}
     void endTimeMeasurement(const QString &) override {}
+    void failTimeMeasurement(const QString &) override {}
+    void cancelTimeMeasurement(const QString &) override {}
     void logPerformance(const QString &, qint64) override {}
+    void describeRequest(const QString &, const RequestLabels &) override {}
+    void recordPhase(const QString &, RequestPhase, qint64) override {}
+    void recordCacheLookup(const QString &, bool) override {}
+    qint64 latencyPercentile(int) const override { return -1; }
 };
 
 } // namespace QodeAssist
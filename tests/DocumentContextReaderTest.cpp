@@ -6,9 +6,12 @@
 #include "DocumentContextReaderTest.hpp"
 
 #include <QTest>
+#include <QTextCursor>
 #include <QTextDocument>
 
+#include "context/CopyrightHeaderIndex.hpp"
 #include "context/DocumentContextReader.hpp"
+#include "context/TokenizerRegistry.hpp"
 #include "llmcore/ContextData.hpp"
 #include "settings/CodeCompletionSettings.hpp"
 
@@ -20,6 +23,51 @@ constexpr char kTestMimeType[] = "text/python";
 constexpr char kTestFilePath[] = "/path/to/file";
 constexpr char kTestFileContext[]
     = "\n Language:  (MIME: text/python) filepath: /path/to/file()\n\n";
+constexpr int kBenchmarkLineCount = 100000;
+
+QString makeLargeDocumentText(int lineCount)
+{
+    QString text;
+    text.reserve(lineCount * 48);
+    for (int i = 0; i < lineCount; ++i) {
+        if (i > 0)
+            text.append('\n');
+        text.append(QString("    int value%1 = compute(%1, other); // line").arg(i));
+    }
+    return text;
+}
+
+// Multi-line path of the line-by-line concatenation getContextBetween() used before slicing by
+// document positions; kept as the benchmark baseline.
+QString lineByLineContextBetween(
+    const QTextDocument *document,
+    int startLine,
+    int startCursorPosition,
+    int endLine,
+    int endCursorPosition)
+{
+    QString context;
+    startLine = qMax(startLine, 0);
+    endLine = qMin(endLine, document->blockCount() - 1);
+    if (startLine >= endLine)
+        return context;
+
+    const QString firstLine = document->findBlockByNumber(startLine).text();
+    context += (startCursorPosition < 0 ? firstLine : firstLine.mid(startCursorPosition)) + "\n";
+    for (int i = startLine + 1; i <= endLine - 1; ++i)
+        context += document->findBlockByNumber(i).text() + "\n";
+    const QString lastLine = document->findBlockByNumber(endLine).text();
+    context += endCursorPosition < 0 ? lastLine : lastLine.left(endCursorPosition);
+    return context;
+}
+
+// One token per character, so it counts far more tokens than the heuristic.
+class CharacterTokenizer : public Context::ITokenizer
+{
+public:
+    QString name() const override { return QStringLiteral("characters"); }
+    int countTokens(const QString &text) const override { return int(text.size()); }
+};
 
 } // namespace
 
@@ -47,6 +95,29 @@ QSharedPointer<Settings::CodeCompletionSettings> DocumentContextReaderTest::crea
     return settings;
 }
 
+QSharedPointer<Settings::CodeCompletionSettings> DocumentContextReaderTest::
+    createSettingsForTokenBudget(int tokenBudget, int prefixSharePercent)
+{
+    auto settings = QSharedPointer<Settings::CodeCompletionSettings>::create();
+    settings->readFullFile.setValue(false, Utils::BaseAspect::BeQuiet);
+    settings->useContextTokenBudget.setValue(true, Utils::BaseAspect::BeQuiet);
+    settings->contextTokenBudget.setValue(tokenBudget, Utils::BaseAspect::BeQuiet);
+    settings->contextPrefixShare.setValue(prefixSharePercent, Utils::BaseAspect::BeQuiet);
+    return settings;
+}
+
+void DocumentContextReaderTest::initTestCase()
+{
+    // Budget expectations below are written against the 4-characters-per-token heuristic.
+    m_tokenizerDirectory = Context::TokenizerRegistry::instance().vocabularyDirectory();
+    Context::TokenizerRegistry::instance().setVocabularyDirectory({});
+}
+
+void DocumentContextReaderTest::cleanupTestCase()
+{
+    Context::TokenizerRegistry::instance().setVocabularyDirectory(m_tokenizerDirectory);
+}
+
 void DocumentContextReaderTest::testGetLineText()
 {
     auto reader = createReader("Line 0\nLine 1\nLine 2");
@@ -320,6 +391,58 @@ void DocumentContextReaderTest::testFindCopyrightNoCopyright()
     QCOMPARE(info.endLine, -1);
 }
 
+void DocumentContextReaderTest::testFindCopyrightIgnoresCommentsAfterCode()
+{
+    auto reader = createReader("#include <QString>\n\nint x = 0;\n/* Copyright (C) 2024 */\nCode");
+
+    const auto info = reader.findCopyright();
+    QVERIFY(!info.found);
+}
+
+void DocumentContextReaderTest::testCopyrightIndexSharedPerDocument()
+{
+    QTextDocument document;
+    document.setPlainText("/* Copyright (C) 2024 */\nLine 0\nLine 1");
+
+    auto *index = Context::CopyrightHeaderIndex::forDocument(&document);
+    QVERIFY(index);
+    QCOMPARE(Context::CopyrightHeaderIndex::forDocument(&document), index);
+
+    Context::DocumentContextReader first(&document, kTestMimeType, kTestFilePath);
+    Context::DocumentContextReader second(&document, kTestMimeType, kTestFilePath);
+    QVERIFY(first.copyrightInfo().found);
+    QVERIFY(second.copyrightInfo().found);
+    QCOMPARE(index->scanCount(), 1);
+}
+
+void DocumentContextReaderTest::testCopyrightIndexRescansOnHeaderEdit()
+{
+    QTextDocument document;
+    document.setPlainText("/* Copyright (C) 2024 */\nLine 0\nLine 1\nLine 2");
+
+    auto *index = Context::CopyrightHeaderIndex::forDocument(&document);
+    QCOMPARE(index->copyrightInfo().endLine, 0);
+    QCOMPARE(index->scanCount(), 1);
+
+    QTextCursor cursor(document.findBlockByNumber(3));
+    cursor.insertText("code ");
+    QCOMPARE(index->copyrightInfo().endLine, 0);
+    QCOMPARE(index->scanCount(), 1);
+
+    cursor.setPosition(0);
+    cursor.insertText("// Licensed under the MIT license, 2024\n");
+    const auto info = index->copyrightInfo();
+    QVERIFY(info.found);
+    QCOMPARE(info.startLine, 0);
+    QCOMPARE(info.endLine, 1);
+    QCOMPARE(index->scanCount(), 2);
+
+    cursor.setPosition(0);
+    cursor.movePosition(QTextCursor::End, QTextCursor::KeepAnchor);
+    cursor.insertText("Line 0\nLine 1");
+    QVERIFY(!index->copyrightInfo().found);
+}
+
 void DocumentContextReaderTest::testGetContextBetween()
 {
     auto reader = createReader("Line 0\nLine 1\nLine 2\nLine 3\nLine 4");
@@ -361,4 +484,130 @@ void DocumentContextReaderTest::testPrepareContext()
             .fileContext = kTestFileContext}));
 }
 
+void DocumentContextReaderTest::testPrepareContextWithinBudget()
+{
+    // Every "Line N" is estimated at one token, partial lines at the cursor at zero.
+    auto reader = createReader(
+        "Line 0\nLine 1\nLine 2\nLine 3\nLine 4\nLine 5\nLine 6\nLine 7\nLine 8\nLine 9");
+
+    QCOMPARE(
+        reader.prepareContext(5, 3, *createSettingsForTokenBudget(4, 50)),
+        (LLMCore::ContextData{
+            .prefix = "Line 3\nLine 4\nLin",
+            .suffix = "e 5\nLine 6\nLine 7",
+            .fileContext = kTestFileContext}));
+
+    // Budget the prefix cannot use at the top of the file goes to the suffix.
+    QCOMPARE(
+        reader.prepareContextWithinBudget(1, 3, 4, 0.5),
+        (LLMCore::ContextData{
+            .prefix = "Line 0\nLin",
+            .suffix = "e 1\nLine 2\nLine 3\nLine 4",
+            .fileContext = kTestFileContext}));
+
+    // ...and budget the suffix cannot use at the end of the file goes to the prefix.
+    QCOMPARE(
+        reader.prepareContextWithinBudget(8, 3, 4, 0.5),
+        (LLMCore::ContextData{
+            .prefix = "Line 5\nLine 6\nLine 7\nLin",
+            .suffix = "e 8\nLine 9",
+            .fileContext = kTestFileContext}));
+
+    QCOMPARE(
+        reader.prepareContextWithinBudget(5, 3, 3, 1.0),
+        (LLMCore::ContextData{
+            .prefix = "Line 2\nLine 3\nLine 4\nLin",
+            .suffix = "e 5",
+            .fileContext = kTestFileContext}));
+}
+
+void DocumentContextReaderTest::testPrepareContextWithinBudgetUsesModelTokenizer()
+{
+    auto reader = createReader(
+        "Line 0\nLine 1\nLine 2\nLine 3\nLine 4\nLine 5\nLine 6\nLine 7\nLine 8\nLine 9");
+    const QString model = QStringLiteral("qwen2.5-coder:7b");
+
+    // No vocabulary for the family yet, so lines cost one token each.
+    QCOMPARE(
+        reader.prepareContextWithinBudget(5, 3, 20, 0.5, model),
+        (LLMCore::ContextData{
+            .prefix = "Line 0\nLine 1\nLine 2\nLine 3\nLine 4\nLin",
+            .suffix = "e 5\nLine 6\nLine 7\nLine 8\nLine 9",
+            .fileContext = kTestFileContext}));
+
+    auto &registry = Context::TokenizerRegistry::instance();
+    registry.registerTokenizer(
+        Context::TokenizerRegistry::familyForModel(model), std::make_shared<CharacterTokenizer>());
+    const LLMCore::ContextData counted = reader.prepareContextWithinBudget(5, 3, 20, 0.5, model);
+    const LLMCore::ContextData defaultFamily = reader.prepareContextWithinBudget(5, 3, 20, 0.5);
+    registry.registerTokenizer(Context::TokenizerRegistry::familyForModel(model), nullptr);
+
+    QCOMPARE(
+        counted,
+        (LLMCore::ContextData{
+            .prefix = "Line 4\nLin", .suffix = "e 5\nLine 6", .fileContext = kTestFileContext}));
+    // Other models keep their own family's count.
+    QCOMPARE(defaultFamily.prefix, QString("Line 0\nLine 1\nLine 2\nLine 3\nLine 4\nLin"));
+}
+
+void DocumentContextReaderTest::testPrepareContextWithinBudgetSkipsCopyright()
+{
+    auto reader = createReader("/* Copyright (C) 2024 */\nLine 0\nLine 1\nLine 2\nLine 3");
+
+    QCOMPARE(
+        reader.prepareContextWithinBudget(2, 3, 10, 0.5),
+        (LLMCore::ContextData{
+            .prefix = "Line 0\nLin",
+            .suffix = "e 1\nLine 2\nLine 3",
+            .fileContext = kTestFileContext}));
+
+    QCOMPARE(
+        reader.prepareContextWithinBudget(0, 3, 2, 0.5),
+        (LLMCore::ContextData{
+            .prefix = "", .suffix = "Line 0\nLine 1", .fileContext = kTestFileContext}));
+}
+
+void DocumentContextReaderTest::benchmarkContextBetween_data()
+{
+    QTest::addColumn<bool>("lineByLine");
+
+    QTest::newRow("line-by-line") << true;
+    QTest::newRow("position-slice") << false;
+}
+
+void DocumentContextReaderTest::benchmarkContextBetween()
+{
+    QFETCH(bool, lineByLine);
+
+    QTextDocument document;
+    document.setPlainText(makeLargeDocumentText(kBenchmarkLineCount));
+    Context::DocumentContextReader reader(&document, kTestMimeType, kTestFilePath);
+
+    const int cursorLine = kBenchmarkLineCount / 2;
+    const int lastLine = kBenchmarkLineCount - 1;
+
+    QCOMPARE(
+        reader.getContextBetween(0, -1, cursorLine, 4),
+        lineByLineContextBetween(&document, 0, -1, cursorLine, 4));
+    QCOMPARE(
+        reader.getContextBetween(cursorLine, 4, lastLine, -1),
+        lineByLineContextBetween(&document, cursorLine, 4, lastLine, -1));
+
+    QString prefix;
+    QString suffix;
+    if (lineByLine) {
+        QBENCHMARK {
+            prefix = lineByLineContextBetween(&document, 0, -1, cursorLine, 4);
+            suffix = lineByLineContextBetween(&document, cursorLine, 4, lastLine, -1);
+        }
+    } else {
+        QBENCHMARK {
+            prefix = reader.getContextBetween(0, -1, cursorLine, 4);
+            suffix = reader.getContextBetween(cursorLine, 4, lastLine, -1);
+        }
+    }
+
+    QCOMPARE(prefix.size() + suffix.size(), document.characterCount() - 1);
+}
+
 } // namespace QodeAssist
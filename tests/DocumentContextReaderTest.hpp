@@ -19,6 +19,8 @@ class DocumentContextReaderTest final : public QObject
     Q_OBJECT
 
 private slots:
+    void initTestCase();
+    void cleanupTestCase();
     void testGetLineText();
     void testGetContext();
     void testGetContextWithCopyright();
@@ -29,14 +31,26 @@ private slots:
     void testFindCopyrightMultiLine();
     void testFindCopyrightMultipleBlocks();
     void testFindCopyrightNoCopyright();
+    void testFindCopyrightIgnoresCommentsAfterCode();
+    void testCopyrightIndexSharedPerDocument();
+    void testCopyrightIndexRescansOnHeaderEdit();
     void testGetContextBetween();
     void testPrepareContext();
+    void testPrepareContextWithinBudget();
+    void testPrepareContextWithinBudgetUsesModelTokenizer();
+    void testPrepareContextWithinBudgetSkipsCopyright();
+    void benchmarkContextBetween_data();
+    void benchmarkContextBetween();
 
 private:
     Context::DocumentContextReader createReader(const QString &text);
     QSharedPointer<Settings::CodeCompletionSettings> createSettingsForWholeFile();
     QSharedPointer<Settings::CodeCompletionSettings> createSettingsForLines(
         int linesBefore, int linesAfter);
+    QSharedPointer<Settings::CodeCompletionSettings> createSettingsForTokenBudget(
+        int tokenBudget, int prefixSharePercent);
+
+    QString m_tokenizerDirectory;
 };
 
 } // namespace QodeAssist
@@ -30,17 +30,20 @@ public:
         const QString &prefix,
         int,
         int,
-        int maxTokens) override
+        int maxTokens,
+        const QString &modelName) override
     {
         ++calls;
         lastPrefix = prefix;
         lastBudget = maxTokens;
+        lastModel = modelName;
         return enrichment;
     }
 
     int calls = 0;
     QString lastPrefix;
     int lastBudget = 0;
+    QString lastModel;
     QString enrichment = QStringLiteral("\n<semantic-context-marker>");
 };
 
@@ -69,6 +72,7 @@ struct FimEngineFixture
         settings->readFullFile.setValue(true, Utils::BaseAspect::BeQuiet);
         settings->modelOutputHandler.setValue(0, Utils::BaseAspect::BeQuiet);
         settings->completionMode.setValue(0, Utils::BaseAspect::BeQuiet);
+        settings->streamCompletion.setValue(true, Utils::BaseAspect::BeQuiet);
     }
 
     FakeLlmProvider provider;
@@ -188,6 +192,7 @@ void FimCompletionEngineTest::testFimEngineEnrichmentFollowsCompletionMode()
     fixture.engine.request(11, {QStringLiteral("/path/to/file.cpp"), 1, 4});
     QCOMPARE(fixture.enricher.calls, 1);
     QVERIFY(fixture.enricher.lastBudget > 0);
+    QCOMPARE(fixture.enricher.lastModel, Settings::generalSettings().ccModel());
     QVERIFY(fixture.enricher.lastPrefix.contains(QStringLiteral("int main()")));
     QVERIFY(fixture.provider.lastContext.systemPrompt->contains(
         QStringLiteral("<semantic-context-marker>")));
@@ -262,4 +267,59 @@ void FimCompletionEngineTest::testFimEngineFailsWithoutProvider()
     QVERIFY(failed.first().at(1).toString().contains(QStringLiteral("No provider found")));
 }
 
+void FimCompletionEngineTest::testFimEngineStreamsPartialCompletion()
+{
+    FimEngineFixture fixture;
+
+    QSignalSpy progress(&fixture.engine, &CompletionEngine::completionProgress);
+    QSignalSpy ready(&fixture.engine, &CompletionEngine::completionReady);
+
+    fixture.engine.request(20, {QStringLiteral("/path/to/file.cpp"), 1, 4});
+    auto *client = fixture.provider.fakeClient();
+    const auto llmId = client->lastRequestId;
+
+    emit client->chunkReceived(llmId, QStringLiteral("int x"));
+    emit client->chunkReceived(llmId, QStringLiteral(" = 1;\n"));
+    emit client->chunkReceived(QStringLiteral("other-req"), QStringLiteral("ignored"));
+
+    QCOMPARE(progress.count(), 2);
+    QCOMPARE(progress.at(0).at(0).toULongLong(), quint64(20));
+    QCOMPARE(progress.at(0).at(1).toString(), QStringLiteral("int x"));
+    QCOMPARE(progress.at(1).at(1).toString(), QStringLiteral("int x = 1;\n"));
+    QCOMPARE(ready.count(), 0);
+
+    client->completeRequest(llmId, QStringLiteral("int x = 1;\nint y = 2;"));
+    QCOMPARE(ready.count(), 1);
+    QCOMPARE(ready.first().at(1).toString(), QStringLiteral("int x = 1;\nint y = 2;"));
+
+    fixture.settings->streamCompletion.setValue(false, Utils::BaseAspect::BeQuiet);
+    fixture.engine.request(21, {QStringLiteral("/path/to/file.cpp"), 1, 4});
+    emit client->chunkReceived(client->lastRequestId, QStringLiteral("int z"));
+    QCOMPARE(progress.count(), 2);
+}
+
+void FimCompletionEngineTest::testFimEngineHoldsBackCodeBlocks()
+{
+    FimEngineFixture fixture;
+
+    QSignalSpy progress(&fixture.engine, &CompletionEngine::completionProgress);
+    QSignalSpy ready(&fixture.engine, &CompletionEngine::completionReady);
+
+    fixture.engine.request(22, {QStringLiteral("/path/to/file.cpp"), 1, 4});
+    auto *client = fixture.provider.fakeClient();
+    const auto llmId = client->lastRequestId;
+
+    emit client->chunkReceived(llmId, QStringLiteral("```cpp\n"));
+    emit client->chunkReceived(llmId, QStringLiteral("int x = 1;\nint y = 2;\n"));
+    QCOMPARE(progress.count(), 0);
+    QCOMPARE(ready.count(), 0);
+
+    client->completeRequest(llmId, QStringLiteral("```cpp\nint x = 1;\nint y = 2;\n```\n"));
+    QCOMPARE(ready.count(), 1);
+    const QString text = ready.first().at(1).toString();
+    QVERIFY(text.contains(QStringLiteral("int x = 1;")));
+    QVERIFY(text.contains(QStringLiteral("int y = 2;")));
+    QVERIFY(!text.contains(QStringLiteral("```")));
+}
+
 } // namespace QodeAssist
@@ -22,6 +22,8 @@ private slots:
     void testIdentifiersNearCursorOrdersAndFilters();
     void testClampSectionsToTokenBudget();
     void testFimEngineFailsWithoutProvider();
+    void testFimEngineStreamsPartialCompletion();
+    void testFimEngineHoldsBackCodeBlocks();
 };
 
 } // namespace QodeAssist
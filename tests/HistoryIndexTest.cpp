@@ -0,0 +1,137 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#include "HistoryIndexTest.hpp"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "ChatView/ChatFileStore.hpp"
+#include "SessionTestSupport.hpp"
+#include "session/HistoryIndex.hpp"
+#include "session/HistorySerializer.hpp"
+#include "session/Session.hpp"
+#include "tools/HistoryIndexCache.hpp"
+
+namespace QodeAssist {
+
+void HistoryIndexTest::testIndexFollowsSavedChats()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString savedPath = dir.filePath("saved.json");
+    const QString plainPath = dir.filePath("plain.json");
+
+    Session::Session session;
+    Chat::ChatFileStore store(&session);
+    session.setHistory(sampleHistory());
+    QVERIFY(store.save(savedPath).success);
+    // Saves update the shared index in memory; it reaches the disk later, or on flush.
+    Tools::HistoryIndexCache::instance().flush();
+    QVERIFY(QFileInfo::exists(Session::HistoryIndex::indexFilePath(dir.path())));
+
+    // Written behind the index's back, so it is summarized from the file.
+    QVERIFY(Chat::ChatFileStore::saveToFile(historyWithoutFileEdits(), {}, plainPath).success);
+
+    {
+        Session::HistoryIndex index(dir.path());
+        const std::optional<Session::HistoryIndex::Entry> saved = index.entry(savedPath);
+        QVERIFY(saved.has_value());
+        QCOMPARE(saved->title, QString("explain this"));
+        QCOMPARE(saved->messageCount, 2);
+        QCOMPARE(saved->totalTokens, qint64(160));
+        QVERIFY(saved->compressedFrom.isEmpty());
+
+        QCOMPARE(index.entry(plainPath)->messageCount, 2);
+        QVERIFY(index.save());
+    }
+
+    // Entries written out are found again as long as the files stay as they were.
+    QFile::remove(savedPath);
+    Session::HistoryIndex index(dir.path());
+    QVERIFY(!index.entry(savedPath).has_value());
+    const std::optional<Session::HistoryIndex::Entry> plain = index.entry(plainPath);
+    QVERIFY(plain.has_value());
+    QCOMPARE(plain->filePath, plainPath);
+    QCOMPARE(plain->messageCount, 2);
+}
+
+void HistoryIndexTest::testSavesShareOneIndexPerDirectory()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString firstPath = dir.filePath("first.json");
+    const QString secondPath = dir.filePath("second.json");
+
+    Session::Session session;
+    Chat::ChatFileStore store(&session);
+    session.setHistory(sampleHistory());
+    QVERIFY(store.save(firstPath).success);
+    Session::ConversationHistory longer = sampleHistory();
+    longer.append(userTurn());
+    session.setHistory(longer);
+    QVERIFY(store.save(secondPath).success);
+    QVERIFY(store.save(secondPath).success);
+
+    auto &cache = Tools::HistoryIndexCache::instance();
+    const std::optional<Session::HistoryIndex::Entry> second = cache.entry(secondPath);
+    QVERIFY(second.has_value());
+    QCOMPARE(second->messageCount, 3);
+
+    // Every save went into the same index, which is written out whole.
+    cache.flush();
+    QFile file(Session::HistoryIndex::indexFilePath(dir.path()));
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QJsonObject chats = QJsonDocument::fromJson(file.readAll()).object()["chats"].toObject();
+    QCOMPARE(chats.size(), 2);
+    QCOMPARE(chats["first.json"].toObject()["messages"].toInt(), 2);
+    QCOMPARE(chats["second.json"].toObject()["messages"].toInt(), 3);
+}
+
+void HistoryIndexTest::testCompressedChatKeepsItsLinkWhenSavedAgain()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString originalPath = dir.filePath("original.json");
+    const QString compressedPath = dir.filePath("compressed.json");
+
+    QVERIFY(Chat::ChatFileStore::saveToFile(sampleHistory(), {}, originalPath).success);
+
+    Session::ConversationHistory summary;
+    summary.append(assistantTurn());
+    QJsonObject root = Session::HistorySerializer::toJson(summary);
+    root["compressedFrom"] = originalPath;
+    {
+        QFile file(compressedPath);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(QJsonDocument(root).toJson());
+    }
+
+    Session::Session session;
+    Chat::ChatFileStore store(&session);
+    QVERIFY(store.load(compressedPath).success);
+
+    Session::ConversationHistory continued = session.history();
+    continued.append(userTurn());
+    session.setHistory(continued);
+    QVERIFY(store.save(compressedPath).success);
+
+    QFile file(compressedPath);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(
+        Session::HistorySerializer::readRoot(file.readAll())["compressedFrom"].toString(),
+        originalPath);
+
+    Session::HistoryIndex index(dir.path());
+    const std::optional<Session::HistoryIndex::Entry> entry = index.entry(compressedPath);
+    QVERIFY(entry.has_value());
+    QCOMPARE(entry->compressedFrom, originalPath);
+    QCOMPARE(entry->messageCount, 2);
+}
+
+} // namespace QodeAssist
@@ -0,0 +1,231 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#include "HistorySearchIndexTest.hpp"
+
+#include <QDataStream>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "ChatView/ChatFileStore.hpp"
+#include "SessionTestSupport.hpp"
+#include "session/HistorySearchIndex.hpp"
+#include "tools/ChatHistorySearch.hpp"
+
+namespace QodeAssist {
+
+namespace {
+
+using Session::HistorySearchIndex;
+
+HistorySearchIndex::TermCounts countsOf(const QString &text)
+{
+    HistorySearchIndex::TermCounts counts;
+    for (const QString &term : HistorySearchIndex::termsOf(text))
+        ++counts[term];
+    return counts;
+}
+
+QStringList hitPaths(const QList<HistorySearchIndex::Hit> &hits)
+{
+    QStringList paths;
+    for (const HistorySearchIndex::Hit &hit : hits)
+        paths.append(hit.filePath);
+    return paths;
+}
+
+Session::ConversationHistory historyAbout(const QString &text)
+{
+    Session::Message message;
+    message.role = Session::MessageRole::User;
+    message.id = "u1";
+    message.blocks = {Session::TextBlock{text}};
+
+    Session::ConversationHistory history;
+    history.append(message);
+    return history;
+}
+
+} // namespace
+
+void HistorySearchIndexTest::testIndexesTextToolCallsAndFileNames()
+{
+    QCOMPARE(
+        HistorySearchIndex::termsOf("Fix the CRASH in main.cpp, x = 42"),
+        QStringList({"fix", "the", "crash", "in", "main", "cpp", "42"}));
+
+    const HistorySearchIndex::TermCounts counts = HistorySearchIndex::termCountsOf(
+        sampleHistory());
+    QCOMPARE(counts.value("explain"), 1);
+    QCOMPARE(counts.value("answer"), 1);
+    QCOMPARE(counts.value("read_file"), 0);
+    QCOMPARE(counts.value("read"), 1);
+    QCOMPARE(counts.value("main"), 1);
+    QCOMPARE(counts.value("notes"), 1);
+    QCOMPARE(counts.value("shot"), 1);
+    // Neither thinking nor tool results are searched.
+    QCOMPARE(counts.value("weighing"), 0);
+    QCOMPARE(counts.value("int"), 0);
+}
+
+void HistorySearchIndexTest::testRanksChatsMatchingMoreWordsFirst()
+{
+    HistorySearchIndex index;
+    index.setChat("/h/both.json", 1, countsOf("the parser crashes on empty input"));
+    index.setChat("/h/parser.json", 1, countsOf("parser parser parser parser rewrite"));
+    index.setChat("/h/other.json", 1, countsOf("unrelated discussion about themes"));
+
+    const QList<HistorySearchIndex::Hit> hits = index.search("parser empty", 10);
+    QCOMPARE(hitPaths(hits), QStringList({"/h/both.json", "/h/parser.json"}));
+    QCOMPARE(hits.first().matchedTerms, 2);
+    QCOMPARE(hits.last().matchedTerms, 1);
+
+    QCOMPARE(hitPaths(index.search("parser", 1)), QStringList({"/h/parser.json"}));
+    QVERIFY(index.search("missing", 10).isEmpty());
+    QVERIFY(index.search("  ,. ", 10).isEmpty());
+}
+
+void HistorySearchIndexTest::testPrefixesMatchLongerWords()
+{
+    HistorySearchIndex index;
+    index.setChat("/h/a.json", 1, countsOf("the build crashed twice"));
+    index.setChat("/h/b.json", 1, countsOf("a crash report"));
+
+    QCOMPARE(index.search("crash", 10).size(), 2);
+    QCOMPARE(hitPaths(index.search("crashed", 10)), QStringList({"/h/a.json"}));
+    // Too short to stand for longer words.
+    QVERIFY(index.search("cr", 10).isEmpty());
+}
+
+void HistorySearchIndexTest::testReindexedChatReplacesItsWords()
+{
+    HistorySearchIndex index;
+    index.setChat("/h/a.json", 1, countsOf("first draft"));
+    index.setChat("/h/a.json", 2, countsOf("second draft"));
+
+    QCOMPARE(index.chatCount(), 1);
+    QCOMPARE(index.stamp("/h/a.json"), qint64(2));
+    QVERIFY(index.search("first", 10).isEmpty());
+    QCOMPARE(hitPaths(index.search("second", 10)), QStringList({"/h/a.json"}));
+
+    index.compact();
+    QCOMPARE(hitPaths(index.search("draft", 10)), QStringList({"/h/a.json"}));
+
+    index.removeChat("/h/a.json");
+    QVERIFY(!index.contains("/h/a.json"));
+    QVERIFY(index.search("draft", 10).isEmpty());
+}
+
+void HistorySearchIndexTest::testSerializedIndexReadsBack()
+{
+    HistorySearchIndex index;
+    index.setChat("/old/a.json", 7, countsOf("signal slot connection"));
+    index.setChat("/old/b.json", 8, countsOf("dropped chat"));
+    index.setChat("/old/c.json", 9, countsOf("queued connection"));
+    index.removeChat("/old/b.json");
+
+    HistorySearchIndex restored;
+    QVERIFY(restored.deserialize(index.serialize(), "/new"));
+    QCOMPARE(restored.chatCount(), 2);
+    QCOMPARE(restored.stamp("/new/a.json"), qint64(7));
+    QVERIFY(!restored.contains("/new/b.json"));
+    QCOMPARE(
+        hitPaths(restored.search("connection signal", 10)),
+        QStringList({"/new/a.json", "/new/c.json"}));
+
+    QVERIFY(!restored.deserialize("not an index", "/new"));
+    QCOMPARE(restored.chatCount(), 0);
+}
+
+void HistorySearchIndexTest::testHitsCarryPassagesOfMatchedWords()
+{
+    const QString text = QString("word ").repeated(30) + "deadlock" + QString(" tail").repeated(30);
+    HistorySearchIndex index;
+    index.setChat("/h/a.json", 1, HistorySearchIndex::chatTermsOf(historyAbout(text)));
+
+    // Cut 80 characters around the first occurrence; "tail" falls inside the same passage.
+    const QString deadlock = QChar(0x2026) + text.mid(70, 168).simplified() + QChar(0x2026);
+    QList<HistorySearchIndex::Hit> hits = index.search("deadl", 10);
+    QCOMPARE(hits.size(), 1);
+    QCOMPARE(hits.first().excerpts, QStringList({deadlock}));
+    QCOMPARE(index.search("tail deadlock", 10).first().excerpts, QStringList({deadlock}));
+    QCOMPARE(index.search("deadlock word", 10).first().excerpts.size(), 2);
+
+    HistorySearchIndex restored;
+    QVERIFY(restored.deserialize(index.serialize(), "/h"));
+    QCOMPARE(restored.search("deadlock", 10).first().excerpts, QStringList({deadlock}));
+}
+
+void HistorySearchIndexTest::testDamagedCountsAreRejected()
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    // A current header claiming far more chats than follow.
+    stream << quint32(0x51414853) << quint32(2) << quint32(0xffffffff);
+
+    HistorySearchIndex index;
+    QVERIFY(!index.deserialize(data, "/h"));
+    QCOMPARE(index.chatCount(), 0);
+}
+
+void HistorySearchIndexTest::testSearchCatchesUpWithSavedChats()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString timerPath = dir.filePath("timer.json");
+    const QString layoutPath = dir.filePath("layout.json");
+
+    // Written without going through a store, so only the search itself can pick them up.
+    QVERIFY(Chat::ChatFileStore::saveToFile(
+                historyAbout("why does the timer fire twice"), {}, timerPath)
+                .success);
+    QVERIFY(Chat::ChatFileStore::saveToFile(
+                historyAbout("center the layout in the dock"), {}, layoutPath)
+                .success);
+
+    auto &search = Tools::ChatHistorySearch::instance();
+    QList<Tools::ChatHistorySearch::Result> results = search.search(dir.path(), "timer", 10, 1);
+    QCOMPARE(results.size(), 1);
+    QCOMPARE(QFileInfo(results.first().filePath), QFileInfo(timerPath));
+    QCOMPARE(results.first().title, QString("why does the timer fire twice"));
+    QCOMPARE(results.first().snippets, QStringList({"why does the timer fire twice"}));
+    QVERIFY(QFileInfo::exists(Tools::ChatHistorySearch::indexFilePath(dir.path())));
+
+    QFile::remove(timerPath);
+    QVERIFY(search.search(dir.path(), "timer", 10).isEmpty());
+    QCOMPARE(search.search(dir.path(), "layout", 10).size(), 1);
+}
+
+void HistorySearchIndexTest::testSearchNoticesChatsEditedInPlace()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString chatPath = dir.filePath("chat.json");
+    const QString otherPath = dir.filePath("other.json");
+    QVERIFY(Chat::ChatFileStore::saveToFile(
+                historyAbout("the deadlock in the worker pool"), {}, chatPath)
+                .success);
+    QVERIFY(Chat::ChatFileStore::saveToFile(historyAbout("center the layout"), {}, otherPath)
+                .success);
+
+    auto &search = Tools::ChatHistorySearch::instance();
+    const QList<Tools::ChatHistorySearch::Result> results
+        = search.search(dir.path(), "deadlock pool", 10, 2);
+    QCOMPARE(results.size(), 1);
+    QCOMPARE(results.first().snippets, QStringList({"the deadlock in the worker pool"}));
+
+    // Rewritten without a rename, so the directory itself does not change.
+    QFile source(otherPath);
+    QVERIFY(source.open(QIODevice::ReadOnly));
+    QFile chat(chatPath);
+    QVERIFY(chat.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    QVERIFY(chat.write(source.readAll()) > 0);
+    chat.close();
+
+    QVERIFY(search.search(dir.path(), "deadlock", 10).isEmpty());
+}
+
+} // namespace QodeAssist
@@ -0,0 +1,27 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#pragma once
+
+#include <QObject>
+
+namespace QodeAssist {
+
+class HistorySearchIndexTest final : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testIndexesTextToolCallsAndFileNames();
+    void testRanksChatsMatchingMoreWordsFirst();
+    void testPrefixesMatchLongerWords();
+    void testReindexedChatReplacesItsWords();
+    void testSerializedIndexReadsBack();
+    void testHitsCarryPassagesOfMatchedWords();
+    void testDamagedCountsAreRejected();
+    void testSearchCatchesUpWithSavedChats();
+    void testSearchNoticesChatsEditedInPlace();
+};
+
+} // namespace QodeAssist
@@ -0,0 +1,125 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#include "IgnoreManagerTest.hpp"
+
+#include <projectexplorer/project.h>
+
+#include <QFile>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QtConcurrent>
+
+#include "context/IgnoreManager.hpp"
+
+namespace QodeAssist {
+
+namespace {
+
+class TestProject : public ProjectExplorer::Project
+{
+public:
+    explicit TestProject(const QString &projectFile)
+        : ProjectExplorer::Project("text/plain", Utils::FilePath::fromString(projectFile))
+    {}
+};
+
+bool writeIgnoreFile(const QTemporaryDir &dir, const QByteArray &content)
+{
+    QFile file(dir.filePath(".qodeassistignore"));
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    return file.write(content) == content.size();
+}
+
+} // namespace
+
+void IgnoreManagerTest::testAnswersFromSeveralThreadsWhileReloading()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QVERIFY(writeIgnoreFile(dir, "build/\n*.log\n!keep.log\n"));
+
+    TestProject project(dir.filePath("test.pro"));
+    Context::IgnoreManager manager;
+
+    const QList<QPair<QString, bool>> expected
+        = {{dir.filePath("src/main.cpp"), false},
+           {dir.filePath("build/obj/main.o"), true},
+           {dir.filePath("logs/run.log"), true},
+           {dir.filePath("logs/keep.log"), false}};
+
+    const auto query = [&manager, &project, &expected] {
+        int mismatches = 0;
+        for (int i = 0; i < 2000; ++i) {
+            for (const auto &[path, ignored] : expected) {
+                if (manager.shouldIgnore(path, &project) != ignored)
+                    ++mismatches;
+            }
+        }
+        return mismatches;
+    };
+
+    QList<QFuture<int>> workers;
+    for (int i = 0; i < 4; ++i)
+        workers.append(QtConcurrent::run(query));
+
+    // Same rules each time, so every answer must stay the same while snapshots are swapped.
+    for (int i = 0; i < 50; ++i)
+        manager.reloadIgnorePatterns(&project);
+    manager.reloadAllPatterns();
+
+    for (QFuture<int> &worker : workers)
+        QCOMPARE(worker.result(), 0);
+
+    QVERIFY(writeIgnoreFile(dir, "src/\n"));
+    manager.reloadIgnorePatterns(&project);
+    QVERIFY(manager.shouldIgnore(dir.filePath("src/main.cpp"), &project));
+    QVERIFY(!manager.shouldIgnore(dir.filePath("logs/run.log"), &project));
+}
+
+void IgnoreManagerTest::testKeepsResultsOfEachProject()
+{
+    QTemporaryDir firstDir;
+    QTemporaryDir secondDir;
+    QVERIFY(firstDir.isValid() && secondDir.isValid());
+    QVERIFY(writeIgnoreFile(firstDir, "*.log\n"));
+    QVERIFY(writeIgnoreFile(secondDir, "*.tmp\n"));
+
+    TestProject first(firstDir.filePath("first.pro"));
+    TestProject second(secondDir.filePath("second.pro"));
+    Context::IgnoreManager manager;
+
+    // Alternating between projects, as search_project does, must not mix up their rules.
+    for (int i = 0; i < 3; ++i) {
+        QVERIFY(manager.shouldIgnore(firstDir.filePath("a.log"), &first));
+        QVERIFY(!manager.shouldIgnore(firstDir.filePath("a.tmp"), &first));
+        QVERIFY(manager.shouldIgnore(secondDir.filePath("a.tmp"), &second));
+        QVERIFY(!manager.shouldIgnore(secondDir.filePath("a.log"), &second));
+    }
+}
+
+void IgnoreManagerTest::testReportsRuleChanges()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QVERIFY(writeIgnoreFile(dir, "build/\n"));
+
+    TestProject project(dir.filePath("test.pro"));
+    Context::IgnoreManager manager;
+    QSignalSpy changed(&manager, &Context::IgnoreManager::rulesChanged);
+
+    // Compiling the rules on first use is not a change.
+    QVERIFY(manager.shouldIgnore(dir.filePath("build/main.o"), &project));
+    QCOMPARE(changed.count(), 0);
+
+    manager.reloadIgnorePatterns(&project);
+    QCOMPARE(changed.count(), 1);
+
+    manager.removeIgnorePatterns(&project);
+    QCOMPARE(changed.count(), 2);
+}
+
+} // namespace QodeAssist
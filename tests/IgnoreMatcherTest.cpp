@@ -0,0 +1,80 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#include "IgnoreMatcherTest.hpp"
+
+#include <QTest>
+
+#include "context/IgnoreMatcher.hpp"
+
+namespace QodeAssist {
+
+void IgnoreMatcherTest::testMatches_data()
+{
+    QTest::addColumn<QStringList>("patterns");
+    QTest::addColumn<QString>("path");
+    QTest::addColumn<bool>("matches");
+
+    QTest::newRow("no patterns") << QStringList{} << QString("main.cpp") << false;
+    QTest::newRow("name anywhere") << QStringList{"build"} << QString("a/build/x.o") << true;
+    QTest::newRow("name is not a substring")
+        << QStringList{"build"} << QString("a/rebuild/x.o") << false;
+    QTest::newRow("rooted") << QStringList{"/build"} << QString("a/build/x.o") << false;
+    QTest::newRow("rooted at root") << QStringList{"/build"} << QString("build/x.o") << true;
+    QTest::newRow("star stays in segment") << QStringList{"*.o"} << QString("a/b/x.o") << true;
+    QTest::newRow("star does not cross /")
+        << QStringList{"/src*.cpp"} << QString("src/main.cpp") << false;
+    QTest::newRow("double star") << QStringList{"/docs/**/*.png"} << QString("docs/a/b/c.png")
+                                 << true;
+    QTest::newRow("question mark") << QStringList{"file?.txt"} << QString("file1.txt") << true;
+    QTest::newRow("directory only") << QStringList{"cache/"} << QString("x/cache") << true;
+    QTest::newRow("comment") << QStringList{"#main.cpp"} << QString("main.cpp") << false;
+    QTest::newRow("several patterns")
+        << QStringList{"*.o", "node_modules", "/dist"} << QString("web/node_modules/a.js") << true;
+}
+
+void IgnoreMatcherTest::testMatches()
+{
+    QFETCH(QStringList, patterns);
+    QFETCH(QString, path);
+    QFETCH(bool, matches);
+
+    const Context::IgnoreMatcher matcher(patterns);
+    QCOMPARE(matcher.matches(path), matches);
+}
+
+void IgnoreMatcherTest::testLastMatchingPatternWins()
+{
+    const Context::IgnoreMatcher matcher({"*.log", "!keep.log", "logs", "!logs/important.log"});
+
+    QVERIFY(matcher.matches("debug.log"));
+    QVERIFY(!matcher.matches("keep.log"));
+    QVERIFY(matcher.matches("logs/keep.log"));
+    QVERIFY(!matcher.matches("logs/important.log"));
+    QVERIFY(!matcher.matches("main.cpp"));
+}
+
+void IgnoreMatcherTest::testDirectoryPruning()
+{
+    const Context::IgnoreMatcher matcher({"build", "*.o", "cache/"});
+
+    QVERIFY(matcher.canPruneDirectories());
+    QVERIFY(matcher.excludesDirectory("build"));
+    QVERIFY(matcher.excludesDirectory("src/build"));
+    QVERIFY(!matcher.excludesDirectory("src"));
+    // Directory-only patterns match the directory path itself, not what is below it.
+    QVERIFY(!matcher.excludesDirectory("cache"));
+}
+
+void IgnoreMatcherTest::testNoPruningWithNegatedPatterns()
+{
+    const Context::IgnoreMatcher matcher({"build", "!build/keep.txt"});
+
+    QVERIFY(!matcher.canPruneDirectories());
+    QVERIFY(!matcher.excludesDirectory("build"));
+    QVERIFY(matcher.matches("build/x.o"));
+    QVERIFY(!matcher.matches("build/keep.txt"));
+}
+
+} // namespace QodeAssist
@@ -0,0 +1,23 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#pragma once
+
+#include <QObject>
+
+namespace QodeAssist {
+
+class IgnoreMatcherTest final : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testMatches_data();
+    void testMatches();
+    void testLastMatchingPatternWins();
+    void testDirectoryPruning();
+    void testNoPruningWithNegatedPatterns();
+};
+
+} // namespace QodeAssist
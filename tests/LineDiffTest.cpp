@@ -0,0 +1,184 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#include "LineDiffTest.hpp"
+
+#include <QRandomGenerator>
+#include <QTest>
+
+#include "context/LineDiff.hpp"
+
+namespace QodeAssist {
+
+namespace {
+
+using Context::LineDiff;
+
+constexpr int kBenchmarkFunctionCount = 1000;
+
+// Renders the alignment as "=line", "-line" and "+line" entries.
+QStringList render(
+    const LineDiff::Alignment &alignment, const QStringList &original, const QStringList &modified)
+{
+    QStringList result;
+    for (const auto &[originalIndex, modifiedIndex] : alignment) {
+        if (originalIndex >= 0 && modifiedIndex >= 0)
+            result.append("=" + original.at(originalIndex));
+        else if (originalIndex >= 0)
+            result.append("-" + original.at(originalIndex));
+        else
+            result.append("+" + modified.at(modifiedIndex));
+    }
+    return result;
+}
+
+// Every line appears once, in order, and unchanged lines really are equal.
+bool isConsistent(
+    const LineDiff::Alignment &alignment, const QStringList &original, const QStringList &modified)
+{
+    int nextOriginal = 0;
+    int nextModified = 0;
+    for (const auto &[originalIndex, modifiedIndex] : alignment) {
+        if (originalIndex >= 0 && originalIndex != nextOriginal++)
+            return false;
+        if (modifiedIndex >= 0 && modifiedIndex != nextModified++)
+            return false;
+        if (originalIndex >= 0 && modifiedIndex >= 0
+            && original.at(originalIndex) != modified.at(modifiedIndex)) {
+            return false;
+        }
+        if (originalIndex < 0 && modifiedIndex < 0)
+            return false;
+    }
+    return nextOriginal == original.size() && nextModified == modified.size();
+}
+
+// About ten thousand lines of code-like text: many repeated braces and blank lines, with
+// distinct signatures and bodies.
+QStringList makeSource()
+{
+    QStringList lines;
+    for (int i = 0; i < kBenchmarkFunctionCount; ++i) {
+        lines << QString("int function%1(int value)").arg(i) << "{"
+              << QString("    const int scaled = value * %1;").arg(i) << "    if (scaled > 0) {"
+              << "        return scaled;" << "    }"
+              << QString("    return helper%1(value);").arg(i) << "}" << "" << "";
+    }
+    return lines;
+}
+
+} // namespace
+
+void LineDiffTest::testAlignment_data()
+{
+    QTest::addColumn<QStringList>("original");
+    QTest::addColumn<QStringList>("modified");
+    QTest::addColumn<QStringList>("expected");
+
+    QTest::newRow("identical") << QStringList{"a", "b"} << QStringList{"a", "b"}
+                               << QStringList{"=a", "=b"};
+    QTest::newRow("both empty") << QStringList{} << QStringList{} << QStringList{};
+    QTest::newRow("insert into empty")
+        << QStringList{} << QStringList{"a", "b"} << QStringList{"+a", "+b"};
+    QTest::newRow("replace middle") << QStringList{"a", "b", "c"} << QStringList{"a", "x", "c"}
+                                    << QStringList{"=a", "-b", "+x", "=c"};
+    QTest::newRow("full rewrite") << QStringList{"a", "b"} << QStringList{"x", "y"}
+                                  << QStringList{"-a", "-b", "+x", "+y"};
+    QTest::newRow("repeated lines")
+        << QStringList{"}", "}", "x", "x", "}"} << QStringList{"x", "}", "x", "}", "}"}
+        << QStringList{"-}", "-}", "=x", "+}", "=x", "+}", "=}"};
+    QTest::newRow("swapped functions")
+        << QStringList{"void a()", "{", "}", "void b()", "{", "}"}
+        << QStringList{"void b()", "{", "}", "void a()", "{", "}"}
+        << QStringList{"-void a()", "+void b()", "={", "=}", "-void b()", "+void a()", "={", "=}"};
+}
+
+void LineDiffTest::testAlignment()
+{
+    QFETCH(QStringList, original);
+    QFETCH(QStringList, modified);
+    QFETCH(QStringList, expected);
+
+    const LineDiff::Alignment alignment = LineDiff::align(original, modified);
+    QVERIFY(isConsistent(alignment, original, modified));
+    QCOMPARE(render(alignment, original, modified), expected);
+}
+
+void LineDiffTest::testRandomEditsStayConsistent()
+{
+    QRandomGenerator random(42);
+    const QStringList alphabet{"{", "}", "", "return;", "a", "b", "c"};
+
+    for (int round = 0; round < 2000; ++round) {
+        QStringList original;
+        const int size = random.bounded(40);
+        for (int i = 0; i < size; ++i)
+            original.append(alphabet.at(random.bounded(alphabet.size())));
+
+        QStringList modified = original;
+        for (int edit = random.bounded(5); edit >= 0; --edit) {
+            const int position = random.bounded(modified.size() + 1);
+            if (random.bounded(2) && position < modified.size())
+                modified.removeAt(position);
+            else
+                modified.insert(position, QString("new %1").arg(edit));
+        }
+
+        const LineDiff::Alignment alignment = LineDiff::align(original, modified);
+        QVERIFY2(isConsistent(alignment, original, modified), qPrintable(original.join('|')));
+    }
+}
+
+void LineDiffTest::testAgentEditBenchmark_data()
+{
+    QTest::addColumn<QStringList>("original");
+    QTest::addColumn<QStringList>("modified");
+    QTest::addColumn<int>("changedLines");
+
+    const QStringList source = makeSource();
+
+    QStringList bodyRewrite = source;
+    for (int i = 0; i < 20; ++i)
+        bodyRewrite[5002 + i] = QString("    // rewritten %1").arg(i);
+    QTest::newRow("function body rewrite") << source << bodyRewrite << 40;
+
+    QStringList scattered = source;
+    for (int i = 0; i < 10; ++i) {
+        scattered.insert(i * 900 + 3, "    qDebug() << value;");
+        scattered.removeAt(i * 900 + 7);
+    }
+    QTest::newRow("scattered edits") << source << scattered << 20;
+
+    QStringList appended = source;
+    for (int i = 0; i < 300; ++i)
+        appended.append(QString("int added%1();").arg(i));
+    QTest::newRow("appended block") << source << appended << 300;
+
+    QStringList rewritten;
+    for (const QString &line : source)
+        rewritten.append(line.isEmpty() ? line : line + " // reformatted");
+    QTest::newRow("whole file reformat") << source << rewritten << -1;
+}
+
+void LineDiffTest::testAgentEditBenchmark()
+{
+    QFETCH(QStringList, original);
+    QFETCH(QStringList, modified);
+    QFETCH(int, changedLines);
+
+    LineDiff::Alignment alignment;
+    QBENCHMARK {
+        alignment = LineDiff::align(original, modified);
+    }
+
+    QVERIFY(isConsistent(alignment, original, modified));
+    if (changedLines >= 0) {
+        int changes = 0;
+        for (const auto &[originalIndex, modifiedIndex] : alignment)
+            changes += (originalIndex < 0 || modifiedIndex < 0) ? 1 : 0;
+        QCOMPARE(changes, changedLines);
+    }
+}
+
+} // namespace QodeAssist
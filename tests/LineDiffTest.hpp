@@ -0,0 +1,23 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#pragma once
+
+#include <QObject>
+
+namespace QodeAssist {
+
+class LineDiffTest final : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testAlignment_data();
+    void testAlignment();
+    void testRandomEditsStayConsistent();
+    void testAgentEditBenchmark_data();
+    void testAgentEditBenchmark();
+};
+
+} // namespace QodeAssist
@@ -7,10 +7,12 @@
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QSignalSpy>
+#include <QTemporaryDir>
 #include <QTest>
 
 #include <LLMQore/ToolsManager.hpp>
 
+#include "ChatView/ChatFileStore.hpp"
 #include "ChatView/LlmChatBackend.hpp"
 #include "FakeLlmProvider.hpp"
 #include "session/ConversationHistory.hpp"
@@ -72,6 +74,21 @@ public:
     Chat::LlmChatBackend backend;
 };
 
+// Renders messages as "role:content" entries, with tool calls and tool call ids appended.
+QStringList render(const QVector<LLMCore::Message> &messages)
+{
+    QStringList result;
+    for (const LLMCore::Message &message : messages) {
+        QString entry = message.role + ":" + message.content;
+        for (const LLMCore::ToolCall &call : message.toolCalls)
+            entry += " call=" + call.id;
+        if (!message.toolCallId.isEmpty())
+            entry += " result=" + message.toolCallId;
+        result.append(entry);
+    }
+    return result;
+}
+
 } // namespace
 
 void LlmChatBackendTest::testTurnLedgerTracksTheActiveTurn()
@@ -198,6 +215,113 @@ void LlmChatBackendTest::testRenderHistoryKeepsToolExchangePairs()
     QCOMPARE(messages.at(3).content, QString("the answer"));
 }
 
+void LlmChatBackendTest::testRenderHistoryReusesTheRenderedPrefix()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString chatFilePath = dir.filePath("chat.json");
+    QString storedPath;
+    const QString notes = QString::fromLatin1(QByteArray("remember").toBase64());
+    QVERIFY(
+        Chat::ChatFileStore::saveContentToStorage(chatFilePath, "notes.txt", notes, storedPath));
+
+    LlmBackendFixture fixture;
+    fixture.backend.setChatFilePath(chatFilePath);
+
+    Session::Message user;
+    user.role = Session::MessageRole::User;
+    user.id = "u2";
+    user.blocks
+        = {Session::TextBlock{"read it"}, Session::AttachmentBlock{"notes.txt", storedPath}};
+    fixture.history.append(user);
+
+    Session::Message firstCall;
+    firstCall.role = Session::MessageRole::Assistant;
+    firstCall.id = "r1";
+    firstCall.blocks = {Session::ToolCallBlock{"t1", "read_file", {}, "one", {}, "completed"}};
+    fixture.history.append(firstCall);
+
+    fixture.send();
+    const QStringList firstTurn = render(*fixture.provider.lastContext.history);
+    QCOMPARE(firstTurn.size(), 4);
+    QVERIFY(firstTurn.at(1).contains("remember"));
+
+    // Already rendered messages are not read from storage again.
+    QVERIFY(QFile::remove(
+        QDir(Chat::ChatFileStore::getChatContentFolder(chatFilePath)).filePath(storedPath)));
+
+    // Tool calls in the next message still join the assistant message of the previous one.
+    Session::Message secondCall;
+    secondCall.role = Session::MessageRole::Assistant;
+    secondCall.id = "r2";
+    secondCall.blocks
+        = {Session::ToolCallBlock{"t2", "read_file", {}, "two", {}, "completed"},
+           Session::TextBlock{"done"}};
+    fixture.history.append(secondCall);
+
+    fixture.send();
+    QCOMPARE(
+        render(*fixture.provider.lastContext.history),
+        (QStringList{
+            firstTurn.at(0),
+            firstTurn.at(1),
+            "assistant: call=t1 call=t2",
+            "tool:one result=t1",
+            "tool:two result=t2",
+            "assistant:done"}));
+
+    // A changed message is rendered again along with everything after it.
+    Session::ConversationHistory edited;
+    edited.append(fixture.history.at(0));
+    Session::Message editedUser = user;
+    editedUser.blocks = {Session::TextBlock{"read it again"}};
+    edited.append(editedUser);
+    edited.append(secondCall);
+    fixture.history = edited;
+
+    fixture.send();
+    QCOMPARE(
+        render(*fixture.provider.lastContext.history),
+        (QStringList{
+            firstTurn.at(0),
+            "user:read it again",
+            "assistant: call=t2",
+            "tool:two result=t2",
+            "assistant:done"}));
+}
+
+void LlmChatBackendTest::testRenderHistoryRedoesAChangedTrailingToolExchange()
+{
+    LlmBackendFixture fixture;
+
+    Session::Message firstCall;
+    firstCall.role = Session::MessageRole::Assistant;
+    firstCall.id = "r1";
+    firstCall.blocks = {Session::ToolCallBlock{"t1", "read_file", {}, "one", {}, "completed"}};
+    fixture.history.append(firstCall);
+
+    Session::Message secondCall;
+    secondCall.role = Session::MessageRole::Assistant;
+    secondCall.id = "r2";
+    secondCall.blocks = {Session::ToolCallBlock{"t2", "read_file", {}, "partial", {}, "completed"}};
+    fixture.history.append(secondCall);
+
+    fixture.send();
+    QCOMPARE(
+        render(*fixture.provider.lastContext.history).mid(1),
+        (QStringList{
+            "assistant: call=t1 call=t2", "tool:one result=t1", "tool:partial result=t2"}));
+
+    // The last message is rendered again while the prefix still ends in the open group.
+    secondCall.blocks = {Session::ToolCallBlock{"t2", "read_file", {}, "two", {}, "completed"}};
+    *fixture.history.lastMessage() = secondCall;
+
+    fixture.send();
+    QCOMPARE(
+        render(*fixture.provider.lastContext.history).mid(1),
+        (QStringList{"assistant: call=t1 call=t2", "tool:one result=t1", "tool:two result=t2"}));
+}
+
 void LlmChatBackendTest::testLlmBackendIgnoresEventsFromOtherRequests()
 {
     LlmBackendFixture fixture;
@@ -17,6 +17,8 @@ private slots:
     void testTurnLedgerDrainsPermissionsOnTurnEnd();
     void testLlmBackendStreamsThroughAFakeClient();
     void testRenderHistoryKeepsToolExchangePairs();
+    void testRenderHistoryReusesTheRenderedPrefix();
+    void testRenderHistoryRedoesAChangedTrailingToolExchange();
     void testLlmBackendIgnoresEventsFromOtherRequests();
     void testLlmBackendPermissionRoundTrip();
     void testLlmBackendDrainsPermissionsWhenTheTurnEnds();
@@ -5,6 +5,7 @@
 #include "LlmSuggestionTest.hpp"
 
 #include <QTest>
+#include <QTextDocument>
 
 #include "completion/LLMSuggestion.hpp"
 
@@ -85,4 +86,19 @@ void LlmSuggestionTest::testReplaceLengthTrailingWhitespaceOnlyLeftAlone()
     QCOMPARE(LLMSuggestion::calculateReplaceLength("code", "   "), 0);
 }
 
+void LlmSuggestionTest::testApplyReportsAcceptance()
+{
+    QTextDocument document(QStringLiteral("int x = ;"));
+    const Utils::Text::Position anchor{1, 8};
+    LLMSuggestion suggestion(
+        {{Utils::Text::Range{anchor, anchor}, anchor, QStringLiteral("42;")}}, &document);
+
+    int accepted = 0;
+    suggestion.setAcceptedCallback([&accepted] { ++accepted; });
+
+    QVERIFY(suggestion.apply());
+    QCOMPARE(document.toPlainText(), QStringLiteral("int x = 42;"));
+    QCOMPARE(accepted, 1);
+}
+
 } // namespace QodeAssist
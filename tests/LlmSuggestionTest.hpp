@@ -28,6 +28,7 @@ private slots:
     void testReplaceLengthClosingTailNoMatchingClose();
     void testReplaceLengthRealCodeRightNoLcp();
     void testReplaceLengthTrailingWhitespaceOnlyLeftAlone();
+    void testApplyReportsAcceptance();
 };
 
 } // namespace QodeAssist
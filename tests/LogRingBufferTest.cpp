@@ -0,0 +1,104 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#include "LogRingBufferTest.hpp"
+
+#include <QList>
+#include <QStringList>
+#include <QTest>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "logger/LogRingBuffer.hpp"
+
+namespace QodeAssist {
+
+void LogRingBufferTest::testKeepsOrder()
+{
+    LogRingBuffer<QString> buffer(3);
+    QCOMPARE(buffer.capacity(), size_t(4));
+    QVERIFY(!buffer.tryPop());
+
+    // Wraps around the slots several times.
+    for (int round = 0; round < 5; ++round) {
+        QVERIFY(buffer.tryPush(QString("first %1").arg(round)));
+        QVERIFY(buffer.tryPush(QString("second %1").arg(round)));
+        QCOMPARE(buffer.tryPop().value_or(QString()), QString("first %1").arg(round));
+        QCOMPARE(buffer.tryPop().value_or(QString()), QString("second %1").arg(round));
+        QVERIFY(!buffer.tryPop());
+    }
+}
+
+void LogRingBufferTest::testDropsWhenFull()
+{
+    LogRingBuffer<int> buffer(4);
+    for (int i = 0; i < 4; ++i)
+        QVERIFY(buffer.tryPush(i));
+    QVERIFY(!buffer.tryPush(4));
+
+    QCOMPARE(buffer.tryPop().value_or(-1), 0);
+    QVERIFY(buffer.tryPush(5));
+
+    QList<int> drained;
+    while (const auto value = buffer.tryPop())
+        drained.append(*value);
+    QCOMPARE(drained, QList<int>({1, 2, 3, 5}));
+}
+
+void LogRingBufferTest::testConcurrentProducers()
+{
+    constexpr int kProducers = 4;
+    constexpr int kMessagesPerProducer = 20000;
+
+    LogRingBuffer<QString> buffer(256);
+    std::atomic<int> pushed{0};
+    std::atomic<bool> producing{true};
+
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < kProducers; ++producer) {
+        producers.emplace_back([&buffer, &pushed, producer] {
+            for (int i = 0; i < kMessagesPerProducer; ++i) {
+                if (buffer.tryPush(QString("%1:%2").arg(producer).arg(i)))
+                    ++pushed;
+            }
+        });
+    }
+
+    // Messages from one producer come out in the order it pushed them.
+    QList<int> lastSeen(kProducers, -1);
+    int popped = 0;
+    bool ordered = true;
+    std::thread consumer([&] {
+        while (true) {
+            std::optional<QString> value = buffer.tryPop();
+            if (!value) {
+                if (producing)
+                    continue;
+                value = buffer.tryPop();
+                if (!value)
+                    break;
+            }
+            const QStringList parts = value->split(':');
+            const int producer = parts.at(0).toInt();
+            const int index = parts.at(1).toInt();
+            if (index <= lastSeen[producer])
+                ordered = false;
+            lastSeen[producer] = index;
+            ++popped;
+        }
+    });
+
+    for (std::thread &producer : producers)
+        producer.join();
+    producing = false;
+    consumer.join();
+
+    QVERIFY(ordered);
+    QVERIFY(pushed > 0);
+    QCOMPARE(popped, pushed.load());
+}
+
+} // namespace QodeAssist
@@ -0,0 +1,147 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#include "MessageSegmenterTest.hpp"
+
+#include <QTest>
+
+#include "ChatView/MessageSegmenter.hpp"
+
+namespace QodeAssist {
+
+namespace {
+
+using Chat::MessagePart;
+using Chat::MessagePartType;
+using Chat::MessageSegmenter;
+
+constexpr int kBenchmarkBlockCount = 40;
+
+// Renders parts as "text:..." and "code(language):..." entries.
+QStringList render(const QList<MessagePart> &parts)
+{
+    QStringList result;
+    for (const MessagePart &part : parts) {
+        if (part.type == MessagePartType::Code)
+            result.append(QString("code(%1):%2").arg(part.language, part.text));
+        else
+            result.append("text:" + part.text);
+    }
+    return result;
+}
+
+// A long answer: prose between code blocks of about a dozen lines each.
+QString makeAnswer()
+{
+    QString answer;
+    for (int block = 0; block < kBenchmarkBlockCount; ++block) {
+        answer += QString("Step %1 changes the helper so that it handles the new case.\n\n")
+                      .arg(block);
+        answer += "```cpp\n";
+        for (int line = 0; line < 12; ++line)
+            answer += QString("    const int value%1 = compute(%2, %1);\n").arg(line).arg(block);
+        answer += "```\n\n";
+    }
+    answer += "That is all.";
+    return answer;
+}
+
+// The answer cut into the pieces a provider would stream, a few characters at a time.
+QStringList tokensOf(const QString &answer)
+{
+    QStringList tokens;
+    for (qsizetype i = 0; i < answer.size(); i += 4)
+        tokens.append(answer.mid(i, 4));
+    return tokens;
+}
+
+} // namespace
+
+void MessageSegmenterTest::testSplit_data()
+{
+    QTest::addColumn<QString>("content");
+    QTest::addColumn<QStringList>("expected");
+
+    QTest::newRow("empty") << QString() << QStringList{};
+    QTest::newRow("whitespace") << QString(" \n ") << QStringList{};
+    QTest::newRow("text") << QString("  hello\n") << QStringList{"text:hello"};
+    QTest::newRow("closed block")
+        << QString("before\n```cpp\nint a;\n```\nafter")
+        << QStringList{"text:before", "code(cpp):int a;", "text:after"};
+    QTest::newRow("adjacent blocks")
+        << QString("```\na\n``````py\nb\n```")
+        << QStringList{"code():a", "code(py):b"};
+    QTest::newRow("unclosed block")
+        << QString("intro\n```js\nlet x")
+        << QStringList{"text:intro", "code(js):let x"};
+    QTest::newRow("unclosed after closed")
+        << QString("```\na\n```\nmiddle\n```\nb")
+        << QStringList{"code():a", "text:middle", "code():b"};
+    QTest::newRow("opening fence only")
+        << QString("text ```") << QStringList{"text:text", "code():"};
+}
+
+void MessageSegmenterTest::testSplit()
+{
+    QFETCH(QString, content);
+    QFETCH(QStringList, expected);
+
+    QCOMPARE(render(MessageSegmenter::split(content)), expected);
+}
+
+void MessageSegmenterTest::testStreamingMatchesFullSplit()
+{
+    const QString answer = makeAnswer();
+
+    MessageSegmenter segmenter;
+    QString streamed;
+    for (const QString &token : tokensOf(answer)) {
+        streamed += token;
+        QCOMPARE(segmenter.update(streamed), MessageSegmenter::split(streamed));
+    }
+    QCOMPARE(segmenter.parts().size(), 2 * kBenchmarkBlockCount + 1);
+}
+
+void MessageSegmenterTest::testClosedPartsAreKept()
+{
+    MessageSegmenter segmenter;
+    segmenter.update("intro\n```cpp\nint a;\n```\nmore");
+    const QString closedCode = segmenter.parts().at(1).text;
+
+    segmenter.update("intro\n```cpp\nint a;\n```\nmore text");
+
+    QCOMPARE(
+        render(segmenter.parts()),
+        (QStringList{"text:intro", "code(cpp):int a;", "text:more text"}));
+    // Parts before the open tail are not produced again.
+    QVERIFY(segmenter.parts().at(1).text.isSharedWith(closedCode));
+}
+
+void MessageSegmenterTest::testRewrittenContentIsParsedAgain()
+{
+    MessageSegmenter segmenter;
+    segmenter.update("```\na\n```\ntail");
+
+    QCOMPARE(render(segmenter.update("```\nb\n```\ntail")), (QStringList{"code():b", "text:tail"}));
+    QCOMPARE(render(segmenter.update("short")), QStringList{"text:short"});
+    QCOMPARE(render(segmenter.update(QString())), QStringList{});
+}
+
+void MessageSegmenterTest::testStreamingBenchmark()
+{
+    const QStringList tokens = tokensOf(makeAnswer());
+
+    QList<MessagePart> parts;
+    QBENCHMARK {
+        MessageSegmenter segmenter;
+        QString streamed;
+        for (const QString &token : tokens) {
+            streamed += token;
+            parts = segmenter.update(streamed);
+        }
+    }
+    QCOMPARE(parts.size(), 2 * kBenchmarkBlockCount + 1);
+}
+
+} // namespace QodeAssist
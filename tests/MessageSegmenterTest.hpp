@@ -0,0 +1,24 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#pragma once
+
+#include <QObject>
+
+namespace QodeAssist {
+
+class MessageSegmenterTest final : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testSplit_data();
+    void testSplit();
+    void testStreamingMatchesFullSplit();
+    void testClosedPartsAreKept();
+    void testRewrittenContentIsParsedAgain();
+    void testStreamingBenchmark();
+};
+
+} // namespace QodeAssist
@@ -0,0 +1,186 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#include "RequestPerformanceLoggerTest.hpp"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTest>
+
+#include "logger/RequestPerformanceLogger.hpp"
+
+namespace QodeAssist {
+
+namespace {
+
+const RequestLabels kOllamaLabels{"Ollama", "qwen2.5-coder", "FIM"};
+const RequestLabels kClaudeLabels{"Claude", "claude-haiku", "FIM with context"};
+
+void finishRequest(
+    RequestPerformanceLogger &logger,
+    const QString &requestId,
+    const RequestLabels &labels,
+    qint64 firstByteMs)
+{
+    logger.startTimeMeasurement(requestId);
+    logger.describeRequest(requestId, labels);
+    logger.recordPhase(requestId, RequestPhase::Context, 3);
+    logger.recordPhase(requestId, RequestPhase::FirstByte, firstByteMs);
+    logger.endTimeMeasurement(requestId);
+}
+
+RequestPerformanceLogger::LatencySummary summaryFor(
+    const RequestPerformanceLogger &logger, const QString &provider, const QString &metric)
+{
+    for (const auto &summary : logger.latencySummaries()) {
+        if (summary.labels.provider == provider && summary.metric == metric)
+            return summary;
+    }
+    return {};
+}
+
+} // namespace
+
+void RequestPerformanceLoggerTest::testRecordsPhases()
+{
+    RequestPerformanceLogger logger;
+    logger.startTimeMeasurement("request-1");
+    logger.describeRequest("request-1", kOllamaLabels);
+    logger.recordPhase("request-1", RequestPhase::Context, 12);
+    logger.recordPhase("request-1", RequestPhase::Enrichment, -1);
+    logger.recordPhase("request-1", RequestPhase::Payload, 30);
+    logger.recordPhase("request-1", RequestPhase::FirstByte, 200);
+    logger.recordPhase("request-1", RequestPhase::PostProcess, 2);
+    logger.endTimeMeasurement("request-1");
+
+    // Phases of a request that is not being measured are dropped.
+    logger.recordPhase("request-1", RequestPhase::Stream, 50);
+
+    const auto records = logger.records();
+    QCOMPARE(records.size(), 1);
+    const auto &record = records.first();
+    QCOMPARE(record.requestId, QString("request-1"));
+    QCOMPARE(record.labels.model, kOllamaLabels.model);
+    QCOMPARE(record.phases[size_t(RequestPhase::Context)], qint64(12));
+    QCOMPARE(record.phases[size_t(RequestPhase::Enrichment)], qint64(-1));
+    QCOMPARE(record.phases[size_t(RequestPhase::Payload)], qint64(30));
+    QCOMPARE(record.phases[size_t(RequestPhase::FirstByte)], qint64(200));
+    QCOMPARE(record.phases[size_t(RequestPhase::Stream)], qint64(-1));
+    QCOMPARE(record.phases[size_t(RequestPhase::PostProcess)], qint64(2));
+
+    // Work done before the request was sent counts towards the total.
+    QVERIFY(record.total >= 42);
+    QCOMPARE(logger.latencyPercentile(50), record.total);
+}
+
+void RequestPerformanceLoggerTest::testCancelledRequestIsNotRecorded()
+{
+    RequestPerformanceLogger logger;
+    logger.startTimeMeasurement("request-1");
+    logger.recordPhase("request-1", RequestPhase::Context, 5);
+    logger.cancelTimeMeasurement("request-1");
+    logger.endTimeMeasurement("request-1");
+
+    QVERIFY(logger.records().isEmpty());
+    QVERIFY(logger.latencySummaries().isEmpty());
+    QCOMPARE(logger.latencyPercentile(50), qint64(-1));
+}
+
+void RequestPerformanceLoggerTest::testFailedRequestsStayOutOfPercentiles()
+{
+    RequestPerformanceLogger logger;
+    finishRequest(logger, "request-1", kOllamaLabels, 100);
+    logger.startTimeMeasurement("request-2");
+    logger.describeRequest("request-2", kOllamaLabels);
+    logger.recordPhase("request-2", RequestPhase::FirstByte, 30000);
+    logger.failTimeMeasurement("request-2");
+    logger.startTimeMeasurement("request-3");
+    logger.describeRequest("request-3", kClaudeLabels);
+    logger.failTimeMeasurement("request-3");
+
+    QCOMPARE(logger.records().size(), 3);
+    QCOMPARE(logger.records().at(1).outcome, RequestOutcome::Failed);
+    QCOMPARE(logger.latencyPercentile(99), logger.records().first().total);
+
+    const auto ttfb = summaryFor(logger, "Ollama", "ttfb");
+    QCOMPARE(ttfb.count, 1);
+    QCOMPARE(ttfb.p99, qint64(100));
+    QCOMPARE(ttfb.failed, 1);
+
+    // Labels with nothing but failures still show them.
+    const auto claude = summaryFor(logger, "Claude", "total");
+    QCOMPARE(claude.count, 0);
+    QCOMPARE(claude.failed, 1);
+    QCOMPARE(summaryFor(logger, "Claude", "context").failed, 0);
+}
+
+void RequestPerformanceLoggerTest::testSummariesPerLabels()
+{
+    RequestPerformanceLogger logger;
+    for (int i = 1; i <= 100; ++i)
+        finishRequest(logger, QString("ollama-%1").arg(i), kOllamaLabels, i * 10);
+    finishRequest(logger, "claude-1", kClaudeLabels, 700);
+
+    const auto ollama = summaryFor(logger, "Ollama", "ttfb");
+    QCOMPARE(ollama.count, 100);
+    QCOMPARE(ollama.labels.requestType, kOllamaLabels.requestType);
+    QCOMPARE(ollama.p50, qint64(500));
+    QCOMPARE(ollama.p95, qint64(950));
+    QCOMPARE(ollama.p99, qint64(990));
+
+    const auto claude = summaryFor(logger, "Claude", "ttfb");
+    QCOMPARE(claude.count, 1);
+    QCOMPARE(claude.p50, qint64(700));
+    QCOMPARE(claude.p99, qint64(700));
+
+    QCOMPARE(summaryFor(logger, "Ollama", "total").count, 100);
+    // Phases that were never measured are not summarised.
+    QCOMPARE(summaryFor(logger, "Ollama", "stream").count, 0);
+}
+
+void RequestPerformanceLoggerTest::testExportCsv()
+{
+    RequestPerformanceLogger logger;
+    finishRequest(logger, "request-1", {"Ollama", "qwen, coder", "FIM"}, 120);
+
+    const QStringList lines = QString::fromUtf8(logger.exportCsv()).split('\n', Qt::SkipEmptyParts);
+    QCOMPARE(lines.size(), 2);
+    QCOMPARE(
+        lines.at(0),
+        QString("finished_at,request_id,provider,model,request_type,context_ms,enrichment_ms,"
+                "payload_ms,ttfb_ms,stream_ms,post_process_ms,total_ms,outcome"));
+    QVERIFY(lines.at(1).contains(",request-1,Ollama,\"qwen, coder\",FIM,3,,,120,,,"));
+    QVERIFY(lines.at(1).endsWith(",completed"));
+}
+
+void RequestPerformanceLoggerTest::testExportJson()
+{
+    RequestPerformanceLogger logger;
+    finishRequest(logger, "request-1", kOllamaLabels, 120);
+    finishRequest(logger, "request-2", kOllamaLabels, 80);
+
+    const QJsonObject root = QJsonDocument::fromJson(logger.exportJson()).object();
+    const QJsonArray requests = root.value("requests").toArray();
+    QCOMPARE(requests.size(), 2);
+    const QJsonObject first = requests.at(0).toObject();
+    QCOMPARE(first.value("id").toString(), QString("request-1"));
+    QCOMPARE(first.value("provider").toString(), kOllamaLabels.provider);
+    QCOMPARE(first.value("phases").toObject().value("ttfb").toInteger(), qint64(120));
+    QVERIFY(!first.value("phases").toObject().contains("stream"));
+
+    bool foundTtfb = false;
+    for (const QJsonValue &value : root.value("summaries").toArray()) {
+        const QJsonObject summary = value.toObject();
+        if (summary.value("metric").toString() != "ttfb")
+            continue;
+        foundTtfb = true;
+        QCOMPARE(summary.value("count").toInt(), 2);
+        QCOMPARE(summary.value("p50").toInteger(), qint64(80));
+        QCOMPARE(summary.value("p99").toInteger(), qint64(80));
+    }
+    QVERIFY(foundTtfb);
+}
+
+} // namespace QodeAssist
@@ -0,0 +1,24 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#pragma once
+
+#include <QObject>
+
+namespace QodeAssist {
+
+class RequestPerformanceLoggerTest final : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testRecordsPhases();
+    void testCancelledRequestIsNotRecorded();
+    void testFailedRequestsStayOutOfPercentiles();
+    void testSummariesPerLabels();
+    void testExportCsv();
+    void testExportJson();
+};
+
+} // namespace QodeAssist
@@ -968,4 +968,79 @@ void SessionTest::testAgentActivityBlocksSurviveReload()
     QCOMPARE(Session::buildFromRows(rows), history);
 }
 
+void SessionTest::testStreamedTextUpdatesOnlyTheTailRow()
+{
+    FakeChatBackend backend;
+    Session::Session session;
+    session.setBackend(&backend);
+
+    session.sendTurn({Session::TextBlock{"go"}}, std::nullopt);
+    backend.script(
+        {Session::TurnStarted{"r1"},
+         Session::TextDelta{"r1", "let me check"},
+         llmToolStarted("r1", "t1", "read_file"),
+         Session::TextDelta{"r1", "here"}});
+    QCOMPARE(session.rows().size(), 4);
+
+    QList<int> updatedRows;
+    int appended = 0;
+    QObject::connect(
+        &session,
+        &Session::Session::rowUpdated,
+        &session,
+        [&updatedRows](int index, const Session::MessageRow &) { updatedRows.append(index); });
+    QObject::connect(
+        &session,
+        &Session::Session::rowsAppended,
+        &session,
+        [&appended](const QList<Session::MessageRow> &rows) { appended += rows.size(); });
+
+    // Whitespace on its own changes nothing visible until text follows it.
+    backend.script(
+        {Session::TextDelta{"r1", " is"},
+         Session::TextDelta{"r1", "  \n"},
+         Session::TextDelta{"r1", "the answer"}});
+
+    QCOMPARE(updatedRows, (QList<int>{3, 3}));
+    QCOMPARE(appended, 0);
+    QCOMPARE(session.rows().at(1).content, QString("let me check"));
+    QCOMPARE(session.rows().at(3).content, QString("here is  \nthe answer"));
+    QCOMPARE(
+        session.history().at(1).blocks.last(),
+        (Session::ContentBlock{Session::TextBlock{"here is  \nthe answer"}}));
+    QCOMPARE(session.rows(), Session::projectToRows(session.history()));
+}
+
+void SessionTest::testStreamingLongMessageBenchmark()
+{
+    // 50k deltas into a message that grows to 200 blocks: text segments between tool calls.
+    constexpr int kSegments = 100;
+    constexpr int kDeltasPerSegment = 500;
+
+    QList<Session::SessionEvent> events{Session::TurnStarted{"r1"}};
+    events.reserve(kSegments * (kDeltasPerSegment + 1) + 1);
+    for (int segment = 0; segment < kSegments; ++segment) {
+        for (int delta = 0; delta < kDeltasPerSegment; ++delta)
+            events.append(Session::TextDelta{"r1", delta % 8 == 7 ? "token\n" : "token "});
+        events.append(llmToolStarted("r1", QString("t%1").arg(segment), "read_file"));
+    }
+
+    FakeChatBackend backend;
+    Session::Session session;
+    session.setBackend(&backend);
+
+    QBENCHMARK {
+        session.clear();
+        session.sendTurn({Session::TextBlock{"go"}}, std::nullopt);
+        backend.script(events);
+    }
+
+    QCOMPARE(session.history().at(1).blocks.size(), 2 * kSegments);
+    QCOMPARE(session.rows().size(), 1 + 2 * kSegments);
+    const QString &lastText = session.rows().at(2 * kSegments - 1).content;
+    QCOMPARE(lastText.count(QStringLiteral("token")), kDeltasPerSegment);
+    QVERIFY(!lastText.endsWith(QLatin1Char('\n')));
+    QCOMPARE(session.rows(), Session::projectToRows(session.history()));
+}
+
 } // namespace QodeAssist
@@ -45,6 +45,8 @@ private slots:
     void testAgentToolUpdateTouchesOnlyItsOwnRow();
     void testUsageSkipsRowsThatCannotShowIt();
     void testAgentActivityBlocksSurviveReload();
+    void testStreamedTextUpdatesOnlyTheTailRow();
+    void testStreamingLongMessageBenchmark();
 };
 
 } // namespace QodeAssist
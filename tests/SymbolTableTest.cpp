@@ -0,0 +1,149 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#include "SymbolTableTest.hpp"
+
+#include <QTest>
+
+#include <algorithm>
+
+#include "tools/SymbolTable.hpp"
+
+namespace QodeAssist {
+
+namespace {
+
+using Tools::SymbolTable;
+
+constexpr int kBenchmarkFileCount = 2000;
+constexpr int kBenchmarkSymbolsPerFile = 500;
+
+SymbolTable::Symbol makeSymbol(
+    const QString &name, const QString &filePath, int line, quint8 kinds = SymbolTable::Function)
+{
+    SymbolTable::Symbol symbol;
+    symbol.name = name;
+    symbol.filePath = filePath;
+    symbol.line = line;
+    symbol.kinds = kinds;
+    return symbol;
+}
+
+QStringList locations(const QList<SymbolTable::Symbol> &symbols)
+{
+    QStringList result;
+    for (const SymbolTable::Symbol &symbol : symbols)
+        result.append(QString("%1 %2:%3").arg(symbol.name, symbol.filePath).arg(symbol.line));
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+SymbolTable makeTable()
+{
+    SymbolTable table;
+    table.setFile(
+        "/p/widget.h",
+        {makeSymbol("Widget", "/p/widget.h", 3, SymbolTable::Class),
+         makeSymbol("paint", "/p/widget.h", 5),
+         makeSymbol("paintEvent", "/p/widget.h", 6)});
+    table.setFile(
+        "/p/model.h",
+        {makeSymbol("Model", "/p/model.h", 2, SymbolTable::Class),
+         makeSymbol("widget", "/p/model.h", 8, SymbolTable::Declaration),
+         makeSymbol("Paint", "/p/model.h", 9, SymbolTable::Enum)});
+    return table;
+}
+
+} // namespace
+
+void SymbolTableTest::testExactLookup()
+{
+    const SymbolTable table = makeTable();
+
+    QCOMPARE(
+        locations(table.find("Widget", SymbolTable::Match::Exact, Qt::CaseSensitive)),
+        QStringList{"Widget /p/widget.h:3"});
+    QCOMPARE(
+        locations(table.find("WIDGET", SymbolTable::Match::Exact, Qt::CaseInsensitive)),
+        QStringList({"Widget /p/widget.h:3", "widget /p/model.h:8"}));
+    QVERIFY(table.find("WIDGET", SymbolTable::Match::Exact, Qt::CaseSensitive).isEmpty());
+    QVERIFY(table.find("Widge", SymbolTable::Match::Exact, Qt::CaseInsensitive).isEmpty());
+}
+
+void SymbolTableTest::testPrefixLookup()
+{
+    const SymbolTable table = makeTable();
+
+    QCOMPARE(
+        locations(table.find("paint", SymbolTable::Match::Prefix, Qt::CaseSensitive)),
+        QStringList({"paint /p/widget.h:5", "paintEvent /p/widget.h:6"}));
+    QCOMPARE(
+        locations(table.find("PAINT", SymbolTable::Match::Prefix, Qt::CaseInsensitive)),
+        QStringList({"Paint /p/model.h:9", "paint /p/widget.h:5", "paintEvent /p/widget.h:6"}));
+    QVERIFY(table.find("z", SymbolTable::Match::Prefix, Qt::CaseInsensitive).isEmpty());
+    QVERIFY(table.find({}, SymbolTable::Match::Prefix, Qt::CaseInsensitive).isEmpty());
+}
+
+void SymbolTableTest::testRegexLookup()
+{
+    const SymbolTable table = makeTable();
+
+    QCOMPARE(
+        locations(table.find(QRegularExpression("^[A-Z].*l$"))),
+        QStringList{"Model /p/model.h:2"});
+    const QRegularExpression caseInsensitive("event", QRegularExpression::CaseInsensitiveOption);
+    QCOMPARE(locations(table.find(caseInsensitive)), QStringList{"paintEvent /p/widget.h:6"});
+    QVERIFY(table.find(QRegularExpression("(")).isEmpty());
+}
+
+void SymbolTableTest::testReplaceAndRemoveFiles()
+{
+    SymbolTable table = makeTable();
+    QCOMPARE(table.fileCount(), 2);
+    QCOMPARE(table.symbolCount(), 6);
+
+    table.setFile("/p/widget.h", {makeSymbol("Widget", "/p/widget.h", 4, SymbolTable::Class)});
+    QCOMPARE(table.symbolCount(), 4);
+    QCOMPARE(
+        locations(table.find("Widget", SymbolTable::Match::Exact, Qt::CaseSensitive)),
+        QStringList{"Widget /p/widget.h:4"});
+    QVERIFY(table.find("paintEvent", SymbolTable::Match::Exact, Qt::CaseSensitive).isEmpty());
+
+    table.removeFile("/p/model.h");
+    QVERIFY(!table.containsFile("/p/model.h"));
+    QCOMPARE(table.fileCount(), 1);
+    QCOMPARE(table.symbolCount(), 1);
+    QCOMPARE(
+        locations(table.find("widget", SymbolTable::Match::Exact, Qt::CaseInsensitive)),
+        QStringList{"Widget /p/widget.h:4"});
+
+    table.setFile("/p/empty.h", {});
+    QVERIFY(!table.containsFile("/p/empty.h"));
+}
+
+void SymbolTableTest::testLookupThroughput()
+{
+    SymbolTable table;
+    for (int file = 0; file < kBenchmarkFileCount; ++file) {
+        const QString filePath = QString("/p/file%1.h").arg(file);
+        QList<SymbolTable::Symbol> symbols;
+        for (int i = 0; i < kBenchmarkSymbolsPerFile; ++i)
+            symbols.append(makeSymbol(QString("symbol%1_%2").arg(file).arg(i), filePath, i + 1));
+        table.setFile(filePath, symbols);
+    }
+    QCOMPARE(table.symbolCount(), kBenchmarkFileCount * kBenchmarkSymbolsPerFile);
+
+    QList<SymbolTable::Symbol> found;
+    QBENCHMARK {
+        found = table.find("SYMBOL1234_56", SymbolTable::Match::Exact, Qt::CaseInsensitive);
+    }
+    QCOMPARE(found.size(), 1);
+
+    QBENCHMARK {
+        found = table.find("symbol1234_", SymbolTable::Match::Prefix, Qt::CaseSensitive);
+    }
+    QCOMPARE(found.size(), kBenchmarkSymbolsPerFile);
+}
+
+} // namespace QodeAssist
@@ -0,0 +1,201 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#include "TextScannerTest.hpp"
+
+#include <QFile>
+#include <QTest>
+
+#include "tools/TextScanner.hpp"
+
+namespace QodeAssist {
+
+namespace {
+
+using Tools::TextScanner;
+
+constexpr int kBenchmarkFileCount = 200;
+constexpr int kBenchmarkLinesPerFile = 2000;
+
+TextScanner makeScanner(
+    const QString &query, bool caseSensitive, bool useRegex = false, bool wholeWords = false)
+{
+    TextScanner::Options options;
+    options.query = query;
+    options.caseSensitive = caseSensitive;
+    options.useRegex = useRegex;
+    options.wholeWords = wholeWords;
+    return TextScanner(options);
+}
+
+QStringList matchedLines(const QList<TextScanner::Match> &matches)
+{
+    QStringList lines;
+    for (const TextScanner::Match &match : matches)
+        lines.append(match.line);
+    return lines;
+}
+
+} // namespace
+
+QString TextScannerTest::writeFile(const QString &name, const QByteArray &content)
+{
+    const QString path = m_dir.filePath(name);
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(content) != content.size())
+        return {};
+    return path;
+}
+
+void TextScannerTest::testMatchesLines_data()
+{
+    QTest::addColumn<QString>("query");
+    QTest::addColumn<bool>("caseSensitive");
+    QTest::addColumn<bool>("useRegex");
+    QTest::addColumn<bool>("wholeWords");
+    QTest::addColumn<QStringList>("expected");
+
+    QTest::newRow("literal") << QString("paint") << true << false << false
+                             << QStringList{"void paint();", "void repaint();"};
+    QTest::newRow("literal case sensitive")
+        << QString("Paint") << true << false << false << QStringList{"// Paint everything"};
+    QTest::newRow("literal case insensitive")
+        << QString("PAINT") << false << false << false
+        << QStringList{"void paint();", "void repaint();", "// Paint everything"};
+    QTest::newRow("literal non-ASCII case insensitive")
+        << QString("GRÖßE") << false << false << false << QStringList{"int größe; // Größe"};
+    QTest::newRow("whole words") << QString("paint") << false << false << true
+                                 << QStringList{"void paint();", "// Paint everything"};
+    QTest::newRow("regex with literal")
+        << QString("void \\w*paint\\(") << true << true << false
+        << QStringList{"void paint();", "void repaint();"};
+    QTest::newRow("regex without literal")
+        << QString("^\\s*//") << true << true << false << QStringList{"// Paint everything"};
+    QTest::newRow("regex inline case option")
+        << QString("(?i)PAINT every") << true << true << false
+        << QStringList{"// Paint everything"};
+    QTest::newRow("no match") << QString("missing") << false << false << false << QStringList{};
+}
+
+void TextScannerTest::testMatchesLines()
+{
+    QFETCH(QString, query);
+    QFETCH(bool, caseSensitive);
+    QFETCH(bool, useRegex);
+    QFETCH(bool, wholeWords);
+    QFETCH(QStringList, expected);
+
+    const QString path = writeFile(
+        "lines.cpp",
+        "void paint();\n"
+        "void repaint();\n"
+        "// Paint everything\n"
+        "int größe; // Größe\n");
+    QVERIFY(!path.isEmpty());
+
+    const TextScanner scanner = makeScanner(query, caseSensitive, useRegex, wholeWords);
+    QVERIFY(scanner.isValid());
+    QCOMPARE(matchedLines(scanner.scan({path}, 100)), expected);
+}
+
+void TextScannerTest::testLineNumbersAndLineEndings()
+{
+    const QString path = writeFile(
+        "endings.cpp", "\xEF\xBB\xBF" "first target\r\nsecond\r\n\r\nfourth target\nlast target");
+    QVERIFY(!path.isEmpty());
+
+    const QList<TextScanner::Match> matches = makeScanner("target", true).scan({path}, 100);
+    QCOMPARE(matches.size(), 3);
+    QCOMPARE(matches.at(0).lineNumber, 1);
+    QCOMPARE(matches.at(0).line, QString("first target"));
+    QCOMPARE(matches.at(1).lineNumber, 4);
+    QCOMPARE(matches.at(1).line, QString("fourth target"));
+    QCOMPARE(matches.at(2).lineNumber, 5);
+    QCOMPARE(matches.at(2).line, QString("last target"));
+
+    // Lines are matched one at a time, as before.
+    QVERIFY(makeScanner("second\n", true).scan({path}, 100).isEmpty());
+}
+
+void TextScannerTest::testLinesAcrossReadChunks()
+{
+    // Files are read a megabyte at a time; lines straddling that boundary must stay whole.
+    const QByteArray filler(99, 'x');
+    QByteArray content;
+    int lines = 0;
+    while (content.size() < 3 * 1024 * 1024) {
+        content += filler + (lines % 10000 == 9999 ? " needle" : "") + '\n';
+        ++lines;
+    }
+    content += "last needle";
+    const QString path = writeFile("chunks.txt", content);
+    QVERIFY(!path.isEmpty());
+
+    const QList<TextScanner::Match> matches = makeScanner("needle", true).scan({path}, 100);
+    QCOMPARE(matches.size(), lines / 10000 + 1);
+    for (int i = 0; i < matches.size() - 1; ++i) {
+        QCOMPARE(matches.at(i).lineNumber, (i + 1) * 10000);
+        QCOMPARE(matches.at(i).line, QString::fromLatin1(filler + " needle"));
+    }
+    QCOMPARE(matches.last().lineNumber, lines + 1);
+    QCOMPARE(matches.last().line, QString("last needle"));
+}
+
+void TextScannerTest::testInvalidRegex()
+{
+    QVERIFY(!makeScanner("(unclosed", true, true).isValid());
+    QVERIFY(makeScanner("(unclosed", true).isValid());
+}
+
+void TextScannerTest::testStopsAtLimitInFileOrder()
+{
+    QStringList files;
+    for (int i = 0; i < 20; ++i) {
+        QByteArray content;
+        for (int line = 0; line < 10; ++line)
+            content += "match " + QByteArray::number(i) + ":" + QByteArray::number(line) + "\n";
+        files.append(writeFile(QString("limit%1.txt").arg(i), content));
+        QVERIFY(!files.last().isEmpty());
+    }
+
+    const QList<TextScanner::Match> matches = makeScanner("match", true).scan(files, 25);
+    QCOMPARE(matches.size(), 26);
+    for (int i = 0; i < matches.size(); ++i) {
+        QCOMPARE(matches.at(i).fileIndex, i / 10);
+        QCOMPARE(matches.at(i).lineNumber, i % 10 + 1);
+    }
+
+    QCOMPARE(makeScanner("match 3:", true).scan(files, 25).size(), 10);
+}
+
+void TextScannerTest::testScanThroughput()
+{
+    QStringList files;
+    for (int i = 0; i < kBenchmarkFileCount; ++i) {
+        QByteArray content;
+        for (int line = 0; line < kBenchmarkLinesPerFile; ++line)
+            content += "    const int value" + QByteArray::number(line) + " = compute(input);\n";
+        if (i == kBenchmarkFileCount - 1)
+            content += "    return needleValue;\n";
+        files.append(writeFile(QString("bench%1.cpp").arg(i), content));
+        QVERIFY(!files.last().isEmpty());
+    }
+
+    const TextScanner literal = makeScanner("needlevalue", false);
+    const TextScanner wholeWord = makeScanner("needleValue", true, false, true);
+
+    QList<TextScanner::Match> matches;
+    QBENCHMARK {
+        matches = literal.scan(files, 100);
+    }
+    QCOMPARE(matches.size(), 1);
+    QCOMPARE(matches.first().lineNumber, kBenchmarkLinesPerFile + 1);
+
+    QBENCHMARK {
+        matches = wholeWord.scan(files, 100);
+    }
+    QCOMPARE(matches.size(), 1);
+}
+
+} // namespace QodeAssist
@@ -0,0 +1,32 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#pragma once
+
+#include <QObject>
+#include <QStringList>
+#include <QTemporaryDir>
+
+namespace QodeAssist {
+
+class TextScannerTest final : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testMatchesLines_data();
+    void testMatchesLines();
+    void testLineNumbersAndLineEndings();
+    void testLinesAcrossReadChunks();
+    void testInvalidRegex();
+    void testStopsAtLimitInFileOrder();
+    void testScanThroughput();
+
+private:
+    QString writeFile(const QString &name, const QByteArray &content);
+
+    QTemporaryDir m_dir;
+};
+
+} // namespace QodeAssist
@@ -0,0 +1,206 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#include "TokenizerTest.hpp"
+
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "context/BpeTokenizer.hpp"
+#include "context/TokenUtils.hpp"
+#include "context/TokenizerRegistry.hpp"
+
+namespace QodeAssist {
+
+namespace {
+
+// "abc abc" splits into "abc" and " abc". The first is a single token, the second merges
+// "ab" (rank 4) before " ab" (rank 6), then "abc" (rank 5), leaving " " + "abc".
+const QList<QPair<QByteArray, int>> kRanks
+    = {{"a", 0}, {"b", 1}, {"c", 2}, {" ", 3}, {"ab", 4}, {"abc", 5}, {" ab", 6}};
+
+bool writeFile(const QString &path, const QByteArray &content)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    return file.write(content) == content.size();
+}
+
+QByteArray tiktokenContent()
+{
+    QByteArray content;
+    for (const auto &[token, rank] : kRanks)
+        content += token.toBase64() + ' ' + QByteArray::number(rank) + '\n';
+    return content;
+}
+
+QByteArray huggingFaceContent()
+{
+    QJsonObject vocab;
+    for (const auto &[token, rank] : kRanks) {
+        QString key = QString::fromUtf8(token);
+        key.replace(QChar(' '), QChar(0x0120)); // GPT-2 byte-level space, "Ġ"
+        vocab.insert(key, rank);
+    }
+
+    const QJsonObject root{
+        {"model", QJsonObject{{"type", "BPE"}, {"vocab", vocab}}},
+        {"pre_tokenizer", QJsonObject{{"type", "ByteLevel"}}}};
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+} // namespace
+
+void TokenizerTest::initTestCase()
+{
+    m_tokenizerDirectory = Context::TokenizerRegistry::instance().vocabularyDirectory();
+}
+
+void TokenizerTest::cleanupTestCase()
+{
+    Context::TokenizerRegistry::instance().setVocabularyDirectory(m_tokenizerDirectory);
+}
+
+void TokenizerTest::testTiktokenMergesByRank()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("cl100k_base.tiktoken");
+    QVERIFY(writeFile(path, tiktokenContent()));
+
+    QString error;
+    const auto tokenizer = Context::BpeTokenizer::fromTiktokenFile(path, &error);
+    QVERIFY2(tokenizer, qPrintable(error));
+    QCOMPARE(tokenizer->name(), QString("cl100k_base"));
+    QCOMPARE(tokenizer->vocabularySize(), int(kRanks.size()));
+
+    QCOMPARE(tokenizer->countTokens(QString()), 0);
+    QCOMPARE(tokenizer->countTokens("abc"), 1);
+    QCOMPARE(tokenizer->countTokens("ab ab"), 2);
+    QCOMPARE(tokenizer->countTokens("abc abc"), 3);
+    // Bytes missing from the vocabulary count one token each.
+    QCOMPARE(tokenizer->countTokens("xyz"), 3);
+}
+
+void TokenizerTest::testHuggingFaceByteLevelVocabulary()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QVERIFY(dir.mkdir("qwen"));
+    const QString path = dir.filePath("qwen/tokenizer.json");
+    QVERIFY(writeFile(path, huggingFaceContent()));
+
+    QString error;
+    const auto tokenizer = Context::BpeTokenizer::fromHuggingFaceFile(path, &error);
+    QVERIFY2(tokenizer, qPrintable(error));
+    QCOMPARE(tokenizer->name(), QString("qwen"));
+    QCOMPARE(tokenizer->countTokens("ab ab"), 2);
+    QCOMPARE(tokenizer->countTokens("abc abc"), 3);
+}
+
+void TokenizerTest::testCachedCountMatchesFreshCount()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("default.tiktoken");
+    QVERIFY(writeFile(path, tiktokenContent()));
+
+    const auto tokenizer = Context::BpeTokenizer::fromTiktokenFile(path);
+    QVERIFY(tokenizer);
+
+    const QString longText = QString("abc ").repeated(200);
+    const int fresh = tokenizer->countTokens(longText);
+    QCOMPARE(fresh, 1 + 199 * 2 + 1);
+    QCOMPARE(tokenizer->countTokens(longText), fresh);
+    QCOMPARE(tokenizer->countTokens(longText + "c"), fresh + 1);
+}
+
+void TokenizerTest::testFamilyForModel_data()
+{
+    QTest::addColumn<QString>("model");
+    QTest::addColumn<QString>("family");
+
+    QTest::newRow("empty") << QString() << QString("default");
+    QTest::newRow("gpt-4o") << QString("gpt-4o-mini") << QString("o200k_base");
+    QTest::newRow("o3") << QString("o3-mini") << QString("o200k_base");
+    QTest::newRow("gpt-4") << QString("gpt-4-turbo") << QString("cl100k_base");
+    QTest::newRow("claude") << QString("claude-sonnet-4-5") << QString("claude");
+    QTest::newRow("codellama") << QString("codellama:7b-code") << QString("codellama");
+    QTest::newRow("llama3") << QString("llama3.1:8b") << QString("llama3");
+    QTest::newRow("qwen") << QString("Qwen2.5-Coder-7B") << QString("qwen");
+    QTest::newRow("codestral") << QString("codestral-latest") << QString("mistral");
+    QTest::newRow("unknown") << QString("my-finetune") << QString("default");
+}
+
+void TokenizerTest::testFamilyForModel()
+{
+    QFETCH(QString, model);
+    QFETCH(QString, family);
+
+    QCOMPARE(Context::TokenizerRegistry::familyForModel(model), family);
+}
+
+void TokenizerTest::testRegistryFallsBackToDefaultFamily()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QVERIFY(writeFile(dir.filePath("default.tiktoken"), tiktokenContent()));
+
+    auto &registry = Context::TokenizerRegistry::instance();
+    registry.setVocabularyDirectory(dir.path());
+    registry.preload({"gpt-4-turbo"});
+    registry.waitForLoads();
+
+    const auto tokenizer = registry.tokenizerForModel("gpt-4-turbo");
+    QVERIFY(tokenizer);
+    QCOMPARE(tokenizer->name(), QString("default"));
+    QCOMPARE(Context::TokenUtils::estimateTokens("abc abc", "gpt-4-turbo"), 3);
+    QCOMPARE(Context::TokenUtils::estimateTokens("abc abc"), 3);
+
+    registry.setVocabularyDirectory({});
+}
+
+void TokenizerTest::testVocabularyLoadsInTheBackground()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QVERIFY(writeFile(dir.filePath("qwen.tiktoken"), tiktokenContent()));
+
+    auto &registry = Context::TokenizerRegistry::instance();
+    registry.setVocabularyDirectory(dir.path());
+
+    // The first lookup only starts the load; counts use the heuristic until it is done.
+    QVERIFY(!registry.tokenizerForModel("qwen2.5-coder"));
+    registry.waitForLoads();
+
+    const auto tokenizer = registry.tokenizerForModel("qwen2.5-coder");
+    QVERIFY(tokenizer);
+    QCOMPARE(tokenizer->name(), QString("qwen"));
+    QCOMPARE(Context::TokenUtils::estimateTokens("abc abc", "qwen2.5-coder"), 3);
+
+    registry.setVocabularyDirectory({});
+}
+
+void TokenizerTest::testHeuristicWithoutVocabulary()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    auto &registry = Context::TokenizerRegistry::instance();
+    registry.setVocabularyDirectory(dir.path());
+    registry.preload({"gpt-4o"});
+    registry.waitForLoads();
+
+    QVERIFY(!registry.tokenizerForModel("gpt-4o"));
+    QCOMPARE(Context::TokenUtils::estimateTokens("abcdefgh", "gpt-4o"), 2);
+    QCOMPARE(Context::TokenUtils::heuristicTokens("abcdefgh"), 2);
+
+    registry.setVocabularyDirectory({});
+}
+
+} // namespace QodeAssist
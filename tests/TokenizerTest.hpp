@@ -0,0 +1,32 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+
+namespace QodeAssist {
+
+class TokenizerTest final : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void testTiktokenMergesByRank();
+    void testHuggingFaceByteLevelVocabulary();
+    void testCachedCountMatchesFreshCount();
+    void testFamilyForModel_data();
+    void testFamilyForModel();
+    void testRegistryFallsBackToDefaultFamily();
+    void testVocabularyLoadsInTheBackground();
+    void testHeuristicWithoutVocabulary();
+
+private:
+    QString m_tokenizerDirectory;
+};
+
+} // namespace QodeAssist
@@ -0,0 +1,150 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#include "TrigramIndexTest.hpp"
+
+#include <QRegularExpression>
+#include <QTest>
+
+#include <algorithm>
+
+#include "tools/TrigramIndex.hpp"
+
+namespace QodeAssist {
+
+namespace {
+
+using Tools::TrigramIndex;
+using Tools::TrigramQuery;
+
+TrigramIndex makeIndex()
+{
+    TrigramIndex index;
+    index.setFile("/p/widget.cpp", TrigramIndex::trigramsOf("class Widget {\n  void paint();\n};"));
+    index.setFile("/p/model.cpp", TrigramIndex::trigramsOf("struct Model {\n  int rowCount;\n};"));
+    index.setFile("/p/notes.txt", TrigramIndex::trigramsOf("paint the\nwall"));
+    return index;
+}
+
+} // namespace
+
+void TrigramIndexTest::testLiteralQueryNarrowsCandidates()
+{
+    const TrigramIndex index = makeIndex();
+
+    QCOMPARE(
+        index.candidates(TrigramQuery::forLiteral("paint", true)),
+        QSet<QString>({"/p/widget.cpp", "/p/notes.txt"}));
+    QCOMPARE(
+        index.candidates(TrigramQuery::forLiteral("rowCount", true)),
+        QSet<QString>({"/p/model.cpp"}));
+    QVERIFY(index.candidates(TrigramQuery::forLiteral("missing", true)).isEmpty());
+
+    // Trigrams never span lines, and text search matches within a line.
+    QVERIFY(index.candidates(TrigramQuery::forLiteral("the wall", true)).isEmpty());
+
+    QVERIFY(TrigramQuery::forLiteral("ab", true).matchesAll());
+}
+
+void TrigramIndexTest::testCaseInsensitiveMatching()
+{
+    const TrigramIndex index = makeIndex();
+
+    QCOMPARE(
+        index.candidates(TrigramQuery::forLiteral("WIDGET", false)),
+        QSet<QString>({"/p/widget.cpp"}));
+    QVERIFY(TrigramQuery::forLiteral("Äöü", false).matchesAll());
+    QVERIFY(!TrigramQuery::forLiteral("Äöü", true).matchesAll());
+}
+
+void TrigramIndexTest::testRegexDecomposition_data()
+{
+    QTest::addColumn<QString>("pattern");
+    QTest::addColumn<bool>("matchesAll");
+    QTest::addColumn<QString>("requiredLiteral");
+
+    QTest::newRow("literal") << QString("rowCount") << false << QString("rowCount");
+    QTest::newRow("escaped dot") << QString("Model\\.h") << false << QString("Model.h");
+    QTest::newRow("wildcards between literals")
+        << QString("class\\s+Widget") << false << QString("Widget");
+    QTest::newRow("optional tail dropped") << QString("paint(er)?") << false << QString("paint");
+    QTest::newRow("plus keeps one") << QString("Mod+el") << false << QString("Mod");
+    QTest::newRow("group literal") << QString("(?:void) paint") << false << QString("void");
+    QTest::newRow("only classes") << QString("[a-z]+\\d*") << true << QString();
+    QTest::newRow("back reference") << QString("(ab)\\1cde") << true << QString();
+    QTest::newRow("optional everything") << QString("(paint)*") << true << QString();
+}
+
+void TrigramIndexTest::testRegexDecomposition()
+{
+    QFETCH(QString, pattern);
+    QFETCH(bool, matchesAll);
+    QFETCH(QString, requiredLiteral);
+
+    QVERIFY(QRegularExpression(pattern).isValid());
+
+    const TrigramQuery query = TrigramQuery::forRegex(pattern, true);
+    QCOMPARE(query.matchesAll(), matchesAll);
+    if (matchesAll)
+        return;
+
+    QCOMPARE(query.alternatives().size(), 1);
+    const std::vector<quint32> &required = query.alternatives().first();
+    const TrigramQuery literal = TrigramQuery::forLiteral(requiredLiteral, true);
+    for (const quint32 trigram : literal.alternatives().first())
+        QVERIFY(std::binary_search(required.begin(), required.end(), trigram));
+}
+
+void TrigramIndexTest::testRegexAlternationUnionsBranches()
+{
+    const TrigramIndex index = makeIndex();
+
+    const TrigramQuery query = TrigramQuery::forRegex("struct Mo|class Wi", true);
+    QCOMPARE(query.alternatives().size(), 2);
+    QCOMPARE(index.candidates(query), QSet<QString>({"/p/widget.cpp", "/p/model.cpp"}));
+
+    QVERIFY(TrigramQuery::forRegex("struct|a", true).matchesAll());
+}
+
+void TrigramIndexTest::testReplaceAndRemoveFiles()
+{
+    TrigramIndex index = makeIndex();
+
+    index.setFile("/p/widget.cpp", TrigramIndex::trigramsOf("class Button {};"), 42);
+    QCOMPARE(index.fileCount(), 3);
+    QCOMPARE(index.stamp("/p/widget.cpp"), qint64(42));
+    QCOMPARE(
+        index.candidates(TrigramQuery::forLiteral("paint", true)),
+        QSet<QString>({"/p/notes.txt"}));
+    QCOMPARE(
+        index.candidates(TrigramQuery::forLiteral("Button", true)),
+        QSet<QString>({"/p/widget.cpp"}));
+
+    index.removeFile("/p/notes.txt");
+    QVERIFY(!index.contains("/p/notes.txt"));
+    QVERIFY(index.candidates(TrigramQuery::forLiteral("paint", true)).isEmpty());
+}
+
+void TrigramIndexTest::testCompactKeepsResults()
+{
+    TrigramIndex index = makeIndex();
+    for (int i = 0; i < 10; ++i) {
+        const QByteArray content = QByteArray("rowCount ") + char('a' + i);
+        index.setFile("/p/model.cpp", TrigramIndex::trigramsOf(content));
+    }
+    index.removeFile("/p/notes.txt");
+
+    index.compact();
+
+    QCOMPARE(index.fileCount(), 2);
+    QCOMPARE(
+        index.candidates(TrigramQuery::forLiteral("rowCount j", true)),
+        QSet<QString>({"/p/model.cpp"}));
+    QVERIFY(index.candidates(TrigramQuery::forLiteral("rowCount a", true)).isEmpty());
+    QCOMPARE(
+        index.candidates(TrigramQuery::forLiteral("paint", true)),
+        QSet<QString>({"/p/widget.cpp"}));
+}
+
+} // namespace QodeAssist
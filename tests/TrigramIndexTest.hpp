@@ -0,0 +1,25 @@
+// Copyright (C) 2026 Petr Mironychev
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Additional attribution terms under GPLv3 §7(b) apply — see LICENSE
+
+#pragma once
+
+#include <QObject>
+
+namespace QodeAssist {
+
+class TrigramIndexTest final : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testLiteralQueryNarrowsCandidates();
+    void testCaseInsensitiveMatching();
+    void testRegexDecomposition_data();
+    void testRegexDecomposition();
+    void testRegexAlternationUnionsBranches();
+    void testReplaceAndRemoveFiles();
+    void testCompactKeepsResults();
+};
+
+} // namespace QodeAssist